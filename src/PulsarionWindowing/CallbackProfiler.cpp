@@ -0,0 +1,39 @@
+#include "CallbackProfiler.hpp"
+
+#include "PulsarionCore/Log.hpp"
+
+namespace Pulsarion::Windowing
+{
+    template<Clock ClockType>
+    void BasicCallbackProfiler<ClockType>::ReportSlow(const SlowCallback& call)
+    {
+        m_SlowCalls++;
+        if (m_OnSlowCallback)
+        {
+            m_OnSlowCallback(m_UserData, call);
+            return;
+        }
+        PULSARION_LOG_WARN("[CallbackProfiler] {0} callback took {1}us at {2}ns, the threshold is {3}us", EventTypeToString(call.Type),
+            std::chrono::duration_cast<std::chrono::microseconds>(call.Duration).count(), call.Timestamp.time_since_epoch().count(),
+            std::chrono::duration_cast<std::chrono::microseconds>(m_Threshold).count());
+    }
+
+    template<Clock ClockType>
+    void BasicCallbackProfiler<ClockType>::LogStats() const
+    {
+        PULSARION_LOG_TRACE("[CallbackProfiler] Callback timing ({0} slow calls):", m_SlowCalls);
+        for (std::size_t i = 0; i < EventTypeCount; i++)
+        {
+            const CallbackStats& stats = m_Stats[i];
+            if (stats.Calls == 0)
+                continue;
+            PULSARION_LOG_TRACE("  {0}: {1} calls, {2}us total, {3}us average, {4}us max", EventTypeToString(static_cast<EventType>(i)), stats.Calls,
+                std::chrono::duration_cast<std::chrono::microseconds>(stats.Total).count(),
+                std::chrono::duration_cast<std::chrono::microseconds>(stats.Total).count() / static_cast<std::int64_t>(stats.Calls),
+                std::chrono::duration_cast<std::chrono::microseconds>(stats.Max).count());
+        }
+    }
+
+    template class BasicCallbackProfiler<SteadyClock>;
+    template class BasicCallbackProfiler<ManualClock>;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Clock.hpp"
+#include "EventType.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace Pulsarion::Windowing
+{
+    struct CallbackStats
+    {
+        std::uint64_t Calls = 0;
+        std::chrono::nanoseconds Total = {};
+        std::chrono::nanoseconds Max = {};
+    };
+
+    // A single callback call that took longer than the threshold
+    struct SlowCallback
+    {
+        EventType Type;
+        std::chrono::steady_clock::time_point Timestamp; // When the call started
+        std::chrono::nanoseconds Duration;
+    };
+
+    /*!
+     * @brief Counts and times the calls into the user's callbacks, per event type, and reports every single call slower than a threshold.
+     * Each call costs two clock reads and a few adds. Slow calls are logged as a warning unless an OnSlowCallback handler is set.
+     * DebugWindow drives it with DebugOptions::ProfileCallbacks, without that option there is no profiler and no cost at all.
+     */
+    template<Clock ClockType>
+    class BasicCallbackProfiler
+    {
+    public:
+        using SlowCallbackHandler = std::function<void(void*, const SlowCallback&)>;
+
+        // Times one call, from construction to destruction
+        class Scope
+        {
+        public:
+            Scope(BasicCallbackProfiler& profiler, EventType type) : m_Profiler(profiler), m_Type(type), m_Start(profiler.m_Clock.Now()) { }
+            ~Scope() { m_Profiler.Record(m_Type, m_Start, m_Profiler.m_Clock.Now()); }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            BasicCallbackProfiler& m_Profiler;
+            EventType m_Type;
+            std::chrono::steady_clock::time_point m_Start;
+        };
+
+        explicit BasicCallbackProfiler(ClockType clock = ClockType(), std::chrono::nanoseconds threshold = std::chrono::milliseconds(2))
+            : m_Clock(std::move(clock)), m_Threshold(threshold) { }
+
+        [[nodiscard]] Scope Measure(EventType type) { return Scope(*this, type); }
+
+        void Record(EventType type, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+        {
+            const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            CallbackStats& stats = m_Stats[static_cast<std::size_t>(type)];
+            stats.Calls++;
+            stats.Total += duration;
+            if (duration > stats.Max)
+                stats.Max = duration;
+            if (duration > m_Threshold)
+                ReportSlow({ type, start, duration });
+        }
+
+        [[nodiscard]] const CallbackStats& GetStats(EventType type) const { return m_Stats[static_cast<std::size_t>(type)]; }
+        [[nodiscard]] const std::array<CallbackStats, EventTypeCount>& GetAllStats() const { return m_Stats; }
+        [[nodiscard]] std::uint64_t GetSlowCalls() const { return m_SlowCalls; }
+        void Reset() { m_Stats = {}; m_SlowCalls = 0; }
+
+        // Calls above this are reported, a zero threshold reports every call
+        void SetThreshold(std::chrono::nanoseconds threshold) { m_Threshold = threshold; }
+        [[nodiscard]] std::chrono::nanoseconds GetThreshold() const { return m_Threshold; }
+        void SetOnSlowCallback(SlowCallbackHandler&& onSlowCallback, void* userData = nullptr)
+        {
+            m_OnSlowCallback = std::move(onSlowCallback);
+            m_UserData = userData;
+        }
+
+        // Logs calls, total and max time of every event type that was called at least once
+        void LogStats() const;
+
+    private:
+        void ReportSlow(const SlowCallback& call);
+
+        [[no_unique_address]] ClockType m_Clock;
+        std::chrono::nanoseconds m_Threshold;
+        std::array<CallbackStats, EventTypeCount> m_Stats = {};
+        std::uint64_t m_SlowCalls = 0;
+        SlowCallbackHandler m_OnSlowCallback;
+        void* m_UserData = nullptr;
+    };
+
+    extern template class PULSARION_WINDOWING_API BasicCallbackProfiler<SteadyClock>;
+    extern template class PULSARION_WINDOWING_API BasicCallbackProfiler<ManualClock>;
+
+    using CallbackProfiler = BasicCallbackProfiler<SteadyClock>;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Core.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+
+namespace Pulsarion::Windowing
+{
+    // Clipboard formats are MIME types. The backends map the ones they know to native formats and register every other one by name,
+    // so two of our applications can exchange any format. Text is always UTF-8 on our side.
+    constexpr std::string_view ClipboardTextFormat = "text/plain;charset=utf-8";
+    constexpr std::string_view ClipboardPngFormat = "image/png";
+
+    // The largest chunk a ClipboardReceiver is called with
+    constexpr std::size_t ClipboardChunkSize = 256 * 1024;
+
+    // Where a ClipboardProvider writes its data. The backends write straight into the native clipboard storage, so the data is never held twice.
+    class ClipboardWriter
+    {
+    public:
+        virtual ~ClipboardWriter() = default;
+
+        // Optional, saves growing the storage when the size is known up front
+        virtual void Reserve(std::size_t size) = 0;
+        virtual void Write(std::span<const std::byte> data) = 0;
+        void Write(std::string_view text) { Write(std::as_bytes(std::span(text.data(), text.size()))); }
+    };
+
+    // Called on the window's thread when another application (or this one) pastes one of the offered formats, never before that
+    using ClipboardProvider = std::function<void(void* userData, std::string_view format, ClipboardWriter& writer)>;
+
+    enum class ClipboardStatus : std::uint8_t
+    {
+        More = 0, // Another chunk follows
+        Done, // This is the last chunk, it can be empty
+        Unavailable // The clipboard doesn't hold the format, the chunk is empty
+    };
+
+    // Called from PollEvents with the data in chunks of at most ClipboardChunkSize bytes, a chunk is only valid during the call
+    using ClipboardReceiver = std::function<void(void* userData, std::span<const std::byte> chunk, ClipboardStatus status)>;
+}
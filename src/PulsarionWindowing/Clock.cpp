@@ -0,0 +1,64 @@
+#include "Clock.hpp"
+
+#include <thread>
+
+#ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
+#include <Windows.h>
+#endif
+
+namespace Pulsarion::Windowing
+{
+    #ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    std::uint32_t SteadyClock::s_HighResolutionCount = 0;
+
+    void SteadyClock::AcquireHighResolution()
+    {
+        if (s_HighResolutionCount++ == 0)
+            timeBeginPeriod(1);
+    }
+
+    void SteadyClock::ReleaseHighResolution()
+    {
+        if (--s_HighResolutionCount == 0)
+            timeEndPeriod(1);
+    }
+    #endif
+
+    void SteadyClock::SleepUntil(TimePoint wakeTime)
+    {
+        const auto currentTime = Now();
+        if (currentTime >= wakeTime)
+            return;
+        [[maybe_unused]] const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(wakeTime - currentTime);
+
+        #ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
+        #ifdef PULSARION_WINDOWING_USE_BUSY_WAIT
+        const auto sleepTime = remaining - std::chrono::milliseconds(1);
+        #else
+        const auto sleepTime = remaining;
+        #endif
+        if (sleepTime > std::chrono::milliseconds(1))
+            Sleep(static_cast<DWORD>(sleepTime.count()));
+
+        #ifdef PULSARION_WINDOWING_USE_BUSY_WAIT
+        while (Now() < wakeTime)
+        {
+            // Busy wait
+        }
+        #endif
+        #elif defined(PULSARION_WINDOWING_USE_BUSY_WAIT)
+        if (remaining > std::chrono::milliseconds(16)) // Windows has a limit of 15ms for sleep time
+            std::this_thread::sleep_until(wakeTime);
+        else
+        {
+            while (Now() < wakeTime)
+            {
+                // Busy wait
+            }
+        }
+        #else
+        std::this_thread::sleep_until(wakeTime);
+        #endif
+    }
+}
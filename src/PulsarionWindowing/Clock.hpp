@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Core.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+
+namespace Pulsarion::Windowing
+{
+    // What FrameLimiter and DebugWindow need from a clock. Every clock hands out steady_clock time points,
+    // so they can be mixed with the ones from DisplayTiming and passed to TimerQueue.
+    template<typename T>
+    concept Clock = std::copy_constructible<T> && requires(T& clock, std::chrono::steady_clock::time_point wakeTime)
+    {
+        { clock.Now() } -> std::same_as<std::chrono::steady_clock::time_point>;
+        clock.SleepUntil(wakeTime);
+    };
+
+    // The real clock. It is empty, so holding one costs nothing.
+    class PULSARION_WINDOWING_API SteadyClock
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        [[nodiscard]] static TimePoint Now() { return std::chrono::steady_clock::now(); }
+        // Sleeps the way PULSARION_WINDOWING_USE_HIGH_RES_SLEEP and PULSARION_WINDOWING_USE_BUSY_WAIT select
+        static void SleepUntil(TimePoint wakeTime);
+
+        #ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
+        // Keeps the system timer at 1ms while at least one user needs it
+        static void AcquireHighResolution();
+        static void ReleaseHighResolution();
+
+    private:
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+        static std::uint32_t s_HighResolutionCount;
+        #endif
+    };
+
+    /*!
+     * @brief A clock that only moves when told to, so pacing, statistics and timers can be tested exactly and simulations run at full speed.
+     * Sleeping jumps straight to the wake time. Copies share the same time, so a copy handed to a FrameLimiter follows the original.
+     */
+    class PULSARION_WINDOWING_API ManualClock
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        explicit ManualClock(TimePoint start = TimePoint()) : m_Now(std::make_shared<TimePoint>(start)) { }
+
+        [[nodiscard]] TimePoint Now() const { return *m_Now; }
+        void SleepUntil(TimePoint wakeTime) const
+        {
+            if (wakeTime > *m_Now)
+                *m_Now = wakeTime;
+        }
+
+        void Advance(std::chrono::nanoseconds duration) const { *m_Now += std::chrono::duration_cast<TimePoint::duration>(duration); }
+        void Set(TimePoint now) const { *m_Now = now; }
+
+    private:
+        std::shared_ptr<TimePoint> m_Now;
+    };
+
+    static_assert(Clock<SteadyClock> && Clock<ManualClock>);
+}
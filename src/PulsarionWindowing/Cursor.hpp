@@ -1,6 +1,10 @@
 #pragma once
 // Everything about cursors, such as changing cursor image, hiding cursor, etc.
 
+#include "Core.hpp"
+
+#include <cstdint>
+
 namespace Pulsarion::Windowing
 {
 
@@ -8,6 +12,25 @@ namespace Pulsarion::Windowing
     {
         Normal,
         Hidden,
-        Captured,
+        Captured, // Hidden and locked to the window, relative motion is reported through OnRawMouseMove
+    };
+
+    // The system's own cursors, a platform without one of them shows the closest it has
+    enum class CursorShape : std::uint8_t
+    {
+        Arrow = 0,
+        IBeam,
+        Crosshair,
+        Hand,
+        ResizeHorizontal,
+        ResizeVertical,
+        ResizeDiagonalDown, // Top left to bottom right
+        ResizeDiagonalUp, // Bottom left to top right
+        ResizeAll,
+        NotAllowed,
+        Wait,
+        Count
     };
+
+    constexpr std::size_t CursorShapeCount = static_cast<std::size_t>(CursorShape::Count);
 }
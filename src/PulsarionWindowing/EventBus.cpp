@@ -0,0 +1,107 @@
+#include "EventBus.hpp"
+#include "Watchdog.hpp"
+
+namespace Pulsarion::Windowing
+{
+    void Subscription::Reset()
+    {
+        if (m_Bus == nullptr)
+            return;
+        m_Bus->Unsubscribe(m_Type, m_Id);
+        m_Bus = nullptr;
+    }
+
+    EventBus::~EventBus()
+    {
+        Detach();
+    }
+
+    void EventBus::Attach(Window& window)
+    {
+        Detach();
+        m_Window = &window;
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>)
+        {
+            ((GetListeners<static_cast<EventType>(Indices)>(m_Listeners).empty() ? void() : Install<static_cast<EventType>(Indices)>()), ...);
+        }(std::make_index_sequence<EventTypeCount>());
+    }
+
+    void EventBus::Detach()
+    {
+        if (m_Window == nullptr)
+            return;
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>)
+        {
+            ((m_Installed & (1u << Indices) ? SetWindowCallback<static_cast<EventType>(Indices)>(*m_Window, nullptr) : void()), ...);
+        }(std::make_index_sequence<EventTypeCount>());
+        m_Installed = 0;
+        m_Window = nullptr;
+    }
+
+    void EventBus::Unsubscribe(EventType type, ListenerId id)
+    {
+        if (id == 0)
+            return;
+
+        Visit(type, [&]<EventType Type>()
+        {
+            auto& listeners = GetListeners<Type>(m_Listeners);
+            const auto it = std::find_if(listeners.begin(), listeners.end(), [id](const auto& entry) { return entry.Id == id; });
+            if (it != listeners.end())
+            {
+                if (m_DispatchDepth > 0)
+                {
+                    // The listener might be the one running, so only mark it and erase it once the dispatch is over
+                    it->Id = 0;
+                    m_HasDeferred = true;
+                }
+                else
+                {
+                    listeners.erase(it);
+                }
+                return;
+            }
+
+            auto& deferred = GetListeners<Type>(m_Deferred);
+            std::erase_if(deferred, [id](const auto& entry) { return entry.Id == id; });
+        });
+    }
+
+    std::size_t EventBus::GetListenerCount(EventType type) const
+    {
+        std::size_t count = 0;
+        Visit(type, [&]<EventType Type>()
+        {
+            const auto& listeners = GetListeners<Type>(m_Listeners);
+            count = static_cast<std::size_t>(std::count_if(listeners.begin(), listeners.end(), [](const auto& entry) { return entry.Id != 0; }));
+            count += GetListeners<Type>(m_Deferred).size();
+        });
+        return count;
+    }
+
+    void EventBus::ApplyDeferred()
+    {
+        m_HasDeferred = false;
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>)
+        {
+            ([&]
+            {
+                constexpr auto type = static_cast<EventType>(Indices);
+                std::erase_if(GetListeners<type>(m_Listeners), [](const auto& entry) { return entry.Id == 0; });
+                for (auto& entry : GetListeners<type>(m_Deferred))
+                    Insert<type>(std::move(entry));
+                GetListeners<type>(m_Deferred).clear();
+            }(), ...);
+        }(std::make_index_sequence<EventTypeCount>());
+    }
+
+    void EventBus::BeginWatch(EventType type)
+    {
+        m_Watchdog->BeginDispatch(type);
+    }
+
+    void EventBus::EndWatch()
+    {
+        m_Watchdog->EndDispatch();
+    }
+}
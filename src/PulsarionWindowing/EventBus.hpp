@@ -0,0 +1,326 @@
+#pragma once
+
+#include "Core.hpp"
+#include "EventType.hpp"
+#include "Window.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    // The window callback types, in EventType order
+    using EventCallbacks = std::tuple<
+        Window::CloseCallback, Window::VisibilityCallback, Window::FocusCallback, Window::ResizeCallback, Window::MoveCallback,
+        Window::BeforeResizeCallback, Window::AfterResizeCallback, Window::MinimizeCallback, Window::MaximizeCallback, Window::FullscreenCallback,
+        Window::RestoreCallback, Window::OcclusionCallback,
+        Window::MouseEnterCallback, Window::MouseLeaveCallback, Window::MouseDownCallback, Window::MouseUpCallback, Window::MouseMoveCallback,
+        Window::MouseWheelCallback, Window::RawMouseMoveCallback, Window::TouchCallback, Window::KeyDownCallback, Window::KeyUpCallback, Window::KeyTypedCallback,
+        Window::TextInputCallback>;
+    static_assert(std::tuple_size_v<EventCallbacks> == EventTypeCount, "Every event type needs its callback type");
+
+    template<EventType Type>
+    using EventCallback = std::tuple_element_t<static_cast<std::size_t>(Type), EventCallbacks>;
+
+    template<typename Callback>
+    struct EventListenerTraits;
+
+    template<typename Return, typename... Args>
+    struct EventListenerTraits<std::function<Return(void*, Args...)>>
+    {
+        using Listener = std::function<bool(void*, Args...)>; // Returns true to consume the event, later listeners don't see it
+        using WindowReturn = Return;
+    };
+
+    template<EventType Type>
+    using EventListener = typename EventListenerTraits<EventCallback<Type>>::Listener;
+
+    // Calls the Window setter or getter of the callback for an event type
+    template<EventType Type>
+    void SetWindowCallback(Window& window, EventCallback<Type>&& callback)
+    {
+        if constexpr (Type == EventType::Close)
+            window.SetOnClose(std::move(callback));
+        else if constexpr (Type == EventType::WindowVisibility)
+            window.SetOnWindowVisibility(std::move(callback));
+        else if constexpr (Type == EventType::Focus)
+            window.SetOnFocus(std::move(callback));
+        else if constexpr (Type == EventType::Resize)
+            window.SetOnResize(std::move(callback));
+        else if constexpr (Type == EventType::Move)
+            window.SetOnMove(std::move(callback));
+        else if constexpr (Type == EventType::BeforeResize)
+            window.SetBeforeResize(std::move(callback));
+        else if constexpr (Type == EventType::AfterResize)
+            window.SetAfterResize(std::move(callback));
+        else if constexpr (Type == EventType::Minimize)
+            window.SetOnMinimize(std::move(callback));
+        else if constexpr (Type == EventType::Maximize)
+            window.SetOnMaximize(std::move(callback));
+        else if constexpr (Type == EventType::Fullscreen)
+            window.SetOnFullscreen(std::move(callback));
+        else if constexpr (Type == EventType::Restore)
+            window.SetOnRestore(std::move(callback));
+        else if constexpr (Type == EventType::Occlusion)
+            window.SetOnOcclusion(std::move(callback));
+        else if constexpr (Type == EventType::MouseEnter)
+            window.SetOnMouseEnter(std::move(callback));
+        else if constexpr (Type == EventType::MouseLeave)
+            window.SetOnMouseLeave(std::move(callback));
+        else if constexpr (Type == EventType::MouseDown)
+            window.SetOnMouseDown(std::move(callback));
+        else if constexpr (Type == EventType::MouseUp)
+            window.SetOnMouseUp(std::move(callback));
+        else if constexpr (Type == EventType::MouseMove)
+            window.SetOnMouseMove(std::move(callback));
+        else if constexpr (Type == EventType::MouseWheel)
+            window.SetOnMouseWheel(std::move(callback));
+        else if constexpr (Type == EventType::RawMouseMove)
+            window.SetOnRawMouseMove(std::move(callback));
+        else if constexpr (Type == EventType::Touch)
+            window.SetOnTouch(std::move(callback));
+        else if constexpr (Type == EventType::KeyDown)
+            window.SetOnKeyDown(std::move(callback));
+        else if constexpr (Type == EventType::KeyUp)
+            window.SetOnKeyUp(std::move(callback));
+        else if constexpr (Type == EventType::KeyTyped)
+            window.SetOnKeyTyped(std::move(callback));
+        else if constexpr (Type == EventType::TextInput)
+            window.SetOnTextInput(std::move(callback));
+    }
+
+    template<EventType Type>
+    [[nodiscard]] const EventCallback<Type>& GetWindowCallback(const Window& window)
+    {
+        if constexpr (Type == EventType::Close)
+            return window.GetOnClose();
+        else if constexpr (Type == EventType::WindowVisibility)
+            return window.GetOnWindowVisibility();
+        else if constexpr (Type == EventType::Focus)
+            return window.GetOnFocus();
+        else if constexpr (Type == EventType::Resize)
+            return window.GetOnResize();
+        else if constexpr (Type == EventType::Move)
+            return window.GetOnMove();
+        else if constexpr (Type == EventType::BeforeResize)
+            return window.GetBeforeResize();
+        else if constexpr (Type == EventType::AfterResize)
+            return window.GetAfterResize();
+        else if constexpr (Type == EventType::Minimize)
+            return window.GetOnMinimize();
+        else if constexpr (Type == EventType::Maximize)
+            return window.GetOnMaximize();
+        else if constexpr (Type == EventType::Fullscreen)
+            return window.GetOnFullscreen();
+        else if constexpr (Type == EventType::Restore)
+            return window.GetOnRestore();
+        else if constexpr (Type == EventType::Occlusion)
+            return window.GetOnOcclusion();
+        else if constexpr (Type == EventType::MouseEnter)
+            return window.GetOnMouseEnter();
+        else if constexpr (Type == EventType::MouseLeave)
+            return window.GetOnMouseLeave();
+        else if constexpr (Type == EventType::MouseDown)
+            return window.GetOnMouseDown();
+        else if constexpr (Type == EventType::MouseUp)
+            return window.GetOnMouseUp();
+        else if constexpr (Type == EventType::MouseMove)
+            return window.GetOnMouseMove();
+        else if constexpr (Type == EventType::MouseWheel)
+            return window.GetOnMouseWheel();
+        else if constexpr (Type == EventType::RawMouseMove)
+            return window.GetOnRawMouseMove();
+        else if constexpr (Type == EventType::Touch)
+            return window.GetOnTouch();
+        else if constexpr (Type == EventType::KeyDown)
+            return window.GetOnKeyDown();
+        else if constexpr (Type == EventType::KeyUp)
+            return window.GetOnKeyUp();
+        else if constexpr (Type == EventType::KeyTyped)
+            return window.GetOnKeyTyped();
+        else
+            return window.GetOnTextInput();
+    }
+
+    using ListenerId = std::uint32_t;
+
+    class EventBus;
+
+    // Unsubscribes when destroyed, must not outlive the bus it came from
+    class PULSARION_WINDOWING_API Subscription
+    {
+    public:
+        Subscription() = default;
+        Subscription(EventBus* bus, EventType type, ListenerId id) : m_Bus(bus), m_Type(type), m_Id(id) { }
+        ~Subscription() { Reset(); }
+
+        Subscription(const Subscription&) = delete;
+        Subscription& operator=(const Subscription&) = delete;
+        Subscription(Subscription&& other) noexcept : m_Bus(std::exchange(other.m_Bus, nullptr)), m_Type(other.m_Type), m_Id(other.m_Id) { }
+        Subscription& operator=(Subscription&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                m_Bus = std::exchange(other.m_Bus, nullptr);
+                m_Type = other.m_Type;
+                m_Id = other.m_Id;
+            }
+            return *this;
+        }
+
+        void Reset();
+        // Keeps the listener subscribed for as long as the bus lives
+        ListenerId Release() { m_Bus = nullptr; return m_Id; }
+
+        [[nodiscard]] bool IsActive() const { return m_Bus != nullptr; }
+        [[nodiscard]] EventType GetType() const { return m_Type; }
+        [[nodiscard]] ListenerId GetId() const { return m_Id; }
+
+    private:
+        EventBus* m_Bus = nullptr;
+        EventType m_Type = EventType::Count;
+        ListenerId m_Id = 0;
+    };
+
+    /*!
+     * @brief Lets any number of listeners observe a window's events, instead of the single callback slot Window has per event.
+     * Listeners are kept in one contiguous vector per event type, sorted by priority (highest first, ties in subscription order),
+     * so dispatch is a linear scan without allocations. Subscribing or unsubscribing while an event is being dispatched is
+     * deferred until the outermost dispatch returns.
+     * A consumed Close event cancels the close.
+     */
+    class PULSARION_WINDOWING_API EventBus
+    {
+    public:
+        EventBus() = default;
+        ~EventBus();
+
+        EventBus(const EventBus&) = delete;
+        EventBus& operator=(const EventBus&) = delete;
+
+        // Routes the window's callbacks through the bus, replacing the ones it had. Only events with listeners get a callback.
+        void Attach(Window& window);
+        void Detach();
+        [[nodiscard]] Window* GetWindow() const { return m_Window; }
+
+        // Set by Watchdog::Watch, marks every dispatch from before the first listener to after the last one returned
+        void SetWatchdog(Watchdog* watchdog) { m_Watchdog = watchdog; }
+
+        template<EventType Type>
+        [[nodiscard]] Subscription Subscribe(EventListener<Type>&& listener, std::int32_t priority = 0)
+        {
+            const ListenerId id = m_NextId++;
+            Entry<Type> entry { id, priority, std::move(listener) };
+            if (m_DispatchDepth > 0)
+            {
+                GetListeners<Type>(m_Deferred).push_back(std::move(entry));
+                m_HasDeferred = true;
+            }
+            else
+            {
+                Insert<Type>(std::move(entry));
+            }
+            Install<Type>();
+            return { this, Type, id };
+        }
+
+        void Unsubscribe(EventType type, ListenerId id);
+
+        // Calls the listeners in priority order until one consumes the event. Also usable to inject synthetic events.
+        template<EventType Type, typename... Args>
+        bool Dispatch(void* userData, Args&&... args)
+        {
+            auto& listeners = GetListeners<Type>(m_Listeners);
+            bool consumed = false;
+            m_DispatchDepth++;
+            if (m_Watchdog != nullptr)
+                BeginWatch(Type);
+            // Indexed since the vector can't change while we dispatch, and listeners with Id 0 were unsubscribed during a dispatch
+            for (std::size_t i = 0; i < listeners.size() && !consumed; i++)
+            {
+                if (listeners[i].Id != 0)
+                    consumed = listeners[i].Listener(userData, args...);
+            }
+            if (m_Watchdog != nullptr)
+                EndWatch();
+            if (--m_DispatchDepth == 0 && m_HasDeferred)
+                ApplyDeferred();
+            return consumed;
+        }
+
+        [[nodiscard]] std::size_t GetListenerCount(EventType type) const;
+
+    private:
+        template<EventType Type>
+        struct Entry
+        {
+            ListenerId Id;
+            std::int32_t Priority;
+            EventListener<Type> Listener;
+        };
+
+        template<std::size_t... Indices>
+        static auto MakeStorage(std::index_sequence<Indices...>) -> std::tuple<std::vector<Entry<static_cast<EventType>(Indices)>>...>;
+        using Storage = decltype(MakeStorage(std::make_index_sequence<EventTypeCount>()));
+
+        template<EventType Type>
+        static auto& GetListeners(Storage& storage) { return std::get<static_cast<std::size_t>(Type)>(storage); }
+        template<EventType Type>
+        static const auto& GetListeners(const Storage& storage) { return std::get<static_cast<std::size_t>(Type)>(storage); }
+
+        // Calls function.template operator()<Type>() for the runtime type
+        template<typename Function>
+        static void Visit(EventType type, Function&& function)
+        {
+            [&]<std::size_t... Indices>(std::index_sequence<Indices...>)
+            {
+                ((static_cast<std::size_t>(type) == Indices ? function.template operator()<static_cast<EventType>(Indices)>() : void()), ...);
+            }(std::make_index_sequence<EventTypeCount>());
+        }
+
+        template<EventType Type>
+        void Insert(Entry<Type>&& entry)
+        {
+            auto& listeners = GetListeners<Type>(m_Listeners);
+            const auto position = std::upper_bound(listeners.begin(), listeners.end(), entry.Priority, [](std::int32_t priority, const Entry<Type>& other) { return priority > other.Priority; });
+            listeners.insert(position, std::move(entry));
+        }
+
+        template<EventType Type>
+        void Install()
+        {
+            constexpr std::uint32_t bit = 1u << static_cast<std::uint32_t>(Type);
+            if (m_Window == nullptr || (m_Installed & bit) != 0)
+                return;
+            m_Installed |= bit;
+
+            using Return = typename EventListenerTraits<EventCallback<Type>>::WindowReturn;
+            SetWindowCallback<Type>(*m_Window, [this](void* userData, auto... args) -> Return
+            {
+                const bool consumed = Dispatch<Type>(userData, args...);
+                if constexpr (std::is_same_v<Return, bool>)
+                    return !consumed;
+            });
+        }
+
+        void ApplyDeferred();
+        // Out of line so the bus doesn't need the watchdog's definition
+        void BeginWatch(EventType type);
+        void EndWatch();
+
+        Storage m_Listeners;
+        Storage m_Deferred; // Subscribed during a dispatch, inserted once it finishes
+        Window* m_Window = nullptr;
+        Watchdog* m_Watchdog = nullptr;
+        std::uint32_t m_Installed = 0; // One bit per EventType that has a forwarding callback on the window
+        std::uint32_t m_DispatchDepth = 0;
+        bool m_HasDeferred = false;
+        ListenerId m_NextId = 1;
+    };
+}
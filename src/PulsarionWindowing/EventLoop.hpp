@@ -0,0 +1,105 @@
+#pragma once
+// Single threaded loop that waits on window events, user file descriptors and cross thread wakeups with one epoll_wait. Linux only.
+
+#include "Core.hpp"
+#include "TimerQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+struct epoll_event;
+
+namespace Pulsarion::Windowing
+{
+    class Window;
+
+    enum class IoEvents : std::uint32_t
+    {
+        None = 0,
+        Readable = 1 << 0,
+        Writable = 1 << 1,
+        Error = 1 << 2, // Always reported, no need to request it
+        HangUp = 1 << 3, // Always reported, no need to request it
+    };
+
+    PULSARION_WINDOWING_API IoEvents operator|(IoEvents lhs, IoEvents rhs);
+    PULSARION_WINDOWING_API IoEvents operator&(IoEvents lhs, IoEvents rhs);
+    PULSARION_WINDOWING_API bool HasFlag(const IoEvents& flags, const IoEvents& flag);
+
+    enum class DispatchOrder : std::uint8_t
+    {
+        WindowFirst = 0, // PollEvents, then the ready sources
+        SourcesFirst, // Ready sources, then PollEvents
+    };
+
+    class PULSARION_WINDOWING_API EventLoop
+    {
+    public:
+        using IoCallback = std::function<void(void* userData, int fd, IoEvents events)>;
+
+        explicit EventLoop(DispatchOrder order = DispatchOrder::WindowFirst);
+        ~EventLoop();
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        /*!
+         * @brief Registers a file descriptor, the callback runs on the loop thread whenever it is ready.
+         * Sources are level triggered, so a callback that doesn't drain its fd is called again on the next iteration.
+         * It is safe to add or remove sources, including the one being dispatched, from inside a callback.
+         * @return false if the fd is already registered or epoll rejected it
+         */
+        bool AddSource(int fd, IoEvents events, IoCallback&& callback, void* userData = nullptr);
+        bool ModifySource(int fd, IoEvents events);
+        void RemoveSource(int fd);
+
+        // Timers are armed on a timerfd, so they wake a blocking RunOnce on time instead of being rounded to the epoll timeout.
+        // Use these instead of the window's timers when the loop drives the window, those only fire when the window is polled.
+        TimerId AddTimer(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat = true);
+        void RemoveTimer(TimerId id);
+        void SetUserData(void* userData) { m_UserData = userData; } // Passed to the timer callbacks
+        [[nodiscard]] void* GetUserData() const { return m_UserData; }
+
+        // PollEvents is called once per iteration and Run stops when the window should close. Pass nullptr to detach.
+        // Register the display connection fd as a source as well, otherwise window events can't interrupt a blocking wait.
+        void SetWindow(Window* window) { m_Window = window; }
+        [[nodiscard]] Window* GetWindow() const { return m_Window; }
+        void SetDispatchOrder(DispatchOrder order) { m_Order = order; }
+        [[nodiscard]] DispatchOrder GetDispatchOrder() const { return m_Order; }
+
+        /*!
+         * @brief Waits until a source is ready, Wakeup is called or the timeout expires, then dispatches everything that is ready.
+         * @param timeout std::nullopt waits indefinitely, zero only dispatches what is already ready
+         * @return The number of sources dispatched
+         */
+        std::size_t RunOnce(std::optional<std::chrono::nanoseconds> timeout = std::nullopt);
+        void Run(); // Until Stop is called or the window should close
+        void Stop(); // Thread safe
+
+        void Wakeup(); // Thread safe, interrupts a blocking RunOnce
+
+    private:
+        struct Source;
+
+        std::size_t DispatchSources(std::optional<std::chrono::nanoseconds> timeout);
+        void ArmTimerFd();
+
+        int m_Epoll;
+        int m_WakeupFd;
+        int m_TimerFd;
+        TimerQueue m_Timers;
+        void* m_UserData = nullptr;
+        DispatchOrder m_Order;
+        Window* m_Window = nullptr;
+        std::atomic<bool> m_Stopped = false;
+        bool m_Dispatching = false;
+        std::vector<std::unique_ptr<Source>> m_Sources; // Indexed by fd
+        std::vector<std::unique_ptr<Source>> m_Removed; // Sources removed during dispatch, freed once it finishes
+        std::vector<epoll_event> m_ReadyEvents;
+    };
+}
@@ -0,0 +1,280 @@
+#include "EventStorm.hpp"
+
+#include "PulsarionCore/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace Pulsarion::Windowing
+{
+    static double ToSeconds(std::chrono::nanoseconds duration)
+    {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    double EventStormReport::GetThroughput() const
+    {
+        const double seconds = ToSeconds(DispatchTime);
+        return seconds > 0.0 ? static_cast<double>(Dispatched) / seconds : 0.0;
+    }
+
+    double EventStormReport::GetCoalescingRatio() const
+    {
+        return Generated > 0 ? static_cast<double>(Coalesced) / static_cast<double>(Generated) : 0.0;
+    }
+
+    double EventStormReport::GetDispatchShare() const
+    {
+        return Duration.count() > 0 ? ToSeconds(DispatchTime) / ToSeconds(Duration) : 0.0;
+    }
+
+    std::chrono::nanoseconds EventStormReport::GetMeanFrameTime() const
+    {
+        return Frames > 0 ? Duration / static_cast<std::int64_t>(Frames) : std::chrono::nanoseconds(0);
+    }
+
+    bool EventStormReport::IsFallingBehind() const
+    {
+        // Compares the first and last quarter, a single spike in between isn't falling behind
+        const std::size_t quarter = QueueDepth.size() / 4;
+        if (quarter == 0)
+            return false;
+        std::uint64_t first = 0;
+        std::uint64_t last = 0;
+        for (std::size_t i = 0; i < quarter; i++)
+        {
+            first += QueueDepth[i];
+            last += QueueDepth[QueueDepth.size() - quarter + i];
+        }
+        return last > first && QueueDepth.back() > 0;
+    }
+
+    std::string FormatEventStormReport(const EventStormReport& report)
+    {
+        std::ostringstream out;
+        const auto line = [&out](std::string_view metric, auto value, std::string_view unit)
+        {
+            out << "eventstorm." << metric << ' ' << value << ' ' << unit << '\n';
+        };
+        line("throughput", report.GetThroughput(), "events/s");
+        line("generated", report.Generated, "events");
+        line("dispatched", report.Dispatched, "events");
+        line("coalesced", report.Coalesced, "events");
+        line("dropped", report.Dropped, "events");
+        line("coalescing_ratio", report.GetCoalescingRatio(), "ratio");
+        line("max_queue_depth", report.MaxQueueDepth, "events");
+        line("final_queue_depth", report.QueueDepth.empty() ? 0u : report.QueueDepth.back(), "events");
+        line("frames", report.Frames, "frames");
+        line("mean_frame_time", report.GetMeanFrameTime().count(), "ns");
+        line("max_frame_time", report.MaxFrameTime.count(), "ns");
+        line("max_dispatch_time", report.MaxDispatchTime.count(), "ns");
+        line("dispatch_share", report.GetDispatchShare(), "ratio");
+        line("falling_behind", report.IsFallingBehind() ? 1 : 0, "bool");
+        return out.str();
+    }
+
+    bool CheckEventStormBaseline(const EventStormReport& report, const EventStormBaseline& baseline)
+    {
+        bool passed = true;
+        const double minimum = baseline.Throughput * (1.0 - baseline.Tolerance);
+        if (report.GetThroughput() < minimum)
+        {
+            PULSARION_LOG_ERROR("[EventStorm] Throughput regressed to {0} events/s, the baseline allows {1}", report.GetThroughput(), minimum);
+            passed = false;
+        }
+        if (!baseline.AllowFallingBehind && report.IsFallingBehind())
+        {
+            PULSARION_LOG_ERROR("[EventStorm] The queue kept growing, {0} events were still pending at the end", report.QueueDepth.back());
+            passed = false;
+        }
+        return passed;
+    }
+
+    template<Clock ClockType>
+    BasicEventStorm<ClockType>::BasicEventStorm(EventBus& bus, EventStormConfig config, ClockType clock)
+        : m_Bus(bus), m_Clock(std::move(clock)), m_Config(config), m_Random(config.Seed | 1)
+    {
+    }
+
+    template<Clock ClockType>
+    std::uint64_t BasicEventStorm<ClockType>::Next()
+    {
+        // xorshift64, the storm only needs to be cheap and repeatable
+        m_Random ^= m_Random << 13;
+        m_Random ^= m_Random >> 7;
+        m_Random ^= m_Random << 17;
+        return m_Random;
+    }
+
+    template<Clock ClockType>
+    std::size_t BasicEventStorm<ClockType>::Pump(TimePoint now)
+    {
+        if (!m_Started)
+        {
+            m_Started = true;
+            m_Start = now;
+            m_LastPump = now;
+            return 0;
+        }
+
+        const auto frameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_LastPump);
+        m_LastPump = now;
+        m_Report.Frames++;
+        m_Report.Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_Start);
+        m_Report.MaxFrameTime = std::max(m_Report.MaxFrameTime, frameTime);
+
+        m_Due += m_Config.EventsPerSecond * ToSeconds(frameTime);
+        const double due = std::floor(m_Due);
+        m_Due -= due;
+        Generate(static_cast<std::uint64_t>(due));
+
+        const std::size_t count = m_Config.DispatchBudget > 0 ? std::min(m_Config.DispatchBudget, m_Count) : m_Count;
+        const auto dispatchStart = m_Clock.Now();
+        for (std::size_t i = 0; i < count; i++)
+        {
+            // Popped first, so a listener pumping again doesn't see the same event
+            const Event event = At(0);
+            m_Head = (m_Head + 1) & (m_Queue.size() - 1);
+            m_Count--;
+            Dispatch(event);
+        }
+        const auto dispatchTime = std::chrono::duration_cast<std::chrono::nanoseconds>(m_Clock.Now() - dispatchStart);
+
+        m_Report.Dispatched += count;
+        m_Report.DispatchTime += dispatchTime;
+        m_Report.MaxDispatchTime = std::max(m_Report.MaxDispatchTime, dispatchTime);
+        m_Report.QueueDepth.push_back(static_cast<std::uint32_t>(m_Count));
+        return count;
+    }
+
+    template<Clock ClockType>
+    void BasicEventStorm<ClockType>::Generate(std::uint64_t count)
+    {
+        const EventStormMix& mix = m_Config.Mix;
+        const std::array<std::uint32_t, 7> weights = { mix.MouseMove, mix.RawMouseMove, mix.MouseWheel, mix.MouseButton, mix.Key, mix.Text, mix.Resize };
+        std::uint64_t total = 0;
+        for (const std::uint32_t weight : weights)
+            total += weight;
+        if (total == 0)
+            return;
+
+        m_Report.Generated += count;
+        for (std::uint64_t i = 0; i < count; i++)
+        {
+            std::uint64_t pick = Next() % total;
+            std::size_t kind = 0;
+            while (pick >= weights[kind])
+                pick -= weights[kind++];
+
+            Event event { static_cast<Kind>(kind), 0, { 0.0f, 0.0f } };
+            const std::uint64_t random = Next();
+            switch (event.Type)
+            {
+            case Kind::MouseMove:
+                event.Value = { static_cast<float>(random % 1920), static_cast<float>((random >> 16) % 1080) };
+                break;
+            case Kind::RawMouseMove:
+            case Kind::MouseWheel:
+                event.Value = { static_cast<float>(static_cast<int>(random % 9) - 4), static_cast<float>(static_cast<int>((random >> 8) % 9) - 4) };
+                break;
+            case Kind::MouseButton:
+                m_ButtonDown = !m_ButtonDown;
+                event.Code = m_ButtonDown ? 1 : 0;
+                break;
+            case Kind::Key:
+                m_KeyDown = !m_KeyDown;
+                event.Code = m_KeyDown ? 1 : 0;
+                break;
+            case Kind::Text:
+                break;
+            case Kind::Resize:
+                event.Value = { static_cast<float>(640 + random % 1280), static_cast<float>(480 + (random >> 16) % 600) };
+                break;
+            }
+
+            // Only the newest state of these matters, like a platform queue that merges them
+            if (m_Config.Coalesce && m_Count > 0 && At(m_Count - 1).Type == event.Type)
+            {
+                Event& back = At(m_Count - 1);
+                if (event.Type == Kind::MouseMove || event.Type == Kind::Resize)
+                {
+                    back.Value = event.Value;
+                    m_Report.Coalesced++;
+                    continue;
+                }
+                if (event.Type == Kind::RawMouseMove)
+                {
+                    back.Value = { back.Value.x + event.Value.x, back.Value.y + event.Value.y };
+                    m_Report.Coalesced++;
+                    continue;
+                }
+            }
+
+            if (m_Count >= m_Config.MaxQueueDepth)
+            {
+                m_Report.Dropped++;
+                continue;
+            }
+            Push(event);
+            m_Report.MaxQueueDepth = std::max(m_Report.MaxQueueDepth, m_Count);
+        }
+    }
+
+    template<Clock ClockType>
+    void BasicEventStorm<ClockType>::Push(const Event& event)
+    {
+        if (m_Count == m_Queue.size())
+        {
+            // Unrolled into the front of the bigger ring, so the indices stay a mask away
+            std::vector<Event> grown(std::max<std::size_t>(m_Queue.size() * 2, 64));
+            for (std::size_t i = 0; i < m_Count; i++)
+                grown[i] = At(i);
+            m_Queue = std::move(grown);
+            m_Head = 0;
+        }
+        At(m_Count++) = event;
+    }
+
+    template<Clock ClockType>
+    void BasicEventStorm<ClockType>::Dispatch(const Event& event)
+    {
+        void* userData = m_Bus.GetWindow() != nullptr ? m_Bus.GetWindow()->GetUserData() : nullptr;
+        switch (event.Type)
+        {
+        case Kind::MouseMove:
+            m_Bus.Dispatch<EventType::MouseMove>(userData, event.Value);
+            break;
+        case Kind::RawMouseMove:
+            m_Bus.Dispatch<EventType::RawMouseMove>(userData, event.Value, std::span<const Point>(&event.Value, 1));
+            break;
+        case Kind::MouseWheel:
+            m_Bus.Dispatch<EventType::MouseWheel>(userData, Point { 0.0f, 0.0f }, event.Value);
+            break;
+        case Kind::MouseButton:
+            if (event.Code != 0)
+                m_Bus.Dispatch<EventType::MouseDown>(userData, Point { 0.0f, 0.0f }, MouseCode::ButtonLeft);
+            else
+                m_Bus.Dispatch<EventType::MouseUp>(userData, Point { 0.0f, 0.0f }, MouseCode::ButtonLeft);
+            break;
+        case Kind::Key:
+            if (event.Code != 0)
+                m_Bus.Dispatch<EventType::KeyDown>(userData, KeyCode::A, Modifier(0), false);
+            else
+                m_Bus.Dispatch<EventType::KeyUp>(userData, KeyCode::A, Modifier(0));
+            break;
+        case Kind::Text:
+            m_Bus.Dispatch<EventType::TextInput>(userData, std::string_view("storm"));
+            break;
+        case Kind::Resize:
+            m_Bus.Dispatch<EventType::Resize>(userData, static_cast<std::uint32_t>(event.Value.x), static_cast<std::uint32_t>(event.Value.y));
+            break;
+        }
+    }
+
+    template class BasicEventStorm<SteadyClock>;
+    template class BasicEventStorm<ManualClock>;
+}
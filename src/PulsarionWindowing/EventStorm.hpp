@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Clock.hpp"
+#include "EventBus.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    // Relative weights of the generated events, zero never generates that kind
+    struct EventStormMix
+    {
+        std::uint32_t MouseMove = 60;
+        std::uint32_t RawMouseMove = 20;
+        std::uint32_t MouseWheel = 5;
+        std::uint32_t MouseButton = 4; // Alternating down and up
+        std::uint32_t Key = 6; // Alternating down and up
+        std::uint32_t Text = 4;
+        std::uint32_t Resize = 1;
+    };
+
+    struct EventStormConfig
+    {
+        double EventsPerSecond = 200000.0;
+        EventStormMix Mix;
+        std::size_t DispatchBudget = 0; // The most events dispatched per Pump, 0 dispatches the whole queue
+        bool Coalesce = true; // Pending moves, raw motion and resizes collapse into one event, the way the platforms deliver them
+        std::size_t MaxQueueDepth = 1 << 20; // Events generated beyond this are dropped and counted
+        std::uint64_t Seed = 1;
+    };
+
+    struct EventStormReport
+    {
+        std::uint64_t Generated = 0;
+        std::uint64_t Coalesced = 0;
+        std::uint64_t Dropped = 0;
+        std::uint64_t Dispatched = 0;
+        std::uint64_t Frames = 0;
+        std::chrono::nanoseconds Duration = {};
+        std::chrono::nanoseconds DispatchTime = {}; // Spent in the listeners
+        std::chrono::nanoseconds MaxFrameTime = {};
+        std::chrono::nanoseconds MaxDispatchTime = {}; // The longest a single frame spent dispatching
+        std::size_t MaxQueueDepth = 0;
+        std::vector<std::uint32_t> QueueDepth; // After every Pump
+
+        // Events the listeners get through per second of dispatching, what the loop could sustain
+        [[nodiscard]] double GetThroughput() const;
+        // The share of generated events that were merged into another one
+        [[nodiscard]] double GetCoalescingRatio() const;
+        // The share of the frame time spent dispatching
+        [[nodiscard]] double GetDispatchShare() const;
+        [[nodiscard]] std::chrono::nanoseconds GetMeanFrameTime() const;
+        // The queue at the end of the run is deeper than at its start, the loop never catches up at this rate
+        [[nodiscard]] bool IsFallingBehind() const;
+    };
+
+    // What a benchmark run is held to
+    struct EventStormBaseline
+    {
+        double Throughput = 0.0; // Events per second from an earlier run
+        double Tolerance = 0.1; // A regression beyond this share fails
+        bool AllowFallingBehind = false;
+    };
+
+    // One "eventstorm.<metric> <value> <unit>" line per metric, stable so scripts can compare runs
+    PULSARION_WINDOWING_API std::string FormatEventStormReport(const EventStormReport& report);
+    // Logs why and returns false when the report regressed beyond the baseline, a benchmark exits with failure on it
+    PULSARION_WINDOWING_API bool CheckEventStormBaseline(const EventStormReport& report, const EventStormBaseline& baseline);
+
+    /*!
+     * @brief Floods a bus with synthetic events at a fixed rate, to see how the listeners and the frame hold up under a misbehaving driver.
+     * Call Pump once per frame instead of (or after) PollEvents: it generates the events due since the last call into a queue, coalescing
+     * them if configured, dispatches the queue (up to the budget) through EventBus::Dispatch and records the queue depth and the time taken.
+     * The bus can be attached to a window, the window's own listeners see the storm like real input.
+     * Use EventStorm, with ManualClock the events generated and the times reported only depend on how the clock is advanced.
+     */
+    template<Clock ClockType>
+    class BasicEventStorm
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        explicit BasicEventStorm(EventBus& bus, EventStormConfig config = {}, ClockType clock = ClockType());
+
+        BasicEventStorm(const BasicEventStorm&) = delete;
+        BasicEventStorm& operator=(const BasicEventStorm&) = delete;
+
+        // Returns the number of events dispatched. The first call only starts the clock.
+        std::size_t Pump() { return Pump(m_Clock.Now()); }
+        std::size_t Pump(TimePoint now);
+
+        [[nodiscard]] const EventStormReport& GetReport() const { return m_Report; }
+        [[nodiscard]] std::size_t GetQueueDepth() const { return m_Count; }
+        [[nodiscard]] const EventStormConfig& GetConfig() const { return m_Config; }
+        void SetConfig(const EventStormConfig& config) { m_Config = config; }
+        [[nodiscard]] const ClockType& GetClock() const { return m_Clock; }
+        // Makes room for this many more Pumps in the report's queue depths, so a run that is checked for allocations doesn't grow it
+        void ReservePumps(std::size_t count) { m_Report.QueueDepth.reserve(m_Report.QueueDepth.size() + count); }
+
+    private:
+        enum class Kind : std::uint8_t
+        {
+            MouseMove = 0,
+            RawMouseMove,
+            MouseWheel,
+            MouseButton,
+            Key,
+            Text,
+            Resize,
+        };
+
+        struct Event
+        {
+            Kind Type;
+            std::uint8_t Code; // The button or key, and whether it is pressed
+            Point Value;
+        };
+
+        void Generate(std::uint64_t count);
+        void Push(const Event& event);
+        [[nodiscard]] Event& At(std::size_t index) { return m_Queue[(m_Head + index) & (m_Queue.size() - 1)]; }
+        void Dispatch(const Event& event);
+        [[nodiscard]] std::uint64_t Next();
+
+        EventBus& m_Bus;
+        [[no_unique_address]] ClockType m_Clock;
+        EventStormConfig m_Config;
+        std::vector<Event> m_Queue; // Ring with a power of two size, it only grows so a steady rate stops allocating
+        std::size_t m_Head = 0;
+        std::size_t m_Count = 0;
+        EventStormReport m_Report;
+        std::uint64_t m_Random;
+        double m_Due = 0.0; // Fractional events carried to the next Pump
+        bool m_ButtonDown = false;
+        bool m_KeyDown = false;
+        bool m_Started = false;
+        TimePoint m_Start;
+        TimePoint m_LastPump;
+    };
+
+    // Defined in EventStorm.cpp for the clocks we ship
+    extern template class PULSARION_WINDOWING_API BasicEventStorm<SteadyClock>;
+    extern template class PULSARION_WINDOWING_API BasicEventStorm<ManualClock>;
+
+    using EventStorm = BasicEventStorm<SteadyClock>;
+}
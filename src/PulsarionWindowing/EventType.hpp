@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Core.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace Pulsarion::Windowing
+{
+    // One entry per Window callback, in the order they are declared in Window
+    enum class EventType : std::uint8_t
+    {
+        Close = 0,
+        WindowVisibility,
+        Focus,
+        Resize,
+        Move,
+        BeforeResize,
+        AfterResize,
+        Minimize,
+        Maximize,
+        Fullscreen,
+        Restore,
+        Occlusion,
+        MouseEnter,
+        MouseLeave,
+        MouseDown,
+        MouseUp,
+        MouseMove,
+        MouseWheel,
+        RawMouseMove,
+        Touch,
+        KeyDown,
+        KeyUp,
+        KeyTyped,
+        TextInput,
+        Count
+    };
+
+    constexpr std::size_t EventTypeCount = static_cast<std::size_t>(EventType::Count);
+
+    constexpr std::string_view EventTypeToString(EventType type)
+    {
+        constexpr std::array<std::string_view, EventTypeCount> names = {
+            "Close", "WindowVisibility", "Focus", "Resize", "Move", "BeforeResize", "AfterResize", "Minimize", "Maximize", "Fullscreen", "Restore", "Occlusion",
+            "MouseEnter", "MouseLeave", "MouseDown", "MouseUp", "MouseMove", "MouseWheel", "RawMouseMove", "Touch",
+            "KeyDown", "KeyUp", "KeyTyped", "TextInput",
+        };
+        const auto index = static_cast<std::size_t>(type);
+        return index < names.size() ? names[index] : "Unknown";
+    }
+
+    // A set of event types, used to mask events a window should not translate at all
+    enum class EventTypeFlags : std::uint32_t
+    {
+        None = 0,
+        All = (1u << EventTypeCount) - 1,
+    };
+    static_assert(EventTypeCount < 32, "EventTypeFlags needs a wider underlying type");
+
+    constexpr EventTypeFlags ToFlag(EventType type)
+    {
+        return static_cast<EventTypeFlags>(1u << static_cast<std::uint32_t>(type));
+    }
+
+    constexpr EventTypeFlags operator|(EventTypeFlags lhs, EventTypeFlags rhs)
+    {
+        return static_cast<EventTypeFlags>(static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs));
+    }
+
+    constexpr EventTypeFlags operator|(EventTypeFlags lhs, EventType rhs)
+    {
+        return lhs | ToFlag(rhs);
+    }
+
+    constexpr EventTypeFlags operator|(EventType lhs, EventType rhs)
+    {
+        return ToFlag(lhs) | ToFlag(rhs);
+    }
+
+    constexpr EventTypeFlags operator&(EventTypeFlags lhs, EventTypeFlags rhs)
+    {
+        return static_cast<EventTypeFlags>(static_cast<std::uint32_t>(lhs) & static_cast<std::uint32_t>(rhs));
+    }
+
+    constexpr EventTypeFlags operator~(EventTypeFlags flags)
+    {
+        return static_cast<EventTypeFlags>(~static_cast<std::uint32_t>(flags)) & EventTypeFlags::All;
+    }
+
+    // These are checked for every native event, so unlike the other flag enums they are constexpr and live in the header
+    constexpr bool HasFlag(EventTypeFlags flags, EventType type)
+    {
+        return (flags & ToFlag(type)) != EventTypeFlags::None;
+    }
+
+    constexpr bool HasAnyFlag(EventTypeFlags flags, EventTypeFlags any)
+    {
+        return (flags & any) != EventTypeFlags::None;
+    }
+}
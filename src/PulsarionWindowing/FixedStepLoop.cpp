@@ -0,0 +1,112 @@
+#include "FixedStepLoop.hpp"
+#include "Window.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Pulsarion::Windowing
+{
+    template<Clock ClockType>
+    BasicFixedStepLoop<ClockType>::BasicFixedStepLoop(Window& window, std::uint32_t stepsPerSecond, std::uint32_t targetFps, ClockType clock)
+        : m_Window(window), m_Clock(std::move(clock)), m_Limiter(targetFps, m_Clock), m_StepTime(std::chrono::nanoseconds(std::chrono::seconds(1)) / std::max<std::uint32_t>(stepsPerSecond, 1)),
+          m_SimulationTime(m_Clock.Now())
+    {
+    }
+
+    template<Clock ClockType>
+    void BasicFixedStepLoop<ClockType>::SetStepRate(std::uint32_t stepsPerSecond)
+    {
+        m_StepTime = std::chrono::nanoseconds(std::chrono::seconds(1)) / std::max<std::uint32_t>(stepsPerSecond, 1);
+    }
+
+    template<Clock ClockType>
+    void BasicFixedStepLoop<ClockType>::QueueInput(TimePoint time, InputCallback&& input)
+    {
+        // Almost always the newest, so this is usually an append. Only the undelivered inputs are searched,
+        // so one stamped before already delivered ones (late, or queued from a delivered input) is delivered next.
+        const auto begin = m_Inputs.begin() + static_cast<std::ptrdiff_t>(m_DeliveredInputs);
+        const auto position = std::upper_bound(begin, m_Inputs.end(), time, [](TimePoint value, const QueuedInput& other) { return value < other.Time; });
+        m_Inputs.insert(position, QueuedInput { time, std::move(input) });
+    }
+
+    template<Clock ClockType>
+    void BasicFixedStepLoop<ClockType>::DeliverInput(TimePoint until)
+    {
+        // Indexed since an input may queue more input
+        while (m_DeliveredInputs < m_Inputs.size() && m_Inputs[m_DeliveredInputs].Time < until)
+        {
+            auto input = std::move(m_Inputs[m_DeliveredInputs].Input);
+            m_DeliveredInputs++;
+            if (input)
+                input(m_UserData);
+        }
+    }
+
+    template<Clock ClockType>
+    void BasicFixedStepLoop<ClockType>::Step()
+    {
+        const auto stepEnd = m_SimulationTime + m_StepTime;
+        DeliverInput(stepEnd);
+
+        const auto start = m_Clock.Now();
+        if (m_OnStep)
+            m_OnStep(m_UserData, m_StepTime, m_Stats.Steps);
+        const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(m_Clock.Now() - start);
+
+        m_Stats.LastStepCost = cost;
+        m_Stats.AverageStepCost = m_Stats.Steps == 0 ? cost : m_Stats.AverageStepCost + (cost - m_Stats.AverageStepCost) / 16;
+        m_Stats.MaxStepCost = std::max(m_Stats.MaxStepCost, cost);
+        m_Stats.Steps++;
+        m_Stats.FrameSteps++;
+        m_SimulationTime = stepEnd;
+    }
+
+    template<Clock ClockType>
+    bool BasicFixedStepLoop<ClockType>::RunFrame()
+    {
+        m_Limiter.StartFrame();
+        m_Window.PollEvents();
+        if (m_Window.ShouldClose())
+            return false;
+
+        const auto now = m_Clock.Now();
+        m_Stats.FrameSteps = 0;
+        while (m_SimulationTime + m_StepTime <= now && m_Stats.FrameSteps < m_MaxStepsPerFrame)
+            Step();
+
+        if (m_SimulationTime + m_StepTime <= now)
+        {
+            // Stepping can't keep up, drop the backlog instead of spending ever longer frames catching up on it
+            const auto dropped = (now - m_SimulationTime) / m_StepTime;
+            m_SimulationTime += m_StepTime * dropped;
+            m_Stats.DroppedSteps += static_cast<std::uint64_t>(dropped);
+            DeliverInput(m_SimulationTime); // Still in order, just not spread over the steps that were dropped
+        }
+
+        if (m_DeliveredInputs > 0)
+        {
+            m_Inputs.erase(m_Inputs.begin(), m_Inputs.begin() + static_cast<std::ptrdiff_t>(m_DeliveredInputs));
+            m_DeliveredInputs = 0;
+        }
+
+        if (m_OnRender)
+        {
+            const double alpha = std::chrono::duration<double>(now - m_SimulationTime) / std::chrono::duration<double>(m_StepTime);
+            m_OnRender(m_UserData, std::clamp(alpha, 0.0, 1.0));
+        }
+
+        m_Limiter.EndFrame();
+        return true;
+    }
+
+    template<Clock ClockType>
+    void BasicFixedStepLoop<ClockType>::Run()
+    {
+        while (RunFrame())
+        {
+        }
+    }
+
+    template class BasicFixedStepLoop<SteadyClock>;
+    template class BasicFixedStepLoop<ManualClock>;
+}
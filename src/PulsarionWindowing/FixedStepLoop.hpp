@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Clock.hpp"
+#include "FrameLimiter.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    class Window;
+
+    struct FixedStepStats
+    {
+        std::uint64_t Steps = 0; // Since the loop was created
+        std::uint32_t FrameSteps = 0; // In the last frame
+        std::uint64_t DroppedSteps = 0; // Skipped by the max steps per frame guard
+        std::chrono::nanoseconds LastStepCost = {};
+        std::chrono::nanoseconds AverageStepCost = {}; // Moving average
+        std::chrono::nanoseconds MaxStepCost = {};
+    };
+
+    /*!
+     * @brief The usual "step the simulation at a fixed rate, render with an interpolation alpha" loop.
+     * Every frame polls the window, runs as many steps as real time has covered (at most MaxStepsPerFrame, the rest is dropped so a slow
+     * frame can't snowball), renders with how far real time is into the next step, then lets the FrameLimiter pace the frame.
+     * Input queued with QueueInput is delivered in timestamp order right before the first step that ends after it happened, so
+     * what the simulation sees doesn't depend on how the frames happened to line up.
+     */
+    template<Clock ClockType>
+    class BasicFixedStepLoop
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+        using StepCallback = std::function<void(void*, std::chrono::nanoseconds, std::uint64_t)>; // Step time and step index
+        using RenderCallback = std::function<void(void*, double)>; // Interpolation alpha, in [0, 1)
+        using InputCallback = std::function<void(void*)>;
+
+        BasicFixedStepLoop(Window& window, std::uint32_t stepsPerSecond, std::uint32_t targetFps = 60, ClockType clock = ClockType());
+
+        BasicFixedStepLoop(const BasicFixedStepLoop&) = delete;
+        BasicFixedStepLoop& operator=(const BasicFixedStepLoop&) = delete;
+
+        // Runs one frame, returns false once the window should close
+        bool RunFrame();
+        void Run();
+
+        // Usually called from the window's callbacks during PollEvents, stamped with the current time
+        void QueueInput(InputCallback&& input) { QueueInput(m_Clock.Now(), std::move(input)); }
+        void QueueInput(TimePoint time, InputCallback&& input);
+
+        void SetOnStep(StepCallback&& onStep) { m_OnStep = std::move(onStep); }
+        void SetOnRender(RenderCallback&& onRender) { m_OnRender = std::move(onRender); }
+        void SetUserData(void* userData) { m_UserData = userData; }
+
+        void SetStepRate(std::uint32_t stepsPerSecond);
+        [[nodiscard]] std::chrono::nanoseconds GetStepTime() const { return m_StepTime; }
+        void SetMaxStepsPerFrame(std::uint32_t maxSteps) { m_MaxStepsPerFrame = maxSteps == 0 ? 1 : maxSteps; }
+        [[nodiscard]] std::uint32_t GetMaxStepsPerFrame() const { return m_MaxStepsPerFrame; }
+
+        [[nodiscard]] const FixedStepStats& GetStats() const { return m_Stats; }
+        [[nodiscard]] BasicFrameLimiter<ClockType>& GetFrameLimiter() { return m_Limiter; }
+        [[nodiscard]] TimePoint GetSimulationTime() const { return m_SimulationTime; } // Where the last step ended
+
+    private:
+        struct QueuedInput
+        {
+            TimePoint Time;
+            InputCallback Input;
+        };
+
+        void DeliverInput(TimePoint until);
+        void Step();
+
+        Window& m_Window;
+        ClockType m_Clock;
+        BasicFrameLimiter<ClockType> m_Limiter;
+        std::chrono::nanoseconds m_StepTime;
+        std::uint32_t m_MaxStepsPerFrame = 8;
+        TimePoint m_SimulationTime;
+        std::vector<QueuedInput> m_Inputs; // Sorted by time, ties in the order they were queued
+        std::size_t m_DeliveredInputs = 0;
+        StepCallback m_OnStep = nullptr;
+        RenderCallback m_OnRender = nullptr;
+        void* m_UserData = nullptr;
+        FixedStepStats m_Stats;
+    };
+
+    // Defined in FixedStepLoop.cpp for the clocks we ship
+    extern template class PULSARION_WINDOWING_API BasicFixedStepLoop<SteadyClock>;
+    extern template class PULSARION_WINDOWING_API BasicFixedStepLoop<ManualClock>;
+
+    using FixedStepLoop = BasicFixedStepLoop<SteadyClock>;
+}
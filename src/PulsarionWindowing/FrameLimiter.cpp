@@ -1,86 +1,123 @@
 #include "FrameLimiter.hpp"
+#include "Window.hpp"
+#include "Watchdog.hpp"
 
-#include <thread>
-
-#ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
-#include <Windows.h>
-#endif
+#include <algorithm>
+#include <type_traits>
+#include <utility>
 
 namespace Pulsarion::Windowing
 {
-    #ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-    std::uint32_t FrameLimiter::s_InstanceCount = 0;
-    #endif
-
-    FrameLimiter::FrameLimiter(std::uint32_t targetFps)
-        : m_TargetFps(targetFps), m_FrameTime(std::chrono::milliseconds(1000 / m_TargetFps)), m_LastFrameTime(std::chrono::steady_clock::now())
+    template<Clock ClockType>
+    BasicFrameLimiter<ClockType>::BasicFrameLimiter(std::uint32_t targetFps, ClockType clock)
+        : m_Clock(std::move(clock)), m_TargetFps(targetFps), m_FrameTime(std::chrono::milliseconds(1000 / m_TargetFps)), m_LastFrameTime(m_Clock.Now())
     {
         #ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
-        if (s_InstanceCount == 0)
-            timeBeginPeriod(1);
-        s_InstanceCount++;
+        if constexpr (std::is_same_v<ClockType, SteadyClock>)
+            SteadyClock::AcquireHighResolution();
         #endif
     }
 
-    FrameLimiter::~FrameLimiter()
+    template<Clock ClockType>
+    BasicFrameLimiter<ClockType>::BasicFrameLimiter(const Window& window, std::uint32_t divisor, ClockType clock)
+        : BasicFrameLimiter(60, std::move(clock)) // Used until the refresh rate is known
+    {
+        SyncToDisplay(window, divisor);
+    }
+
+    template<Clock ClockType>
+    BasicFrameLimiter<ClockType>::~BasicFrameLimiter()
     {
         #ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
-        s_InstanceCount--;
-        if (s_InstanceCount == 0)
-            timeEndPeriod(1);
+        if constexpr (std::is_same_v<ClockType, SteadyClock>)
+            SteadyClock::ReleaseHighResolution();
         #endif
     }
 
-    void FrameLimiter::StartFrame()
+    template<Clock ClockType>
+    void BasicFrameLimiter<ClockType>::StartFrame()
     {
-        m_LastFrameTime = std::chrono::steady_clock::now();
+        if (m_Watchdog != nullptr)
+            m_Watchdog->Beat(LoopPhase::Frame);
+        m_LastFrameTime = m_Clock.Now();
     }
 
-    void FrameLimiter::EndFrame()
+    template<Clock ClockType>
+    void BasicFrameLimiter<ClockType>::SyncToDisplay(const Window& window, std::uint32_t divisor)
     {
-        if (m_TargetFps >= 100'000)
-            return; // No need to limit frame rate if it's too high
-        auto currentTime = std::chrono::steady_clock::now();
-        auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - m_LastFrameTime);
+        m_Window = &window;
+        m_Divisor = std::max<std::uint32_t>(divisor, 1);
+        m_RefreshRate = 0.0; // Recomputes the period on the next frame
+        m_FrameCost = {};
+        m_HasPhase = false;
+    }
 
-        #ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
-        if (elapsedTime < m_FrameTime)
-        {
-            #ifdef PULSARION_WINDOWING_USE_BUSY_WAIT
-            auto sleepTime = m_FrameTime - elapsedTime - std::chrono::milliseconds(1);
-            #else
-            auto sleepTime = m_FrameTime - elapsedTime;
-            #endif
-            if (sleepTime > std::chrono::milliseconds(1))
-                Sleep(static_cast<DWORD>(sleepTime.count()));
+    template<Clock ClockType>
+    bool BasicFrameLimiter<ClockType>::PaceToDisplay(TimePoint now)
+    {
+        const DisplayTiming timing = m_Window->GetDisplayTiming();
+        if (timing.RefreshRate <= 0.0)
+            return false;
 
-            #ifdef PULSARION_WINDOWING_USE_BUSY_WAIT
-            auto end = currentTime + sleepTime;
-            while (std::chrono::steady_clock::now() < end)
-            {
-                // Busy wait
-            }
-            #endif
+        const auto vblankPeriod = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / timing.RefreshRate));
+        if (timing.RefreshRate != m_RefreshRate)
+        {
+            // Another monitor or mode, the old phase means nothing anymore
+            m_RefreshRate = timing.RefreshRate;
+            m_Period = vblankPeriod * m_Divisor;
+            m_FrameTime = std::chrono::duration_cast<std::chrono::milliseconds>(m_Period);
+            m_HasPhase = false;
         }
-        #elif defined(PULSARION_WINDOWING_USE_BUSY_WAIT)
-        if (elapsedTime < m_FrameTime)
+
+        const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_LastFrameTime);
+        m_FrameCost = m_FrameCost.count() == 0 ? cost : m_FrameCost + (cost - m_FrameCost) / 8;
+
+        if (timing.LastVblank.has_value())
         {
-            auto sleepTime = m_FrameTime - elapsedTime;
-            if (sleepTime > std::chrono::milliseconds(16)) // Windows has a limit of 15ms for sleep time
-                std::this_thread::sleep_for(sleepTime);
+            // Snap to the vblank that is closest to our phase, so with a divisor we keep using the same one of every N vblanks
+            const auto vblank = *timing.LastVblank;
+            if (!m_HasPhase)
+                m_Phase = vblank;
             else
             {
-                auto end = currentTime + sleepTime;
-                while (std::chrono::steady_clock::now() < end)
-                {
-                    // Busy wait
-                }
+                const auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>(vblank - m_Phase);
+                const auto periods = (offset + (offset.count() < 0 ? -vblankPeriod : vblankPeriod) / 2) / vblankPeriod;
+                m_Phase = vblank - vblankPeriod * periods;
             }
         }
-        #else
-        if (elapsedTime < m_FrameTime)
-            std::this_thread::sleep_for(m_FrameTime - elapsedTime);
-        #endif
+        else if (!m_HasPhase)
+        {
+            m_Phase = now; // No vblanks to lock to, at least keep our own deadlines evenly spaced
+        }
+        m_HasPhase = true;
+
+        // The first deadline that still leaves room for a whole frame, with some headroom since half the frames are slower than the average.
+        // If the renderer blocks in present until the vblank, that wait counts as frame cost and we simply start right after it.
+        const auto lead = m_FrameCost + m_FrameCost / 4;
+        const auto ahead = std::chrono::duration_cast<std::chrono::nanoseconds>(now + lead - m_Phase);
+        auto periods = ahead / m_Period;
+        if (ahead % m_Period > std::chrono::nanoseconds::zero())
+            periods++;
+        const auto deadline = m_Phase + m_Period * periods;
+
+        m_Clock.SleepUntil(deadline - lead);
+        return true;
     }
+
+    template<Clock ClockType>
+    void BasicFrameLimiter<ClockType>::EndFrame()
+    {
+        if (m_Watchdog != nullptr)
+            m_Watchdog->Beat(LoopPhase::Sleeping);
+        if (m_Window != nullptr && PaceToDisplay(m_Clock.Now()))
+            return;
+        if (m_TargetFps >= 100'000)
+            return; // No need to limit frame rate if it's too high
+
+        // The clock picks the sleep strategy (high resolution sleep, busy waiting)
+        m_Clock.SleepUntil(m_LastFrameTime + m_FrameTime);
+    }
+
+    template class BasicFrameLimiter<SteadyClock>;
+    template class BasicFrameLimiter<ManualClock>;
 }
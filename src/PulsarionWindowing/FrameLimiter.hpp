@@ -1,32 +1,75 @@
 #pragma once
 
 #include "Core.hpp"
+#include "Clock.hpp"
 
 #include <chrono>
+#include <cstdint>
 
 namespace Pulsarion::Windowing
 {
-    class PULSARION_WINDOWING_API FrameLimiter
+    class Window;
+    class Watchdog;
+
+    // Use FrameLimiter, the clock is only swapped for tests and simulations (ManualClock)
+    template<Clock ClockType>
+    class BasicFrameLimiter
     {
     public:
-        explicit FrameLimiter(std::uint32_t targetFps);
-        ~FrameLimiter();
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        explicit BasicFrameLimiter(std::uint32_t targetFps, ClockType clock = ClockType());
+        // Paces to the display the window is on, see SyncToDisplay
+        explicit BasicFrameLimiter(const Window& window, std::uint32_t divisor = 1, ClockType clock = ClockType());
+        ~BasicFrameLimiter();
+
+        BasicFrameLimiter(const BasicFrameLimiter&) = delete;
+        BasicFrameLimiter& operator=(const BasicFrameLimiter&) = delete;
 
         void StartFrame();
         void EndFrame(); // This is where it will sleep if needed
 
-        void SetTargetFps(std::uint32_t targetFps) { m_TargetFps = targetFps; m_FrameTime = std::chrono::milliseconds(1000 / m_TargetFps); }
+        // Also stops syncing to the display
+        void SetTargetFps(std::uint32_t targetFps) { m_Window = nullptr; m_TargetFps = targetFps; m_FrameTime = std::chrono::milliseconds(1000 / m_TargetFps); }
         [[nodiscard]] std::uint32_t GetTargetFps() const { return m_TargetFps; }
         [[nodiscard]] std::chrono::milliseconds GetFrameTime() const { return m_FrameTime; }
 
+        /*!
+         * @brief Locks the frame deadlines to the refresh period and vblank phase of the display the window is on, a fixed frame time beats against it and judders.
+         * The divisor runs at a fraction of the refresh rate (2 gives 60 fps on 120 Hz). Instead of sleeping right after a frame, EndFrame wakes up
+         * just in time for the next frame to finish before its vblank, based on a moving average of the frame cost, so input is read as late as possible.
+         * The timing is asked from the window every frame, so moving it to another monitor is picked up. Falls back to the target fps while the refresh rate is unknown.
+         * The window must outlive the limiter, or SetTargetFps has to be called before it is destroyed.
+         */
+        void SyncToDisplay(const Window& window, std::uint32_t divisor = 1);
+        [[nodiscard]] bool IsSyncedToDisplay() const { return m_Window != nullptr; }
+        [[nodiscard]] std::chrono::nanoseconds GetFramePeriod() const { return m_Period; } // Only when synced to the display
+        [[nodiscard]] std::chrono::nanoseconds GetFrameCostEstimate() const { return m_FrameCost; }
+        [[nodiscard]] const ClockType& GetClock() const { return m_Clock; }
+        // StartFrame beats it, EndFrame tells it the loop is sleeping. nullptr detaches it.
+        void SetWatchdog(Watchdog* watchdog) { m_Watchdog = watchdog; }
+
     private:
+        bool PaceToDisplay(TimePoint now);
+
+        [[no_unique_address]] ClockType m_Clock;
         std::uint32_t m_TargetFps;
         std::chrono::milliseconds m_FrameTime;
-        std::chrono::time_point<std::chrono::steady_clock> m_LastFrameTime;
+        TimePoint m_LastFrameTime;
 
-        #ifdef PULSARION_WINDOWING_USE_HIGH_RES_SLEEP
-        // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-        static std::uint32_t s_InstanceCount; // We use this so we don't prematurely release the high resolution sleep timer when destroying FrameLimiters
-        #endif
+        const Window* m_Window = nullptr;
+        std::uint32_t m_Divisor = 1;
+        double m_RefreshRate = 0.0;
+        std::chrono::nanoseconds m_Period = {};
+        std::chrono::nanoseconds m_FrameCost = {}; // Moving average of StartFrame to EndFrame
+        TimePoint m_Phase; // A past deadline, the next ones are a whole number of periods after it
+        bool m_HasPhase = false;
+        Watchdog* m_Watchdog = nullptr;
     };
+
+    // Defined in FrameLimiter.cpp for the clocks we ship
+    extern template class PULSARION_WINDOWING_API BasicFrameLimiter<SteadyClock>;
+    extern template class PULSARION_WINDOWING_API BasicFrameLimiter<ManualClock>;
+
+    using FrameLimiter = BasicFrameLimiter<SteadyClock>;
 }
@@ -0,0 +1,42 @@
+#include "Gamepad.hpp"
+
+#include "PulsarionCore/Log.hpp"
+
+namespace Pulsarion::Windowing
+{
+#if defined(PULSARION_PLATFORM_WINDOWS) || defined(PULSARION_PLATFORM_MACOS)
+    // No backend here yet, the manager never sees a gamepad so the same game loop runs everywhere. Linux/Gamepad.cpp has the evdev one.
+    GamepadManager::GamepadManager(const GamepadConfig&)
+        : m_Impl(nullptr)
+    {
+    }
+
+    GamepadManager::~GamepadManager() = default;
+
+    void GamepadManager::Poll()
+    {
+    }
+
+    const GamepadState& GamepadManager::GetState(std::size_t) const
+    {
+        static const GamepadState disconnected{};
+        return disconnected;
+    }
+
+    std::string_view GamepadManager::GetName(std::size_t) const
+    {
+        return {};
+    }
+
+    std::size_t GamepadManager::GetConnectedCount() const
+    {
+        return 0;
+    }
+
+    std::size_t GamepadManager::OpenRecording(const std::string& path)
+    {
+        PULSARION_LOG_WARN("[Gamepad] Can't replay {0}, evdev recordings are only supported on Linux", path);
+        return MaxGamepads;
+    }
+#endif
+}
@@ -0,0 +1,100 @@
+#pragma once
+// Polled gamepad state. Call GamepadManager::Poll once per frame next to Window::PollEvents, there are no callbacks and no threads.
+// Only Linux has a backend, elsewhere the manager reports no gamepads.
+
+#include "Core.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Pulsarion::Windowing
+{
+    // Positional names, South is A on Xbox and Cross on PlayStation controllers
+    enum class GamepadButton : std::uint8_t
+    {
+        South = 0,
+        East,
+        West,
+        North,
+        LeftBumper,
+        RightBumper,
+        Back,
+        Start,
+        Guide,
+        LeftThumb,
+        RightThumb,
+        DPadUp,
+        DPadRight,
+        DPadDown,
+        DPadLeft,
+        Count
+    };
+
+    enum class GamepadAxis : std::uint8_t
+    {
+        LeftX = 0,
+        LeftY,
+        RightX,
+        RightY,
+        LeftTrigger,
+        RightTrigger,
+        Count
+    };
+
+    struct GamepadState
+    {
+        bool Connected = false;
+        std::array<float, static_cast<std::size_t>(GamepadAxis::Count)> Axes{}; // Sticks are [-1, 1], triggers [0, 1], deadzones applied
+        std::uint32_t Buttons = 0; // One bit per GamepadButton
+        std::uint32_t Pressed = 0; // Buttons that went down during the last Poll
+        std::uint32_t Released = 0; // Buttons that went up during the last Poll
+
+        [[nodiscard]] bool IsDown(GamepadButton button) const { return (Buttons & (1u << static_cast<std::uint32_t>(button))) != 0; }
+        [[nodiscard]] bool WasPressed(GamepadButton button) const { return (Pressed & (1u << static_cast<std::uint32_t>(button))) != 0; }
+        [[nodiscard]] bool WasReleased(GamepadButton button) const { return (Released & (1u << static_cast<std::uint32_t>(button))) != 0; }
+        [[nodiscard]] float GetAxis(GamepadAxis axis) const { return Axes[static_cast<std::size_t>(axis)]; }
+    };
+
+    struct GamepadConfig
+    {
+        float StickDeadzone = 0.15f; // Radial, the remaining range is rescaled to [0, 1]
+        float TriggerDeadzone = 0.05f;
+        bool WatchHotplug = true;
+    };
+
+    /*!
+     * @brief Enumerates the connected controllers and keeps their state up to date.
+     * On Linux this reads evdev devices from /dev/input, draining every pending event of a device with one read() per Poll,
+     * and watches the directory with inotify for hotplug. On Windows and macOS it is a stub that never has a gamepad connected.
+     */
+    class PULSARION_WINDOWING_API GamepadManager
+    {
+    public:
+        static constexpr std::size_t MaxGamepads = 8;
+
+        explicit GamepadManager(const GamepadConfig& config = {});
+        ~GamepadManager();
+
+        GamepadManager(const GamepadManager&) = delete;
+        GamepadManager& operator=(const GamepadManager&) = delete;
+
+        void Poll();
+
+        [[nodiscard]] const GamepadState& GetState(std::size_t index) const;
+        [[nodiscard]] std::string_view GetName(std::size_t index) const;
+        [[nodiscard]] std::size_t GetConnectedCount() const;
+
+        /*!
+         * @brief Replays a recorded evdev stream (raw struct input_event records, e.g. `cat /dev/input/eventN > file`) as a gamepad.
+         * Every Poll advances the recording by one SYN_REPORT frame, which makes it usable for tests without hardware.
+         * @return The gamepad index, or MaxGamepads if the file could not be opened or all slots are in use.
+         */
+        std::size_t OpenRecording(const std::string& path);
+
+        class Impl;
+    private:
+        Impl* m_Impl;
+    };
+}
@@ -0,0 +1,34 @@
+#include "Image.hpp"
+
+#include <cstring>
+
+namespace Pulsarion::Windowing
+{
+    static std::uint64_t Mix(std::uint64_t hash, std::uint64_t value)
+    {
+        // The finalizer of splitmix64 on top of a multiply, every input bit reaches every output bit
+        hash = (hash ^ value) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 30;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 27;
+        return hash;
+    }
+
+    std::uint64_t HashImage(const ImageView& image, std::uint64_t seed)
+    {
+        std::uint64_t hash = Mix(seed, (static_cast<std::uint64_t>(image.Width) << 32) | image.Height);
+        const std::size_t size = image.Pixels.size();
+        std::size_t offset = 0;
+        // Eight bytes at a time, memcpy since the pixels don't have to be aligned
+        for (; offset + 8 <= size; offset += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, image.Pixels.data() + offset, sizeof(word));
+            hash = Mix(hash, word);
+        }
+        std::uint64_t tail = 0;
+        if (offset < size)
+            std::memcpy(&tail, image.Pixels.data() + offset, size - offset);
+        return Mix(hash, tail ^ size);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Core.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <utility>
+
+namespace Pulsarion::Windowing
+{
+    // Straight (not premultiplied) RGBA8 pixels, rows top to bottom without padding. Only a view, the pixels can live in a MappedFile.
+    struct ImageView
+    {
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+        std::span<const std::byte> Pixels;
+
+        [[nodiscard]] bool IsValid() const
+        {
+            return Width != 0 && Height != 0 && Pixels.size() >= static_cast<std::size_t>(Width) * Height * 4;
+        }
+    };
+
+    // A 64 bit hash of the size and pixels, one pass over the pixels and no allocation
+    PULSARION_WINDOWING_API std::uint64_t HashImage(const ImageView& image, std::uint64_t seed = 0);
+
+    /*!
+     * @brief Keeps the native objects (cursors, icons) the backends create from images, keyed by the content hash.
+     * Setting an image that was used before only costs the hash, the native object isn't created and uploaded again.
+     * Entries live as long as the cache, since a native cursor can't be destroyed while it may still be shown.
+     */
+    template<typename Handle, typename Deleter>
+    class NativeImageCache
+    {
+    public:
+        NativeImageCache() = default;
+        ~NativeImageCache() { Clear(); }
+
+        NativeImageCache(const NativeImageCache&) = delete;
+        NativeImageCache& operator=(const NativeImageCache&) = delete;
+
+        // Calls create() only on a miss, a null handle from it isn't cached
+        template<typename Create>
+        Handle GetOrCreate(std::uint64_t hash, Create&& create)
+        {
+            if (const auto it = m_Entries.find(hash); it != m_Entries.end())
+                return it->second;
+            Handle handle = create();
+            if (handle)
+                m_Entries.emplace(hash, handle);
+            return handle;
+        }
+
+        void Clear()
+        {
+            for (auto& [hash, handle] : m_Entries)
+                Deleter()(handle);
+            m_Entries.clear();
+        }
+
+        [[nodiscard]] std::size_t GetSize() const { return m_Entries.size(); }
+
+    private:
+        std::unordered_map<std::uint64_t, Handle> m_Entries;
+    };
+}
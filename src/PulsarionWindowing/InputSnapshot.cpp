@@ -0,0 +1,105 @@
+#include "InputSnapshot.hpp"
+
+#include "PulsarionCore/Assert.hpp"
+
+#include <limits>
+
+namespace Pulsarion::Windowing
+{
+    InputSnapshotPublisher::InputSnapshotPublisher(EventBus& bus)
+        : m_Bus(bus)
+    {
+        PULSARION_ASSERT(bus.GetWindow() != nullptr, "The event bus must be attached to a window");
+
+        // First in line and never consuming, a listener that consumes a key up must not leave the key held here
+        constexpr std::int32_t priority = std::numeric_limits<std::int32_t>::max();
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseMove>([this](void*, Point position) { m_State.MousePosition = position; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseDown>([this](void*, Point position, MouseCode button)
+        {
+            m_State.MousePosition = position;
+            SetButton(button, true);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseUp>([this](void*, Point position, MouseCode button)
+        {
+            m_State.MousePosition = position;
+            SetButton(button, false);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseWheel>([this](void*, Point, ScrollOffset offset)
+        {
+            m_State.ScrollTotal.x += offset.x;
+            m_State.ScrollTotal.y += offset.y;
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseEnter>([this](void*) { m_State.MouseInside = true; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseLeave>([this](void*) { m_State.MouseInside = false; return false; }, priority));
+
+        m_Subscriptions.push_back(bus.Subscribe<EventType::KeyDown>([this](void*, KeyCode key, Modifier modifiers, bool)
+        {
+            SetKey(key, true);
+            m_State.Modifiers = modifiers;
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::KeyUp>([this](void*, KeyCode key, Modifier modifiers)
+        {
+            SetKey(key, false);
+            m_State.Modifiers = modifiers;
+            return false;
+        }, priority));
+
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Focus>([this](void*, bool focused)
+        {
+            m_State.Focused = focused;
+            if (!focused)
+            {
+                m_State.Keys = {};
+                m_State.MouseButtons = 0;
+                m_State.Modifiers = 0;
+            }
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Minimize>([this](void*) { m_State.Minimized = true; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Restore>([this](void*) { m_State.Minimized = false; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Maximize>([this](void*) { m_State.Minimized = false; return false; }, priority));
+    }
+
+    void InputSnapshotPublisher::Publish(std::chrono::steady_clock::time_point now)
+    {
+        m_State.Sequence++;
+        m_State.Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+        if (const Window* window = m_Bus.GetWindow())
+        {
+            // Asked instead of listening for Resize, which only comes once the size changes from the one the window was created with
+            const WindowSize size = window->GetContentSize();
+            m_State.Width = size.Width;
+            m_State.Height = size.Height;
+            m_State.SizeGeneration = window->GetSizeGeneration();
+        }
+        m_Buffer.Publish(m_State);
+    }
+
+    void InputSnapshotPublisher::SetKey(KeyCode key, bool down)
+    {
+        const auto index = static_cast<std::size_t>(key);
+        if (key == KeyCode::Unknown || index >= InputSnapshot::KeyWords * 64)
+            return;
+        const std::uint64_t bit = std::uint64_t(1) << (index % 64);
+        if (down)
+            m_State.Keys[index / 64] |= bit;
+        else
+            m_State.Keys[index / 64] &= ~bit;
+    }
+
+    void InputSnapshotPublisher::SetButton(MouseCode button, bool down)
+    {
+        const auto index = static_cast<std::size_t>(button);
+        if (index >= 8)
+            return;
+        const auto bit = static_cast<std::uint8_t>(1u << index);
+        if (down)
+            m_State.MouseButtons |= bit;
+        else
+            m_State.MouseButtons = static_cast<std::uint8_t>(m_State.MouseButtons & ~bit);
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Core.hpp"
+#include "EventBus.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+#include "TripleBuffer.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    // The input and window state at the end of one PollEvents, plain data so it can be copied between threads
+    struct InputSnapshot
+    {
+        static constexpr std::size_t KeyWords = 6; // One bit per KeyCode, the highest is Menu (348)
+
+        std::uint64_t Sequence = 0; // Counts publishes, a reader that sees it jump by more than one missed snapshots
+        std::int64_t Timestamp = 0; // steady_clock nanoseconds at publish
+
+        Point MousePosition = { 0.0f, 0.0f };
+        Point ScrollTotal = { 0.0f, 0.0f }; // Summed since the publisher was created, diff two snapshots for the scroll in between
+        std::uint8_t MouseButtons = 0; // One bit per MouseCode
+        std::array<std::uint64_t, KeyWords> Keys = {};
+        Modifier Modifiers = 0;
+
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+        std::uint64_t SizeGeneration = 0;
+
+        bool Focused = true;
+        bool MouseInside = false;
+        bool Minimized = false;
+
+        [[nodiscard]] bool IsKeyDown(KeyCode key) const
+        {
+            const auto index = static_cast<std::size_t>(key);
+            return index < KeyWords * 64 && (Keys[index / 64] & (std::uint64_t(1) << (index % 64))) != 0;
+        }
+
+        [[nodiscard]] bool IsMouseDown(MouseCode button) const
+        {
+            const auto index = static_cast<std::size_t>(button);
+            return index < 8 && (MouseButtons & (1u << index)) != 0;
+        }
+
+        [[nodiscard]] std::chrono::steady_clock::time_point GetTime() const
+        {
+            return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(Timestamp)));
+        }
+    };
+    static_assert(std::is_trivially_copyable_v<InputSnapshot>, "Snapshots are copied between threads with memcpy semantics");
+
+    /*!
+     * @brief Publishes an InputSnapshot after every PollEvents for a render (or any other) thread to read without locks.
+     * It listens on an attached EventBus with the highest priority and without consuming, so it sees the same input as everyone else.
+     * The event thread calls Publish after PollEvents, the reader thread calls Read and gets the newest complete snapshot.
+     * Held keys and buttons are released when focus is lost, since their up events go to whichever window has focus then.
+     */
+    class PULSARION_WINDOWING_API InputSnapshotPublisher
+    {
+    public:
+        explicit InputSnapshotPublisher(EventBus& bus);
+
+        InputSnapshotPublisher(const InputSnapshotPublisher&) = delete;
+        InputSnapshotPublisher& operator=(const InputSnapshotPublisher&) = delete;
+
+        // Event thread
+        void Publish(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+        [[nodiscard]] const InputSnapshot& GetState() const { return m_State; } // The state the next Publish will send
+
+        // Reader thread, only one
+        [[nodiscard]] const InputSnapshot& Read() { return m_Buffer.Read(); }
+
+    private:
+        void SetKey(KeyCode key, bool down);
+        void SetButton(MouseCode button, bool down);
+
+        EventBus& m_Bus;
+        std::vector<Subscription> m_Subscriptions;
+        InputSnapshot m_State;
+        TripleBuffer<InputSnapshot> m_Buffer;
+    };
+}
@@ -0,0 +1,394 @@
+#pragma once
+// The single source of truth for key translation. Every backend lookup table, the key names and the
+// name -> key hash are generated from KeyTable::Entries at compile time, so translating a key is one array load.
+
+#include "Keyboard.hpp"
+
+#include <array>
+#include <string_view>
+
+namespace Pulsarion::Windowing::KeyTable
+{
+    // Marks a key that has no native code on a platform
+    constexpr std::uint16_t NoCode = 0xFFFF;
+    constexpr std::uint32_t NoKeysym = 0;
+
+    struct Entry
+    {
+        KeyCode Key;
+        std::string_view Name; // Empty for aliases, which only add another native code for an existing key
+        std::uint16_t VirtualKey; // Windows VK_*
+        std::uint16_t MacKeyCode; // macOS kVK_*
+        std::uint32_t Keysym; // X11 XK_* (unshifted)
+        std::uint16_t Scancode; // Linux evdev KEY_*
+    };
+
+    // NOLINTBEGIN(readability-magic-numbers)
+    inline constexpr Entry Entries[] = {
+        // Key                     Name               VK      kVK     Keysym    evdev
+        { KeyCode::Space,          "Space",           0x20,   0x31,   0x0020,   57 },
+        { KeyCode::Apostrophe,     "Apostrophe",      0xDE,   0x27,   0x0027,   40 },
+        { KeyCode::Comma,          "Comma",           0xBC,   0x2B,   0x002C,   51 },
+        { KeyCode::Minus,          "Minus",           0xBD,   0x1B,   0x002D,   12 },
+        { KeyCode::Period,         "Period",          0xBE,   0x2F,   0x002E,   52 },
+        { KeyCode::Slash,          "Slash",           0xBF,   0x2C,   0x002F,   53 },
+
+        { KeyCode::D0,             "0",               0x30,   0x1D,   0x0030,   11 },
+        { KeyCode::D1,             "1",               0x31,   0x12,   0x0031,   2 },
+        { KeyCode::D2,             "2",               0x32,   0x13,   0x0032,   3 },
+        { KeyCode::D3,             "3",               0x33,   0x14,   0x0033,   4 },
+        { KeyCode::D4,             "4",               0x34,   0x15,   0x0034,   5 },
+        { KeyCode::D5,             "5",               0x35,   0x17,   0x0035,   6 },
+        { KeyCode::D6,             "6",               0x36,   0x16,   0x0036,   7 },
+        { KeyCode::D7,             "7",               0x37,   0x1A,   0x0037,   8 },
+        { KeyCode::D8,             "8",               0x38,   0x1C,   0x0038,   9 },
+        { KeyCode::D9,             "9",               0x39,   0x19,   0x0039,   10 },
+
+        { KeyCode::Semicolon,      "Semicolon",       0xBA,   0x29,   0x003B,   39 },
+        { KeyCode::Equal,          "Equal",           0xBB,   0x18,   0x003D,   13 },
+
+        { KeyCode::A,              "A",               0x41,   0x00,   0x0061,   30 },
+        { KeyCode::B,              "B",               0x42,   0x0B,   0x0062,   48 },
+        { KeyCode::C,              "C",               0x43,   0x08,   0x0063,   46 },
+        { KeyCode::D,              "D",               0x44,   0x02,   0x0064,   32 },
+        { KeyCode::E,              "E",               0x45,   0x0E,   0x0065,   18 },
+        { KeyCode::F,              "F",               0x46,   0x03,   0x0066,   33 },
+        { KeyCode::G,              "G",               0x47,   0x05,   0x0067,   34 },
+        { KeyCode::H,              "H",               0x48,   0x04,   0x0068,   35 },
+        { KeyCode::I,              "I",               0x49,   0x22,   0x0069,   23 },
+        { KeyCode::J,              "J",               0x4A,   0x26,   0x006A,   36 },
+        { KeyCode::K,              "K",               0x4B,   0x28,   0x006B,   37 },
+        { KeyCode::L,              "L",               0x4C,   0x25,   0x006C,   38 },
+        { KeyCode::M,              "M",               0x4D,   0x2E,   0x006D,   50 },
+        { KeyCode::N,              "N",               0x4E,   0x2D,   0x006E,   49 },
+        { KeyCode::O,              "O",               0x4F,   0x1F,   0x006F,   24 },
+        { KeyCode::P,              "P",               0x50,   0x23,   0x0070,   25 },
+        { KeyCode::Q,              "Q",               0x51,   0x0C,   0x0071,   16 },
+        { KeyCode::R,              "R",               0x52,   0x0F,   0x0072,   19 },
+        { KeyCode::S,              "S",               0x53,   0x01,   0x0073,   31 },
+        { KeyCode::T,              "T",               0x54,   0x11,   0x0074,   20 },
+        { KeyCode::U,              "U",               0x55,   0x20,   0x0075,   22 },
+        { KeyCode::V,              "V",               0x56,   0x09,   0x0076,   47 },
+        { KeyCode::W,              "W",               0x57,   0x0D,   0x0077,   17 },
+        { KeyCode::X,              "X",               0x58,   0x07,   0x0078,   45 },
+        { KeyCode::Y,              "Y",               0x59,   0x10,   0x0079,   21 },
+        { KeyCode::Z,              "Z",               0x5A,   0x06,   0x007A,   44 },
+
+        { KeyCode::LeftBracket,    "Left bracket",    0xDB,   0x21,   0x005B,   26 },
+        { KeyCode::Backslash,      "Backslash",       0xDC,   0x2A,   0x005C,   43 },
+        { KeyCode::RightBracket,   "Right bracket",   0xDD,   0x1E,   0x005D,   27 },
+        { KeyCode::GraveAccent,    "Grave accent",    0xC0,   0x32,   0x0060,   41 },
+
+        { KeyCode::World1,         "World 1",         NoCode, 0x0A,   0x003C,   86 },
+        { KeyCode::World2,         "World 2",         NoCode, NoCode, NoKeysym, NoCode },
+
+        { KeyCode::Escape,         "Escape",          0x1B,   0x35,   0xFF1B,   1 },
+        { KeyCode::Enter,          "Enter",           0x0D,   0x24,   0xFF0D,   28 },
+        { KeyCode::Tab,            "Tab",             0x09,   0x30,   0xFF09,   15 },
+        { KeyCode::Backspace,      "Backspace",       0x08,   0x33,   0xFF08,   14 },
+        { KeyCode::Insert,         "Insert",          0x2D,   0x72,   0xFF63,   110 },
+        { KeyCode::Delete,         "Delete",          0x2E,   0x75,   0xFFFF,   111 },
+        { KeyCode::Right,          "Right",           0x27,   0x7C,   0xFF53,   106 },
+        { KeyCode::Left,           "Left",            0x25,   0x7B,   0xFF51,   105 },
+        { KeyCode::Down,           "Down",            0x28,   0x7D,   0xFF54,   108 },
+        { KeyCode::Up,             "Up",              0x26,   0x7E,   0xFF52,   103 },
+        { KeyCode::PageUp,         "Page up",         0x21,   0x74,   0xFF55,   104 },
+        { KeyCode::PageDown,       "Page down",       0x22,   0x79,   0xFF56,   109 },
+        { KeyCode::Home,           "Home",            0x24,   0x73,   0xFF50,   102 },
+        { KeyCode::End,            "End",             0x23,   0x77,   0xFF57,   107 },
+        { KeyCode::CapsLock,       "Caps lock",       0x14,   0x39,   0xFFE5,   58 },
+        { KeyCode::ScrollLock,     "Scroll lock",     0x91,   NoCode, 0xFF14,   70 },
+        { KeyCode::NumLock,        "Num lock",        0x90,   NoCode, 0xFF7F,   69 },
+        { KeyCode::PrintScreen,    "Print screen",    0x2C,   NoCode, 0xFF61,   99 },
+        { KeyCode::Pause,          "Pause",           0x13,   NoCode, 0xFF13,   119 },
+
+        { KeyCode::F1,             "F1",              0x70,   0x7A,   0xFFBE,   59 },
+        { KeyCode::F2,             "F2",              0x71,   0x78,   0xFFBF,   60 },
+        { KeyCode::F3,             "F3",              0x72,   0x63,   0xFFC0,   61 },
+        { KeyCode::F4,             "F4",              0x73,   0x76,   0xFFC1,   62 },
+        { KeyCode::F5,             "F5",              0x74,   0x60,   0xFFC2,   63 },
+        { KeyCode::F6,             "F6",              0x75,   0x61,   0xFFC3,   64 },
+        { KeyCode::F7,             "F7",              0x76,   0x62,   0xFFC4,   65 },
+        { KeyCode::F8,             "F8",              0x77,   0x64,   0xFFC5,   66 },
+        { KeyCode::F9,             "F9",              0x78,   0x65,   0xFFC6,   67 },
+        { KeyCode::F10,            "F10",             0x79,   0x6D,   0xFFC7,   68 },
+        { KeyCode::F11,            "F11",             0x7A,   0x67,   0xFFC8,   87 },
+        { KeyCode::F12,            "F12",             0x7B,   0x6F,   0xFFC9,   88 },
+        { KeyCode::F13,            "F13",             0x7C,   0x69,   0xFFCA,   183 },
+        { KeyCode::F14,            "F14",             0x7D,   0x6B,   0xFFCB,   184 },
+        { KeyCode::F15,            "F15",             0x7E,   0x71,   0xFFCC,   185 },
+        { KeyCode::F16,            "F16",             0x7F,   0x6A,   0xFFCD,   186 },
+        { KeyCode::F17,            "F17",             0x80,   0x40,   0xFFCE,   187 },
+        { KeyCode::F18,            "F18",             0x81,   0x4F,   0xFFCF,   188 },
+        { KeyCode::F19,            "F19",             0x82,   0x50,   0xFFD0,   189 },
+        { KeyCode::F20,            "F20",             0x83,   0x5A,   0xFFD1,   190 },
+        { KeyCode::F21,            "F21",             0x84,   NoCode, 0xFFD2,   191 },
+        { KeyCode::F22,            "F22",             0x85,   NoCode, 0xFFD3,   192 },
+        { KeyCode::F23,            "F23",             0x86,   NoCode, 0xFFD4,   193 },
+        { KeyCode::F24,            "F24",             0x87,   NoCode, 0xFFD5,   194 },
+        { KeyCode::F25,            "F25",             NoCode, NoCode, 0xFFD6,   NoCode },
+
+        { KeyCode::KP0,            "Keypad 0",        0x60,   0x52,   0xFFB0,   82 },
+        { KeyCode::KP1,            "Keypad 1",        0x61,   0x53,   0xFFB1,   79 },
+        { KeyCode::KP2,            "Keypad 2",        0x62,   0x54,   0xFFB2,   80 },
+        { KeyCode::KP3,            "Keypad 3",        0x63,   0x55,   0xFFB3,   81 },
+        { KeyCode::KP4,            "Keypad 4",        0x64,   0x56,   0xFFB4,   75 },
+        { KeyCode::KP5,            "Keypad 5",        0x65,   0x57,   0xFFB5,   76 },
+        { KeyCode::KP6,            "Keypad 6",        0x66,   0x58,   0xFFB6,   77 },
+        { KeyCode::KP7,            "Keypad 7",        0x67,   0x59,   0xFFB7,   71 },
+        { KeyCode::KP8,            "Keypad 8",        0x68,   0x5B,   0xFFB8,   72 },
+        { KeyCode::KP9,            "Keypad 9",        0x69,   0x5C,   0xFFB9,   73 },
+        { KeyCode::KPDecimal,      "Keypad decimal",  0x6E,   0x41,   0xFFAE,   83 },
+        { KeyCode::KPDivide,       "Keypad divide",   0x6F,   0x4B,   0xFFAF,   98 },
+        { KeyCode::KPMultiply,     "Keypad multiply", 0x6A,   0x43,   0xFFAA,   55 },
+        { KeyCode::KPSubtract,     "Keypad subtract", 0x6D,   0x4E,   0xFFAD,   74 },
+        { KeyCode::KPAdd,          "Keypad add",      0x6B,   0x45,   0xFFAB,   78 },
+        { KeyCode::KPEnter,        "Keypad enter",    NoCode, 0x4C,   0xFF8D,   96 },
+        { KeyCode::KPEqual,        "Keypad equal",    NoCode, 0x51,   0xFFBD,   117 },
+
+        { KeyCode::LeftShift,      "Left shift",      0xA0,   0x38,   0xFFE1,   42 },
+        { KeyCode::LeftControl,    "Left control",    0xA2,   0x3B,   0xFFE3,   29 },
+        { KeyCode::LeftAlt,        "Left alt",        0xA4,   0x3A,   0xFFE9,   56 },
+        { KeyCode::LeftSuper,      "Left super",      0x5B,   0x37,   0xFFEB,   125 },
+        { KeyCode::RightShift,     "Right shift",     0xA1,   0x3C,   0xFFE2,   54 },
+        { KeyCode::RightControl,   "Right control",   0xA3,   0x3E,   0xFFE4,   97 },
+        { KeyCode::RightAlt,       "Right alt",       0xA5,   0x3D,   0xFFEA,   100 },
+        { KeyCode::RightSuper,     "Right super",     0x5C,   0x36,   0xFFEC,   126 },
+        { KeyCode::Menu,           "Menu",            0x5D,   0x6E,   0xFF67,   127 },
+
+        // Aliases: generic modifiers reported without a side, and layout specific keys that share a meaning
+        { KeyCode::LeftShift,      {},                0x10,   NoCode, NoKeysym, NoCode },
+        { KeyCode::LeftControl,    {},                0x11,   NoCode, NoKeysym, NoCode },
+        { KeyCode::LeftAlt,        {},                0x12,   NoCode, 0xFFE7,   NoCode },
+        { KeyCode::Backslash,      {},                0xE2,   NoCode, NoKeysym, NoCode },
+        { KeyCode::KPEnter,        {},                NoCode, 0x47,   NoKeysym, NoCode },
+        { KeyCode::Menu,           {},                NoCode, NoCode, NoKeysym, 139 },
+    };
+    // NOLINTEND(readability-magic-numbers)
+
+    constexpr std::size_t KeyCodeCount = static_cast<std::size_t>(KeyCode::Menu) + 1;
+
+    template<std::size_t Size, typename Projection>
+    constexpr std::array<KeyCode, Size> MakeFromNative(Projection projection)
+    {
+        std::array<KeyCode, Size> table{};
+        for (const auto& entry : Entries)
+        {
+            const auto code = static_cast<std::size_t>(projection(entry));
+            if (code < Size && table[code] == KeyCode::Unknown)
+                table[code] = entry.Key;
+        }
+        return table;
+    }
+
+    template<typename Native, typename Projection>
+    constexpr std::array<Native, KeyCodeCount> MakeToNative(Projection projection, Native none)
+    {
+        std::array<Native, KeyCodeCount> table{};
+        table.fill(none);
+        for (const auto& entry : Entries)
+        {
+            auto& slot = table[static_cast<std::size_t>(entry.Key)];
+            if (slot == none)
+                slot = static_cast<Native>(projection(entry));
+        }
+        return table;
+    }
+
+    constexpr std::array<std::string_view, KeyCodeCount> MakeNames()
+    {
+        std::array<std::string_view, KeyCodeCount> names{};
+        names.fill("Unknown");
+        for (const auto& entry : Entries)
+        {
+            if (!entry.Name.empty())
+                names[static_cast<std::size_t>(entry.Key)] = entry.Name;
+        }
+        return names;
+    }
+
+    // X11 keysyms are sparse, but everything we care about is either Latin-1 (0x00xx) or a function key (0xFFxx)
+    constexpr std::uint32_t FunctionKeysymPage = 0xFF00;
+
+    inline constexpr auto Names = MakeNames();
+    inline constexpr auto FromVirtualKeyTable = MakeFromNative<256>([](const Entry& e) { return e.VirtualKey; });
+    inline constexpr auto FromMacKeyCodeTable = MakeFromNative<128>([](const Entry& e) { return e.MacKeyCode; });
+    inline constexpr auto FromScancodeTable = MakeFromNative<256>([](const Entry& e) { return e.Scancode; });
+    inline constexpr auto FromLatin1KeysymTable = MakeFromNative<256>([](const Entry& e) { return e.Keysym == NoKeysym || e.Keysym >= 0x100 ? 0x100u : e.Keysym; });
+    inline constexpr auto FromFunctionKeysymTable = MakeFromNative<256>([](const Entry& e) { return (e.Keysym & FunctionKeysymPage) == FunctionKeysymPage ? e.Keysym & 0xFFu : 0x100u; });
+    inline constexpr auto ToVirtualKeyTable = MakeToNative<std::uint16_t>([](const Entry& e) { return e.VirtualKey; }, NoCode);
+    inline constexpr auto ToMacKeyCodeTable = MakeToNative<std::uint16_t>([](const Entry& e) { return e.MacKeyCode; }, NoCode);
+    inline constexpr auto ToScancodeTable = MakeToNative<std::uint16_t>([](const Entry& e) { return e.Scancode; }, NoCode);
+    inline constexpr auto ToKeysymTable = MakeToNative<std::uint32_t>([](const Entry& e) { return e.Keysym; }, NoKeysym);
+
+    [[nodiscard]] constexpr std::string_view GetName(KeyCode key)
+    {
+        const auto index = static_cast<std::size_t>(key);
+        return index < Names.size() ? Names[index] : Names[0];
+    }
+
+    [[nodiscard]] constexpr KeyCode FromVirtualKey(std::uint32_t virtualKey)
+    {
+        return virtualKey < FromVirtualKeyTable.size() ? FromVirtualKeyTable[virtualKey] : KeyCode::Unknown;
+    }
+
+    [[nodiscard]] constexpr KeyCode FromMacKeyCode(std::uint16_t macKeyCode)
+    {
+        return macKeyCode < FromMacKeyCodeTable.size() ? FromMacKeyCodeTable[macKeyCode] : KeyCode::Unknown;
+    }
+
+    [[nodiscard]] constexpr KeyCode FromScancode(std::uint32_t scancode)
+    {
+        return scancode < FromScancodeTable.size() ? FromScancodeTable[scancode] : KeyCode::Unknown;
+    }
+
+    [[nodiscard]] constexpr KeyCode FromKeysym(std::uint32_t keysym)
+    {
+        if (keysym >= 'A' && keysym <= 'Z') // Shifted letters share the key of the unshifted keysym
+            keysym += 'a' - 'A';
+        if (keysym < FromLatin1KeysymTable.size())
+            return FromLatin1KeysymTable[keysym];
+        if ((keysym & ~0xFFu) == FunctionKeysymPage)
+            return FromFunctionKeysymTable[keysym & 0xFFu];
+        return KeyCode::Unknown;
+    }
+
+    [[nodiscard]] constexpr std::uint16_t ToVirtualKey(KeyCode key)
+    {
+        const auto index = static_cast<std::size_t>(key);
+        return index < ToVirtualKeyTable.size() ? ToVirtualKeyTable[index] : NoCode;
+    }
+
+    [[nodiscard]] constexpr std::uint16_t ToMacKeyCode(KeyCode key)
+    {
+        const auto index = static_cast<std::size_t>(key);
+        return index < ToMacKeyCodeTable.size() ? ToMacKeyCodeTable[index] : NoCode;
+    }
+
+    [[nodiscard]] constexpr std::uint16_t ToScancode(KeyCode key)
+    {
+        const auto index = static_cast<std::size_t>(key);
+        return index < ToScancodeTable.size() ? ToScancodeTable[index] : NoCode;
+    }
+
+    [[nodiscard]] constexpr std::uint32_t ToKeysym(KeyCode key)
+    {
+        const auto index = static_cast<std::size_t>(key);
+        return index < ToKeysymTable.size() ? ToKeysymTable[index] : NoKeysym;
+    }
+
+    // --- Name lookup ---
+    // A compile time "hash and displace" perfect hash over the key names. Names are matched case insensitively
+    // so config files can use "left shift" or "LEFT SHIFT".
+
+    constexpr char ToLower(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    constexpr bool EqualsIgnoreCase(std::string_view lhs, std::string_view rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (std::size_t i = 0; i < lhs.size(); i++)
+        {
+            if (ToLower(lhs[i]) != ToLower(rhs[i]))
+                return false;
+        }
+        return true;
+    }
+
+    constexpr std::uint32_t HashName(std::string_view name, std::uint32_t seed)
+    {
+        // FNV-1a
+        std::uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (char c : name)
+        {
+            hash ^= static_cast<std::uint8_t>(ToLower(c));
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    constexpr std::size_t NameBucketCount = 64;
+    constexpr std::size_t NameSlotCount = 256; // Must be a power of two
+
+    struct NameHash
+    {
+        std::array<std::uint16_t, NameBucketCount> Displacements{};
+        std::array<KeyCode, NameSlotCount> Slots{};
+    };
+
+    constexpr NameHash MakeNameHash()
+    {
+        NameHash result{};
+        std::array<bool, NameSlotCount> used{};
+
+        std::array<std::size_t, NameBucketCount> bucketSizes{};
+        for (const auto& entry : Entries)
+        {
+            if (!entry.Name.empty())
+                bucketSizes[HashName(entry.Name, 0) % NameBucketCount]++;
+        }
+
+        std::size_t largestBucket = 0;
+        for (auto size : bucketSizes)
+            largestBucket = size > largestBucket ? size : largestBucket;
+
+        // Place the largest buckets first while the table is still mostly empty
+        for (std::size_t size = largestBucket; size > 0; size--)
+        {
+            for (std::size_t bucket = 0; bucket < NameBucketCount; bucket++)
+            {
+                if (bucketSizes[bucket] != size)
+                    continue;
+
+                for (std::uint16_t displacement = 1; ; displacement++)
+                {
+                    std::array<std::size_t, NameSlotCount> placed{};
+                    std::size_t placedCount = 0;
+                    bool fits = true;
+                    for (const auto& entry : Entries)
+                    {
+                        if (entry.Name.empty() || HashName(entry.Name, 0) % NameBucketCount != bucket)
+                            continue;
+                        const std::size_t slot = HashName(entry.Name, displacement) & (NameSlotCount - 1);
+                        bool taken = used[slot];
+                        for (std::size_t i = 0; i < placedCount; i++)
+                            taken = taken || placed[i] == slot;
+                        if (taken)
+                        {
+                            fits = false;
+                            break;
+                        }
+                        placed[placedCount++] = slot;
+                    }
+
+                    if (!fits)
+                        continue;
+
+                    result.Displacements[bucket] = displacement;
+                    for (const auto& entry : Entries)
+                    {
+                        if (entry.Name.empty() || HashName(entry.Name, 0) % NameBucketCount != bucket)
+                            continue;
+                        const std::size_t slot = HashName(entry.Name, displacement) & (NameSlotCount - 1);
+                        used[slot] = true;
+                        result.Slots[slot] = entry.Key;
+                    }
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    inline constexpr NameHash NameLookup = MakeNameHash();
+
+    [[nodiscard]] constexpr KeyCode FromName(std::string_view name)
+    {
+        const auto displacement = NameLookup.Displacements[HashName(name, 0) % NameBucketCount];
+        const auto key = NameLookup.Slots[HashName(name, displacement) & (NameSlotCount - 1)];
+        return EqualsIgnoreCase(GetName(key), name) ? key : KeyCode::Unknown;
+    }
+}
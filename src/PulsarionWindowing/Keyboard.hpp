@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Core.hpp"
-#include <string>
+#include <string_view>
 
 namespace Pulsarion::Windowing
 {
@@ -148,5 +148,8 @@ namespace Pulsarion::Windowing
      */
     using Modifier = std::uint8_t;
 
-    PULSARION_WINDOWING_API std::string KeyCodeToString(KeyCode keyCode);
+    // Returns a view into static storage, never allocates
+    PULSARION_WINDOWING_API std::string_view KeyCodeToString(KeyCode keyCode);
+    // Inverse of KeyCodeToString, case insensitive. Returns KeyCode::Unknown for unknown names.
+    PULSARION_WINDOWING_API KeyCode StringToKeyCode(std::string_view name);
 };
@@ -0,0 +1,313 @@
+#pragma once
+
+#include "Window.hpp"
+#include "EventBus.hpp"
+#include "Clock.hpp"
+#include "CallbackProfiler.hpp"
+
+#include "PulsarionCore/Log.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Pulsarion::Windowing
+{
+    template<EventType Type>
+    using EventReturn = typename EventListenerTraits<EventCallback<Type>>::WindowReturn;
+
+    /*!
+     * @brief Stacks middleware layers on a window backend at compile time, e.g. Layered<NativeWindow, CoalesceLayer, ProfileLayer<>, LogLayer>.
+     * Events flow from the backend through the layers in the order given and then to the user's callback. A layer is a plain class with
+     * a static constexpr EventTypeFlags Events naming what it intercepts and an Intercept<Type>(next, userData, args...) member that
+     * passes the event on with next.template Dispatch<Type>(userData, args...), or doesn't to swallow it. A layer can also have an
+     * AfterPollEvents(next, userData) member, called after every PollEvents and WaitEvents, to flush what it held back.
+     * The callback of an event no layer intercepts is handed straight to the backend. The others get one forwarding callback on the
+     * backend, the layers are inlined into it, and the user's callback is called at the end of the chain. The forwarding callback is only
+     * installed while the user has a callback for the event, so the backend behaves the same with or without layers (Win32, for one,
+     * stops promoting pointer input to mouse messages once OnTouch is set). Layers only see the events the user handles.
+     * The backend is held by value, so with a final backend like NativeWindow every other call is direct.
+     */
+    template<typename Backend, typename... Layers>
+    requires std::derived_from<Backend, Window>
+    class Layered : public Window
+    {
+    public:
+        // Lets a layer pass events to the layers after it and the user's callback
+        template<std::size_t Index>
+        class Downstream
+        {
+        public:
+            explicit Downstream(Layered& layered) : m_Layered(layered) { }
+
+            template<EventType Type, typename... Args>
+            EventReturn<Type> Dispatch(void* userData, Args... args) { return m_Layered.template Run<Type, Index + 1>(userData, args...); }
+
+        private:
+            Layered& m_Layered;
+        };
+
+        template<EventType Type>
+        static constexpr bool Intercepted = (HasFlag(Layers::Events, Type) || ...);
+
+        explicit Layered(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config)
+            : m_Backend(std::move(title), bounds, styles, config)
+        {
+        }
+
+        ~Layered() override = default;
+
+        // The backend's callbacks point at us
+        Layered(const Layered&) = delete;
+        Layered& operator=(const Layered&) = delete;
+
+        template<typename Layer>
+        [[nodiscard]] Layer& GetLayer() { return std::get<Layer>(m_Layers); }
+        template<typename Layer>
+        [[nodiscard]] const Layer& GetLayer() const { return std::get<Layer>(m_Layers); }
+        [[nodiscard]] Backend& GetBackend() { return m_Backend; }
+        [[nodiscard]] const Backend& GetBackend() const { return m_Backend; }
+
+        void SetVisible(bool visible) override { m_Backend.SetVisible(visible); }
+        void PollEvents() override
+        {
+            m_Backend.PollEvents();
+            AfterPollEvents(std::index_sequence_for<Layers...>());
+        }
+        void WaitEvents(std::optional<std::chrono::nanoseconds> timeout) override
+        {
+            m_Backend.WaitEvents(timeout);
+            AfterPollEvents(std::index_sequence_for<Layers...>());
+        }
+        TimerId AddTimer(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat) override { return m_Backend.AddTimer(period, std::move(callback), repeat); }
+        void RemoveTimer(TimerId id) override { m_Backend.RemoveTimer(id); }
+        [[nodiscard]] bool ShouldClose() const override { return m_Backend.ShouldClose(); }
+        void SetShouldClose(bool shouldClose) override { m_Backend.SetShouldClose(shouldClose); }
+        void SetTitle(const std::string& title) override { m_Backend.SetTitle(title); }
+        void SetCursorMode(CursorMode mode) override { m_Backend.SetCursorMode(mode); }
+        void SetCursorShape(CursorShape shape) override { m_Backend.SetCursorShape(shape); }
+        void SetCursorImage(const ImageView& image, std::uint32_t hotspotX, std::uint32_t hotspotY) override { m_Backend.SetCursorImage(image, hotspotX, hotspotY); }
+        void SetIcon(std::span<const ImageView> images) override { m_Backend.SetIcon(images); }
+        void SetEventMask(EventTypeFlags mask) override { m_Backend.SetEventMask(mask); }
+        [[nodiscard]] EventTypeFlags GetEventMask() const override { return m_Backend.GetEventMask(); }
+        [[nodiscard]] std::uint64_t GetSizeGeneration() const override { return m_Backend.GetSizeGeneration(); }
+        [[nodiscard]] WindowSize GetContentSize() const override { return m_Backend.GetContentSize(); }
+        [[nodiscard]] DisplayTiming GetDisplayTiming() const override { return m_Backend.GetDisplayTiming(); }
+        void SetWatchdog(Watchdog* watchdog) override { m_Backend.SetWatchdog(watchdog); }
+        bool SetClipboard(std::vector<std::string> formats, ClipboardProvider&& provider) override { return m_Backend.SetClipboard(std::move(formats), std::move(provider)); }
+        void RequestClipboard(std::string format, ClipboardReceiver&& receiver) override { m_Backend.RequestClipboard(std::move(format), std::move(receiver)); }
+        [[nodiscard]] bool HasClipboardFormat(std::string_view format) const override { return m_Backend.HasClipboardFormat(format); }
+        [[nodiscard]] std::optional<std::string> GetTitle() const override { return m_Backend.GetTitle(); }
+        [[nodiscard]] std::string_view GetTitleView() const override { return m_Backend.GetTitleView(); }
+        [[nodiscard]] void* GetNativeWindow() const override { return m_Backend.GetNativeWindow(); }
+        void SetUserData(void* userData) override { m_Backend.SetUserData(userData); }
+        [[nodiscard]] void* GetUserData() const override { return m_Backend.GetUserData(); }
+
+        // ----- Window Event Callbacks -----
+        void SetOnClose(CloseCallback&& onClose) override { SetCallback<EventType::Close>(std::move(onClose)); }
+        [[nodiscard]] const CloseCallback& GetOnClose() const override { return GetCallback<EventType::Close>(); }
+        void SetOnWindowVisibility(VisibilityCallback&& onWindowVisibility) override { SetCallback<EventType::WindowVisibility>(std::move(onWindowVisibility)); }
+        [[nodiscard]] const VisibilityCallback& GetOnWindowVisibility() const override { return GetCallback<EventType::WindowVisibility>(); }
+        void SetOnFocus(FocusCallback&& onFocus) override { SetCallback<EventType::Focus>(std::move(onFocus)); }
+        [[nodiscard]] const FocusCallback& GetOnFocus() const override { return GetCallback<EventType::Focus>(); }
+        void SetOnResize(ResizeCallback&& onResize) override { SetCallback<EventType::Resize>(std::move(onResize)); }
+        [[nodiscard]] const ResizeCallback& GetOnResize() const override { return GetCallback<EventType::Resize>(); }
+        void SetOnMove(MoveCallback&& onMove) override { SetCallback<EventType::Move>(std::move(onMove)); }
+        [[nodiscard]] const MoveCallback& GetOnMove() const override { return GetCallback<EventType::Move>(); }
+        void SetBeforeResize(BeforeResizeCallback&& beforeResize) override { SetCallback<EventType::BeforeResize>(std::move(beforeResize)); }
+        [[nodiscard]] const BeforeResizeCallback& GetBeforeResize() const override { return GetCallback<EventType::BeforeResize>(); }
+        void SetAfterResize(AfterResizeCallback&& afterResize) override { SetCallback<EventType::AfterResize>(std::move(afterResize)); }
+        [[nodiscard]] const AfterResizeCallback& GetAfterResize() const override { return GetCallback<EventType::AfterResize>(); }
+        void SetOnMinimize(MinimizeCallback&& onMinimize) override { SetCallback<EventType::Minimize>(std::move(onMinimize)); }
+        [[nodiscard]] const MinimizeCallback& GetOnMinimize() const override { return GetCallback<EventType::Minimize>(); }
+        void SetOnMaximize(MaximizeCallback&& onMaximize) override { SetCallback<EventType::Maximize>(std::move(onMaximize)); }
+        [[nodiscard]] const MaximizeCallback& GetOnMaximize() const override { return GetCallback<EventType::Maximize>(); }
+        void SetOnFullscreen(FullscreenCallback&& onFullscreen) override { SetCallback<EventType::Fullscreen>(std::move(onFullscreen)); }
+        [[nodiscard]] const FullscreenCallback& GetOnFullscreen() const override { return GetCallback<EventType::Fullscreen>(); }
+        void SetOnRestore(RestoreCallback&& onRestore) override { SetCallback<EventType::Restore>(std::move(onRestore)); }
+        [[nodiscard]] const RestoreCallback& GetOnRestore() const override { return GetCallback<EventType::Restore>(); }
+        void SetOnOcclusion(OcclusionCallback&& onOcclusion) override { SetCallback<EventType::Occlusion>(std::move(onOcclusion)); }
+        [[nodiscard]] const OcclusionCallback& GetOnOcclusion() const override { return GetCallback<EventType::Occlusion>(); }
+
+        // ----- Mouse Event Callbacks -----
+        void SetOnMouseEnter(MouseEnterCallback&& onMouseEnter) override { SetCallback<EventType::MouseEnter>(std::move(onMouseEnter)); }
+        [[nodiscard]] const MouseEnterCallback& GetOnMouseEnter() const override { return GetCallback<EventType::MouseEnter>(); }
+        void SetOnMouseLeave(MouseLeaveCallback&& onMouseLeave) override { SetCallback<EventType::MouseLeave>(std::move(onMouseLeave)); }
+        [[nodiscard]] const MouseLeaveCallback& GetOnMouseLeave() const override { return GetCallback<EventType::MouseLeave>(); }
+        void SetOnMouseDown(MouseDownCallback&& onMouseDown) override { SetCallback<EventType::MouseDown>(std::move(onMouseDown)); }
+        [[nodiscard]] const MouseDownCallback& GetOnMouseDown() const override { return GetCallback<EventType::MouseDown>(); }
+        void SetOnMouseUp(MouseUpCallback&& onMouseUp) override { SetCallback<EventType::MouseUp>(std::move(onMouseUp)); }
+        [[nodiscard]] const MouseUpCallback& GetOnMouseUp() const override { return GetCallback<EventType::MouseUp>(); }
+        void SetOnMouseMove(MouseMoveCallback&& onMouseMove) override { SetCallback<EventType::MouseMove>(std::move(onMouseMove)); }
+        [[nodiscard]] const MouseMoveCallback& GetOnMouseMove() const override { return GetCallback<EventType::MouseMove>(); }
+        void SetOnMouseWheel(MouseWheelCallback&& onMouseWheel) override { SetCallback<EventType::MouseWheel>(std::move(onMouseWheel)); }
+        [[nodiscard]] const MouseWheelCallback& GetOnMouseWheel() const override { return GetCallback<EventType::MouseWheel>(); }
+        void SetOnRawMouseMove(RawMouseMoveCallback&& onRawMouseMove) override { SetCallback<EventType::RawMouseMove>(std::move(onRawMouseMove)); }
+        [[nodiscard]] const RawMouseMoveCallback& GetOnRawMouseMove() const override { return GetCallback<EventType::RawMouseMove>(); }
+        void SetOnTouch(TouchCallback&& onTouch) override { SetCallback<EventType::Touch>(std::move(onTouch)); }
+        [[nodiscard]] const TouchCallback& GetOnTouch() const override { return GetCallback<EventType::Touch>(); }
+
+        // ----- Keyboard Event Callbacks -----
+        void SetOnKeyDown(KeyDownCallback&& onKeyDown) override { SetCallback<EventType::KeyDown>(std::move(onKeyDown)); }
+        [[nodiscard]] const KeyDownCallback& GetOnKeyDown() const override { return GetCallback<EventType::KeyDown>(); }
+        void SetOnKeyUp(KeyUpCallback&& onKeyUp) override { SetCallback<EventType::KeyUp>(std::move(onKeyUp)); }
+        [[nodiscard]] const KeyUpCallback& GetOnKeyUp() const override { return GetCallback<EventType::KeyUp>(); }
+        void SetOnKeyTyped(KeyTypedCallback&& onKeyTyped) override { SetCallback<EventType::KeyTyped>(std::move(onKeyTyped)); }
+        [[nodiscard]] const KeyTypedCallback& GetOnKeyTyped() const override { return GetCallback<EventType::KeyTyped>(); }
+        void SetOnTextInput(TextInputCallback&& onTextInput) override { SetCallback<EventType::TextInput>(std::move(onTextInput)); }
+        [[nodiscard]] const TextInputCallback& GetOnTextInput() const override { return GetCallback<EventType::TextInput>(); }
+
+        #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
+        void LimitEvents(bool limitEvents) override { m_Backend.LimitEvents(limitEvents); }
+        [[nodiscard]] bool IsLimitingEvents() const override { return m_Backend.IsLimitingEvents(); }
+        #endif
+
+    private:
+        template<EventType Type>
+        static constexpr std::size_t Slot = static_cast<std::size_t>(Type);
+
+        template<EventType Type>
+        void SetCallback(EventCallback<Type>&& callback)
+        {
+            if constexpr (Intercepted<Type>)
+            {
+                auto& slot = std::get<Slot<Type>>(m_Callbacks);
+                slot = std::move(callback);
+                constexpr std::uint32_t bit = 1u << static_cast<std::uint32_t>(Type);
+                if (slot && (m_Installed & bit) == 0)
+                    SetWindowCallback<Type>(m_Backend, [this](void* userData, auto... args) -> EventReturn<Type> { return Run<Type, 0>(userData, args...); });
+                else if (!slot && (m_Installed & bit) != 0)
+                    SetWindowCallback<Type>(m_Backend, nullptr);
+                m_Installed = slot ? m_Installed | bit : m_Installed & ~bit;
+            }
+            else
+            {
+                SetWindowCallback<Type>(m_Backend, std::move(callback));
+            }
+        }
+
+        template<EventType Type>
+        [[nodiscard]] const EventCallback<Type>& GetCallback() const
+        {
+            if constexpr (Intercepted<Type>)
+                return std::get<Slot<Type>>(m_Callbacks);
+            else
+                return GetWindowCallback<Type>(m_Backend);
+        }
+
+        // Layers that don't intercept the event are skipped at compile time
+        template<EventType Type, std::size_t Index, typename... Args>
+        EventReturn<Type> Run(void* userData, Args... args)
+        {
+            if constexpr (Index == sizeof...(Layers))
+            {
+                const auto& callback = std::get<Slot<Type>>(m_Callbacks);
+                if constexpr (std::is_same_v<EventReturn<Type>, bool>)
+                    return callback ? callback(userData, args...) : true; // Without a close callback the window closes
+                else if (callback)
+                    callback(userData, args...);
+            }
+            else if constexpr (!HasFlag(std::tuple_element_t<Index, std::tuple<Layers...>>::Events, Type))
+            {
+                return Run<Type, Index + 1>(userData, args...);
+            }
+            else
+            {
+                Downstream<Index> next(*this);
+                return std::get<Index>(m_Layers).template Intercept<Type>(next, userData, args...);
+            }
+        }
+
+        template<std::size_t... Indices>
+        void AfterPollEvents(std::index_sequence<Indices...>)
+        {
+            ([this]
+            {
+                auto& layer = std::get<Indices>(m_Layers);
+                Downstream<Indices> next(*this);
+                if constexpr (requires { layer.AfterPollEvents(next, GetUserData()); })
+                    layer.AfterPollEvents(next, GetUserData());
+            }(), ...);
+        }
+
+        Backend m_Backend;
+        std::tuple<Layers...> m_Layers;
+        EventCallbacks m_Callbacks; // The user's callbacks of the intercepted events, the others live in the backend
+        std::uint32_t m_Installed = 0; // One bit per EventType that has a forwarding callback on the backend
+    };
+
+    // Traces every event that reaches it, like DebugOptions::LogEvents without the arguments
+    struct LogLayer
+    {
+        static constexpr EventTypeFlags Events = EventTypeFlags::All;
+
+        template<EventType Type, typename Next, typename... Args>
+        EventReturn<Type> Intercept(Next& next, void* userData, Args... args)
+        {
+            PULSARION_LOG_TRACE("[LogLayer] {0} event", EventTypeToString(Type));
+            return next.template Dispatch<Type>(userData, args...);
+        }
+    };
+
+    // Times everything after it in the stack, so put it last to time only the user's callbacks
+    template<Clock ClockType = SteadyClock>
+    class ProfileLayer
+    {
+    public:
+        static constexpr EventTypeFlags Events = EventTypeFlags::All;
+
+        template<EventType Type, typename Next, typename... Args>
+        EventReturn<Type> Intercept(Next& next, void* userData, Args... args)
+        {
+            const auto scope = m_Profiler.Measure(Type);
+            return next.template Dispatch<Type>(userData, args...);
+        }
+
+        [[nodiscard]] BasicCallbackProfiler<ClockType>& GetProfiler() { return m_Profiler; }
+        [[nodiscard]] const BasicCallbackProfiler<ClockType>& GetProfiler() const { return m_Profiler; }
+
+    private:
+        BasicCallbackProfiler<ClockType> m_Profiler;
+    };
+
+    // Passes on only the last mouse move of each poll. The other pointer events (enter, leave, buttons, wheel and touch) first flush
+    // the pending move, so they stay in order with it. Window and keyboard events may overtake the move.
+    class CoalesceLayer
+    {
+    public:
+        static constexpr EventTypeFlags Events = EventType::MouseMove | EventType::MouseEnter | EventType::MouseLeave | EventType::MouseDown
+            | EventType::MouseUp | EventType::MouseWheel | EventType::Touch;
+
+        template<EventType Type, typename Next, typename... Args>
+        void Intercept(Next& next, void* userData, Args... args)
+        {
+            if constexpr (Type == EventType::MouseMove)
+            {
+                m_Pending.emplace(args...);
+            }
+            else
+            {
+                Flush(next, userData);
+                next.template Dispatch<Type>(userData, args...);
+            }
+        }
+
+        template<typename Next>
+        void AfterPollEvents(Next& next, void* userData) { Flush(next, userData); }
+
+    private:
+        template<typename Next>
+        void Flush(Next& next, void* userData)
+        {
+            if (m_Pending)
+                next.template Dispatch<EventType::MouseMove>(userData, *std::exchange(m_Pending, std::nullopt));
+        }
+
+        std::optional<Point> m_Pending;
+    };
+}
@@ -0,0 +1,246 @@
+#include "../EventLoop.hpp"
+#include "../Window.hpp"
+
+#include "PulsarionCore/Log.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace Pulsarion::Windowing
+{
+    IoEvents operator|(IoEvents lhs, IoEvents rhs)
+    {
+        return static_cast<IoEvents>(static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs));
+    }
+    IoEvents operator&(IoEvents lhs, IoEvents rhs)
+    {
+        return static_cast<IoEvents>(static_cast<std::uint32_t>(lhs) & static_cast<std::uint32_t>(rhs));
+    }
+
+    bool HasFlag(const IoEvents& flags, const IoEvents& flag)
+    {
+        return (static_cast<std::underlying_type_t<IoEvents>>(flags) & static_cast<std::underlying_type_t<IoEvents>>(flag)) != 0;
+    }
+
+    struct EventLoop::Source
+    {
+        int Fd;
+        bool Active;
+        IoCallback Callback;
+        void* UserData;
+    };
+
+    static std::uint32_t ToEpoll(IoEvents events)
+    {
+        std::uint32_t result = 0;
+        if (HasFlag(events, IoEvents::Readable))
+            result |= EPOLLIN;
+        if (HasFlag(events, IoEvents::Writable))
+            result |= EPOLLOUT;
+        return result;
+    }
+
+    static IoEvents FromEpoll(std::uint32_t events)
+    {
+        IoEvents result = IoEvents::None;
+        if (events & EPOLLIN)
+            result = result | IoEvents::Readable;
+        if (events & EPOLLOUT)
+            result = result | IoEvents::Writable;
+        if (events & EPOLLERR)
+            result = result | IoEvents::Error;
+        if (events & (EPOLLHUP | EPOLLRDHUP))
+            result = result | IoEvents::HangUp;
+        return result;
+    }
+
+    EventLoop::EventLoop(DispatchOrder order)
+        : m_Epoll(epoll_create1(EPOLL_CLOEXEC)), m_WakeupFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), m_TimerFd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)), m_Order(order), m_ReadyEvents(32)
+    {
+        if (m_Epoll < 0 || m_WakeupFd < 0 || m_TimerFd < 0)
+        {
+            PULSARION_LOG_ERROR("Failed to create the event loop: {0}", std::strerror(errno));
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr; // The only source without a Source
+        epoll_ctl(m_Epoll, EPOLL_CTL_ADD, m_WakeupFd, &event);
+
+        AddSource(m_TimerFd, IoEvents::Readable, [](void* data, int fd, IoEvents)
+        {
+            auto* loop = static_cast<EventLoop*>(data);
+            std::uint64_t expirations;
+            [[maybe_unused]] const auto read = ::read(fd, &expirations, sizeof(expirations));
+            loop->m_Timers.Dispatch(loop->m_UserData);
+            loop->ArmTimerFd();
+        }, this);
+    }
+
+    EventLoop::~EventLoop()
+    {
+        if (m_TimerFd >= 0)
+            close(m_TimerFd);
+        if (m_WakeupFd >= 0)
+            close(m_WakeupFd);
+        if (m_Epoll >= 0)
+            close(m_Epoll);
+    }
+
+    bool EventLoop::AddSource(int fd, IoEvents events, IoCallback&& callback, void* userData)
+    {
+        if (fd < 0)
+            return false;
+        if (static_cast<std::size_t>(fd) >= m_Sources.size())
+            m_Sources.resize(static_cast<std::size_t>(fd) + 1);
+        if (m_Sources[fd])
+            return false;
+
+        auto source = std::make_unique<Source>(Source { fd, true, std::move(callback), userData });
+        epoll_event event{};
+        event.events = ToEpoll(events);
+        event.data.ptr = source.get();
+        if (epoll_ctl(m_Epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            PULSARION_LOG_WARN("Failed to add fd {0} to the event loop: {1}", fd, std::strerror(errno));
+            return false;
+        }
+
+        m_Sources[fd] = std::move(source);
+        return true;
+    }
+
+    bool EventLoop::ModifySource(int fd, IoEvents events)
+    {
+        if (fd < 0 || static_cast<std::size_t>(fd) >= m_Sources.size() || !m_Sources[fd])
+            return false;
+
+        epoll_event event{};
+        event.events = ToEpoll(events);
+        event.data.ptr = m_Sources[fd].get();
+        return epoll_ctl(m_Epoll, EPOLL_CTL_MOD, fd, &event) == 0;
+    }
+
+    void EventLoop::RemoveSource(int fd)
+    {
+        if (fd < 0 || static_cast<std::size_t>(fd) >= m_Sources.size() || !m_Sources[fd])
+            return;
+
+        epoll_ctl(m_Epoll, EPOLL_CTL_DEL, fd, nullptr);
+        m_Sources[fd]->Active = false;
+        if (m_Dispatching)
+            m_Removed.push_back(std::move(m_Sources[fd])); // The callback may be running, or still pending in this batch
+        else
+            m_Sources[fd].reset();
+    }
+
+    TimerId EventLoop::AddTimer(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat)
+    {
+        const TimerId id = m_Timers.Add(period, std::move(callback), repeat);
+        ArmTimerFd();
+        return id;
+    }
+
+    void EventLoop::RemoveTimer(TimerId id)
+    {
+        m_Timers.Remove(id);
+        ArmTimerFd();
+    }
+
+    void EventLoop::ArmTimerFd()
+    {
+        itimerspec spec{}; // All zero disarms the timer
+        if (const auto deadline = m_Timers.GetNextDeadline())
+        {
+            // steady_clock is CLOCK_MONOTONIC, so the deadline can be armed as an absolute time without drift
+            const auto sinceEpoch = std::max(std::chrono::nanoseconds(1), std::chrono::duration_cast<std::chrono::nanoseconds>(deadline->time_since_epoch()));
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+            spec.it_value.tv_sec = static_cast<time_t>(seconds.count());
+            spec.it_value.tv_nsec = static_cast<long>((sinceEpoch - seconds).count());
+        }
+        timerfd_settime(m_TimerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    std::size_t EventLoop::RunOnce(std::optional<std::chrono::nanoseconds> timeout)
+    {
+        std::size_t dispatched = 0;
+        if (m_Window != nullptr && m_Order == DispatchOrder::WindowFirst)
+            m_Window->PollEvents();
+
+        dispatched = DispatchSources(timeout);
+
+        if (m_Window != nullptr && m_Order == DispatchOrder::SourcesFirst)
+            m_Window->PollEvents();
+        return dispatched;
+    }
+
+    void EventLoop::Run()
+    {
+        m_Stopped = false;
+        while (!m_Stopped && (m_Window == nullptr || !m_Window->ShouldClose()))
+            RunOnce();
+    }
+
+    void EventLoop::Stop()
+    {
+        m_Stopped = true;
+        Wakeup();
+    }
+
+    void EventLoop::Wakeup()
+    {
+        const std::uint64_t value = 1;
+        // EAGAIN means the counter is saturated, the loop is already going to wake up
+        [[maybe_unused]] const auto written = write(m_WakeupFd, &value, sizeof(value));
+    }
+
+    std::size_t EventLoop::DispatchSources(std::optional<std::chrono::nanoseconds> timeout)
+    {
+        int timeoutMs = -1;
+        if (timeout.has_value())
+        {
+            // Round up, waking up early would just cost another iteration
+            const auto ms = std::chrono::ceil<std::chrono::milliseconds>(*timeout).count();
+            timeoutMs = static_cast<int>(std::clamp<std::int64_t>(ms, 0, std::numeric_limits<int>::max()));
+        }
+
+        const int count = epoll_wait(m_Epoll, m_ReadyEvents.data(), static_cast<int>(m_ReadyEvents.size()), timeoutMs);
+        if (count <= 0)
+            return 0; // Timeout or EINTR
+
+        std::size_t dispatched = 0;
+        m_Dispatching = true;
+        for (int i = 0; i < count; i++)
+        {
+            const auto& event = m_ReadyEvents[i];
+            auto* source = static_cast<Source*>(event.data.ptr);
+            if (source == nullptr)
+            {
+                std::uint64_t value;
+                [[maybe_unused]] const auto read = ::read(m_WakeupFd, &value, sizeof(value));
+                continue;
+            }
+
+            if (!source->Active)
+                continue;
+            source->Callback(source->UserData, source->Fd, FromEpoll(event.events));
+            dispatched++;
+        }
+        m_Dispatching = false;
+        m_Removed.clear();
+
+        // Grow when the batch was full so busy loops don't starve the sources at the end of the ready list
+        if (static_cast<std::size_t>(count) == m_ReadyEvents.size())
+            m_ReadyEvents.resize(m_ReadyEvents.size() * 2);
+        return dispatched;
+    }
+}
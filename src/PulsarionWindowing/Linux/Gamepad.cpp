@@ -0,0 +1,493 @@
+#include "../Gamepad.hpp"
+
+#include <linux/input.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    constexpr const char* InputDirectory = "/dev/input";
+    constexpr std::size_t AxisCount = static_cast<std::size_t>(GamepadAxis::Count);
+    constexpr std::size_t LongBits = sizeof(unsigned long) * 8;
+
+    // BTN_GAMEPAD (0x130) .. BTN_THUMBR (0x13e), GamepadButton::Count marks codes we don't map
+    constexpr std::array<GamepadButton, BTN_THUMBR - BTN_GAMEPAD + 1> GamepadButtonTable = {
+        GamepadButton::South,       // BTN_SOUTH
+        GamepadButton::East,        // BTN_EAST
+        GamepadButton::Count,       // BTN_C
+        GamepadButton::North,       // BTN_NORTH
+        GamepadButton::West,        // BTN_WEST
+        GamepadButton::Count,       // BTN_Z
+        GamepadButton::LeftBumper,  // BTN_TL
+        GamepadButton::RightBumper, // BTN_TR
+        GamepadButton::Count,       // BTN_TL2, reported as the trigger axis
+        GamepadButton::Count,       // BTN_TR2
+        GamepadButton::Back,        // BTN_SELECT
+        GamepadButton::Start,       // BTN_START
+        GamepadButton::Guide,       // BTN_MODE
+        GamepadButton::LeftThumb,   // BTN_THUMBL
+        GamepadButton::RightThumb,  // BTN_THUMBR
+    };
+
+    // BTN_DPAD_UP (0x220) .. BTN_DPAD_RIGHT (0x223)
+    constexpr std::array<GamepadButton, 4> DPadButtonTable = {
+        GamepadButton::DPadUp, GamepadButton::DPadDown, GamepadButton::DPadLeft, GamepadButton::DPadRight,
+    };
+
+    // ABS_X (0x00) .. ABS_RZ (0x05)
+    constexpr std::array<GamepadAxis, ABS_RZ + 1> AxisTable = {
+        GamepadAxis::LeftX, GamepadAxis::LeftY, GamepadAxis::LeftTrigger, GamepadAxis::RightX, GamepadAxis::RightY, GamepadAxis::RightTrigger,
+    };
+
+    static constexpr std::uint32_t ButtonBit(GamepadButton button)
+    {
+        return 1u << static_cast<std::uint32_t>(button);
+    }
+
+    static constexpr bool IsTrigger(GamepadAxis axis)
+    {
+        return axis == GamepadAxis::LeftTrigger || axis == GamepadAxis::RightTrigger;
+    }
+
+    static bool TestBit(const unsigned long* bits, std::size_t bit)
+    {
+        return (bits[bit / LongBits] >> (bit % LongBits)) & 1ul;
+    }
+
+    struct GamepadDevice
+    {
+        int Fd = -1;
+        std::string Path;
+        std::string Name;
+        std::array<input_absinfo, ABS_HAT0Y + 1> AbsInfo{};
+        bool Dropped = false; // The kernel buffer overflowed, ignore events until the next SYN_REPORT and resync
+
+        // Updated by every event, published to the GamepadState at SYN_REPORT so half applied frames are never visible
+        std::uint32_t PendingButtons = 0;
+        std::array<float, AxisCount> PendingAxes{};
+        std::int32_t HatX = 0;
+        std::int32_t HatY = 0;
+        std::uint32_t Buttons = 0;
+        std::array<float, AxisCount> Axes{};
+
+        // Recordings are loaded once and advanced one frame per Poll
+        bool IsRecording = false;
+        std::vector<input_event> Recording;
+        std::size_t RecordingPosition = 0;
+    };
+
+    class GamepadManager::Impl
+    {
+    public:
+        explicit Impl(const GamepadConfig& config)
+            : m_Config(config)
+        {
+            if (m_Config.WatchHotplug)
+            {
+                m_Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                if (m_Inotify >= 0 && inotify_add_watch(m_Inotify, InputDirectory, IN_CREATE | IN_ATTRIB | IN_DELETE) < 0)
+                {
+                    close(m_Inotify);
+                    m_Inotify = -1;
+                }
+            }
+
+            DIR* directory = opendir(InputDirectory);
+            if (directory == nullptr)
+                return;
+            while (const dirent* entry = readdir(directory))
+            {
+                if (std::strncmp(entry->d_name, "event", 5) == 0)
+                    TryOpen(std::string(InputDirectory) + "/" + entry->d_name);
+            }
+            closedir(directory);
+        }
+
+        ~Impl()
+        {
+            for (auto& device : m_Devices)
+                Disconnect(device, m_States[&device - m_Devices.data()]);
+            if (m_Inotify >= 0)
+                close(m_Inotify);
+        }
+
+        void Poll()
+        {
+            if (m_Inotify >= 0)
+                ProcessHotplug();
+
+            for (std::size_t i = 0; i < MaxGamepads; i++)
+            {
+                auto& device = m_Devices[i];
+                auto& state = m_States[i];
+                const std::uint32_t previous = state.Buttons;
+
+                if (device.IsRecording)
+                    ReadRecording(device);
+                else if (device.Fd >= 0)
+                    ReadDevice(device, state);
+
+                Publish(device, state);
+                state.Pressed = state.Buttons & ~previous;
+                state.Released = previous & ~state.Buttons;
+            }
+        }
+
+        std::size_t OpenRecording(const std::string& path)
+        {
+            const auto slot = FindFreeSlot();
+            if (slot == MaxGamepads)
+                return MaxGamepads;
+
+            std::FILE* file = std::fopen(path.c_str(), "rb");
+            if (file == nullptr)
+                return MaxGamepads;
+
+            auto& device = m_Devices[slot];
+            input_event event{};
+            while (std::fread(&event, sizeof(event), 1, file) == 1)
+                device.Recording.push_back(event);
+            std::fclose(file);
+
+            device.IsRecording = true;
+            device.Path = path;
+            device.Name = "Recording";
+            // We can't query a file, so assume the ranges the xpad driver reports
+            for (std::size_t axis = 0; axis < device.AbsInfo.size(); axis++)
+            {
+                device.AbsInfo[axis].minimum = -32768;
+                device.AbsInfo[axis].maximum = 32767;
+            }
+            for (const auto trigger : { ABS_Z, ABS_RZ })
+            {
+                device.AbsInfo[trigger].minimum = 0;
+                device.AbsInfo[trigger].maximum = 255;
+            }
+            for (const auto hat : { ABS_HAT0X, ABS_HAT0Y })
+            {
+                device.AbsInfo[hat].minimum = -1;
+                device.AbsInfo[hat].maximum = 1;
+            }
+            m_States[slot].Connected = true;
+            return slot;
+        }
+
+        std::array<GamepadDevice, MaxGamepads> m_Devices{};
+        std::array<GamepadState, MaxGamepads> m_States{};
+
+    private:
+        std::size_t FindFreeSlot() const
+        {
+            for (std::size_t i = 0; i < MaxGamepads; i++)
+            {
+                if (m_Devices[i].Fd < 0 && !m_Devices[i].IsRecording)
+                    return i;
+            }
+            return MaxGamepads;
+        }
+
+        void TryOpen(const std::string& path)
+        {
+            for (const auto& device : m_Devices)
+            {
+                if (device.Fd >= 0 && device.Path == path)
+                    return;
+            }
+
+            const auto slot = FindFreeSlot();
+            if (slot == MaxGamepads)
+                return;
+
+            const int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+            if (fd < 0)
+                return; // Usually not readable yet, udev fixes the permissions and we get IN_ATTRIB
+
+            unsigned long keyBits[(KEY_MAX + LongBits) / LongBits] = {};
+            unsigned long absBits[(ABS_MAX + LongBits) / LongBits] = {};
+            if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0 || ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0
+                || (!TestBit(keyBits, BTN_GAMEPAD) && !TestBit(keyBits, BTN_JOYSTICK)))
+            {
+                close(fd);
+                return;
+            }
+
+            auto& device = m_Devices[slot];
+            device = GamepadDevice{};
+            device.Fd = fd;
+            device.Path = path;
+
+            char name[256] = {};
+            if (ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name) >= 0)
+                device.Name = name;
+
+            for (std::size_t axis = 0; axis < device.AbsInfo.size(); axis++)
+            {
+                if (TestBit(absBits, axis))
+                    ioctl(fd, EVIOCGABS(axis), &device.AbsInfo[axis]);
+            }
+
+            Resync(device);
+            m_States[slot] = GamepadState{};
+            m_States[slot].Connected = true;
+        }
+
+        void Disconnect(GamepadDevice& device, GamepadState& state)
+        {
+            if (device.Fd >= 0)
+                close(device.Fd);
+            device = GamepadDevice{};
+            state = GamepadState{};
+        }
+
+        void ProcessHotplug()
+        {
+            alignas(inotify_event) char buffer[4096];
+            for (;;)
+            {
+                const ssize_t bytes = read(m_Inotify, buffer, sizeof(buffer));
+                if (bytes <= 0)
+                    break;
+
+                for (ssize_t offset = 0; offset < bytes;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                    if (event->len == 0 || std::strncmp(event->name, "event", 5) != 0)
+                        continue;
+
+                    const std::string path = std::string(InputDirectory) + "/" + event->name;
+                    if (event->mask & IN_DELETE)
+                    {
+                        for (std::size_t i = 0; i < MaxGamepads; i++)
+                        {
+                            if (m_Devices[i].Fd >= 0 && m_Devices[i].Path == path)
+                                Disconnect(m_Devices[i], m_States[i]);
+                        }
+                    }
+                    else
+                    {
+                        TryOpen(path);
+                    }
+                }
+            }
+        }
+
+        void ReadDevice(GamepadDevice& device, GamepadState& state)
+        {
+            for (;;)
+            {
+                const ssize_t bytes = read(device.Fd, m_Events.data(), sizeof(m_Events));
+                if (bytes < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    if (errno != EAGAIN)
+                        Disconnect(device, state); // ENODEV when the controller is unplugged
+                    return;
+                }
+
+                const auto count = static_cast<std::size_t>(bytes) / sizeof(input_event);
+                for (std::size_t i = 0; i < count; i++)
+                    Process(device, m_Events[i]);
+
+                if (count < m_Events.size())
+                    return; // Drained
+            }
+        }
+
+        void ReadRecording(GamepadDevice& device)
+        {
+            while (device.RecordingPosition < device.Recording.size())
+            {
+                const auto& event = device.Recording[device.RecordingPosition++];
+                Process(device, event);
+                if (event.type == EV_SYN && event.code == SYN_REPORT)
+                    return;
+            }
+        }
+
+        void Process(GamepadDevice& device, const input_event& event)
+        {
+            if (event.type == EV_SYN)
+            {
+                if (event.code == SYN_DROPPED)
+                {
+                    device.Dropped = true;
+                }
+                else if (event.code == SYN_REPORT)
+                {
+                    if (device.Dropped)
+                        Resync(device);
+                    device.Buttons = device.PendingButtons;
+                    device.Axes = device.PendingAxes;
+                }
+                return;
+            }
+
+            if (device.Dropped)
+                return;
+
+            if (event.type == EV_KEY)
+            {
+                GamepadButton button = GamepadButton::Count;
+                if (event.code >= BTN_GAMEPAD && event.code <= BTN_THUMBR)
+                    button = GamepadButtonTable[event.code - BTN_GAMEPAD];
+                else if (event.code >= BTN_DPAD_UP && event.code <= BTN_DPAD_RIGHT)
+                    button = DPadButtonTable[event.code - BTN_DPAD_UP];
+                if (button == GamepadButton::Count)
+                    return;
+
+                if (event.value != 0)
+                    device.PendingButtons |= ButtonBit(button);
+                else
+                    device.PendingButtons &= ~ButtonBit(button);
+            }
+            else if (event.type == EV_ABS)
+            {
+                SetAbs(device, event.code, event.value);
+            }
+        }
+
+        static void SetAbs(GamepadDevice& device, std::uint16_t code, std::int32_t value)
+        {
+            if (code < AxisTable.size())
+            {
+                const auto axis = AxisTable[code];
+                const auto& info = device.AbsInfo[code];
+                const float range = static_cast<float>(info.maximum - info.minimum);
+                const float normalized = range > 0.0f ? static_cast<float>(value - info.minimum) / range : 0.0f;
+                device.PendingAxes[static_cast<std::size_t>(axis)] = IsTrigger(axis) ? normalized : normalized * 2.0f - 1.0f;
+            }
+            else if (code == ABS_HAT0X || code == ABS_HAT0Y)
+            {
+                (code == ABS_HAT0X ? device.HatX : device.HatY) = value;
+                constexpr std::uint32_t hatMask = ButtonBit(GamepadButton::DPadUp) | ButtonBit(GamepadButton::DPadDown) | ButtonBit(GamepadButton::DPadLeft) | ButtonBit(GamepadButton::DPadRight);
+                device.PendingButtons &= ~hatMask;
+                if (device.HatY < 0)
+                    device.PendingButtons |= ButtonBit(GamepadButton::DPadUp);
+                if (device.HatY > 0)
+                    device.PendingButtons |= ButtonBit(GamepadButton::DPadDown);
+                if (device.HatX < 0)
+                    device.PendingButtons |= ButtonBit(GamepadButton::DPadLeft);
+                if (device.HatX > 0)
+                    device.PendingButtons |= ButtonBit(GamepadButton::DPadRight);
+            }
+        }
+
+        // Reads the current state straight from the driver, used on connect and after the kernel dropped events
+        static void Resync(GamepadDevice& device)
+        {
+            device.Dropped = false;
+            if (device.IsRecording)
+                return;
+
+            unsigned long keyState[(KEY_MAX + LongBits) / LongBits] = {};
+            if (ioctl(device.Fd, EVIOCGKEY(sizeof(keyState)), keyState) >= 0)
+            {
+                device.PendingButtons = 0;
+                for (std::uint16_t code = BTN_GAMEPAD; code <= BTN_THUMBR; code++)
+                {
+                    const auto button = GamepadButtonTable[code - BTN_GAMEPAD];
+                    if (button != GamepadButton::Count && TestBit(keyState, code))
+                        device.PendingButtons |= ButtonBit(button);
+                }
+                for (std::uint16_t code = BTN_DPAD_UP; code <= BTN_DPAD_RIGHT; code++)
+                {
+                    if (TestBit(keyState, code))
+                        device.PendingButtons |= ButtonBit(DPadButtonTable[code - BTN_DPAD_UP]);
+                }
+            }
+
+            for (std::uint16_t code = 0; code < device.AbsInfo.size(); code++)
+            {
+                if (ioctl(device.Fd, EVIOCGABS(code), &device.AbsInfo[code]) >= 0)
+                    SetAbs(device, code, device.AbsInfo[code].value);
+            }
+            device.Buttons = device.PendingButtons;
+            device.Axes = device.PendingAxes;
+        }
+
+        void Publish(const GamepadDevice& device, GamepadState& state) const
+        {
+            if (!state.Connected)
+                return;
+
+            state.Buttons = device.Buttons;
+            state.Axes = device.Axes;
+
+            auto applyStick = [this](float& x, float& y)
+            {
+                const float magnitude = std::sqrt(x * x + y * y);
+                if (magnitude <= m_Config.StickDeadzone)
+                {
+                    x = 0.0f;
+                    y = 0.0f;
+                    return;
+                }
+                const float scale = (std::min(magnitude, 1.0f) - m_Config.StickDeadzone) / (1.0f - m_Config.StickDeadzone) / magnitude;
+                x *= scale;
+                y *= scale;
+            };
+            auto applyTrigger = [this](float& value)
+            {
+                value = value <= m_Config.TriggerDeadzone ? 0.0f : (value - m_Config.TriggerDeadzone) / (1.0f - m_Config.TriggerDeadzone);
+            };
+
+            auto& axes = state.Axes;
+            applyStick(axes[static_cast<std::size_t>(GamepadAxis::LeftX)], axes[static_cast<std::size_t>(GamepadAxis::LeftY)]);
+            applyStick(axes[static_cast<std::size_t>(GamepadAxis::RightX)], axes[static_cast<std::size_t>(GamepadAxis::RightY)]);
+            applyTrigger(axes[static_cast<std::size_t>(GamepadAxis::LeftTrigger)]);
+            applyTrigger(axes[static_cast<std::size_t>(GamepadAxis::RightTrigger)]);
+        }
+
+        GamepadConfig m_Config;
+        int m_Inotify = -1;
+        std::array<input_event, 64> m_Events{}; // Shared read buffer, one read() drains up to 64 events
+    };
+
+    GamepadManager::GamepadManager(const GamepadConfig& config)
+        : m_Impl(new Impl(config))
+    {
+    }
+
+    GamepadManager::~GamepadManager()
+    {
+        delete m_Impl;
+    }
+
+    void GamepadManager::Poll()
+    {
+        m_Impl->Poll();
+    }
+
+    const GamepadState& GamepadManager::GetState(std::size_t index) const
+    {
+        static const GamepadState disconnected{};
+        return index < MaxGamepads ? m_Impl->m_States[index] : disconnected;
+    }
+
+    std::string_view GamepadManager::GetName(std::size_t index) const
+    {
+        return index < MaxGamepads ? std::string_view(m_Impl->m_Devices[index].Name) : std::string_view();
+    }
+
+    std::size_t GamepadManager::GetConnectedCount() const
+    {
+        return static_cast<std::size_t>(std::count_if(m_Impl->m_States.begin(), m_Impl->m_States.end(), [](const GamepadState& state) { return state.Connected; }));
+    }
+
+    std::size_t GamepadManager::OpenRecording(const std::string& path)
+    {
+        return m_Impl->OpenRecording(path);
+    }
+}
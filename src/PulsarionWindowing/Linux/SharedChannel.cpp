@@ -0,0 +1,615 @@
+#include "../SharedChannel.hpp"
+
+#include "PulsarionCore/Log.hpp"
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <string_view>
+
+namespace Pulsarion::Windowing
+{
+    static constexpr std::uint32_t ChannelMagic = 0x50574348; // "PWCH"
+    static constexpr std::uint32_t ChannelVersion = 1;
+    static constexpr std::uint8_t FreshBit = 0x4;
+    static constexpr std::size_t PageSize = 4096;
+
+    struct SharedFrameInfo
+    {
+        std::uint32_t Width;
+        std::uint32_t Height;
+        std::uint64_t Sequence;
+    };
+
+    // Written once by the host, then only the atomics change. Each side's counters get their own cache line.
+    struct SharedChannel::Header
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint32_t EventCapacity;
+        std::uint32_t MaxWidth;
+        std::uint32_t MaxHeight;
+
+        alignas(64) std::atomic<std::uint64_t> EventWrite; // Host
+        alignas(64) std::atomic<std::uint64_t> EventRead; // Client
+        alignas(64) std::atomic<std::uint8_t> FrameShared; // The TripleBuffer protocol, the index of the shared framebuffer and FreshBit
+        SharedFrameInfo Frames[3]; // Written by the client before the framebuffer is published
+        alignas(64) std::atomic<std::uint64_t> ClientHeartbeat;
+        std::atomic<std::uint32_t> CloseRequested;
+    };
+    // The atomics are shared between processes, which only works when they are plain memory
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::uint8_t>::is_always_lock_free);
+
+    static constexpr std::size_t AlignUp(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static std::uint32_t RoundUpToPowerOfTwo(std::uint32_t value)
+    {
+        std::uint32_t result = 1;
+        while (result < value && result < (1u << 30))
+            result <<= 1;
+        return result;
+    }
+
+    static void Signal(int fd)
+    {
+        const std::uint64_t one = 1;
+        // Only fails when the counter would overflow, in which case the peer has plenty of wakeups pending already
+        [[maybe_unused]] const auto written = write(fd, &one, sizeof(one));
+    }
+
+    static void ClearSignal(int fd)
+    {
+        std::uint64_t count;
+        [[maybe_unused]] const auto read = ::read(fd, &count, sizeof(count));
+    }
+
+    SharedChannel& SharedChannel::operator=(SharedChannel&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            m_Header = std::exchange(other.m_Header, nullptr);
+            m_MappedSize = std::exchange(other.m_MappedSize, 0);
+            m_EventCapacity = other.m_EventCapacity;
+            m_MaxWidth = other.m_MaxWidth;
+            m_MaxHeight = other.m_MaxHeight;
+            m_EventsOffset = other.m_EventsOffset;
+            m_FramesOffset = other.m_FramesOffset;
+            m_FrameSize = other.m_FrameSize;
+            m_MemoryFd = std::exchange(other.m_MemoryFd, -1);
+            m_EventFd = std::exchange(other.m_EventFd, -1);
+            m_FrameFd = std::exchange(other.m_FrameFd, -1);
+            m_Back = other.m_Back;
+            m_Front = other.m_Front;
+            m_EventsPending = other.m_EventsPending;
+            m_DroppedEvents = other.m_DroppedEvents;
+            m_FrameSequence = other.m_FrameSequence;
+        }
+        return *this;
+    }
+
+    void SharedChannel::Close()
+    {
+        if (m_Header != nullptr)
+            munmap(m_Header, m_MappedSize);
+        for (int* fd : { &m_MemoryFd, &m_EventFd, &m_FrameFd })
+        {
+            if (*fd >= 0)
+                close(*fd);
+            *fd = -1;
+        }
+        m_Header = nullptr;
+        m_MappedSize = 0;
+    }
+
+    std::optional<SharedChannel> SharedChannel::Create(const SharedChannelConfig& config)
+    {
+        if (config.MaxWidth == 0 || config.MaxHeight == 0 || config.MaxWidth > 16384 || config.MaxHeight > 16384)
+        {
+            PULSARION_LOG_ERROR("Invalid shared channel framebuffer size {0}x{1}", config.MaxWidth, config.MaxHeight);
+            return std::nullopt;
+        }
+
+        SharedChannel channel;
+        channel.m_EventCapacity = RoundUpToPowerOfTwo(std::max(config.EventCapacity, 2u));
+        channel.m_MaxWidth = config.MaxWidth;
+        channel.m_MaxHeight = config.MaxHeight;
+        channel.m_EventsOffset = AlignUp(sizeof(Header), 64);
+        channel.m_FramesOffset = AlignUp(channel.m_EventsOffset + channel.m_EventCapacity * sizeof(RemoteEvent), PageSize);
+        channel.m_FrameSize = AlignUp(static_cast<std::size_t>(config.MaxWidth) * config.MaxHeight * 4, PageSize);
+        const std::size_t size = channel.m_FramesOffset + channel.m_FrameSize * 3;
+
+        channel.m_MemoryFd = memfd_create("pulsarion-window", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        channel.m_EventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        channel.m_FrameFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (channel.m_MemoryFd < 0 || channel.m_EventFd < 0 || channel.m_FrameFd < 0 || ftruncate(channel.m_MemoryFd, static_cast<off_t>(size)) != 0
+            || fcntl(channel.m_MemoryFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0)
+        {
+            PULSARION_LOG_ERROR("Failed to create the shared channel: {0}", std::strerror(errno));
+            return std::nullopt;
+        }
+
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, channel.m_MemoryFd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            PULSARION_LOG_ERROR("Failed to map the shared channel: {0}", std::strerror(errno));
+            return std::nullopt;
+        }
+        channel.m_MappedSize = size;
+
+        // The memfd starts out zeroed, the framebuffers and events don't need to be touched and stay unbacked until used
+        Header* header = new (mapping) Header {};
+        header->Magic = ChannelMagic;
+        header->Version = ChannelVersion;
+        header->EventCapacity = channel.m_EventCapacity;
+        header->MaxWidth = channel.m_MaxWidth;
+        header->MaxHeight = channel.m_MaxHeight;
+        header->FrameShared.store(1, std::memory_order_release);
+        channel.m_Header = header;
+        return channel;
+    }
+
+    std::optional<SharedChannel> SharedChannel::Adopt(int memoryFd, int eventFd, int frameFd)
+    {
+        SharedChannel channel;
+        channel.m_MemoryFd = memoryFd;
+        channel.m_EventFd = eventFd;
+        channel.m_FrameFd = frameFd;
+
+        struct stat info = {};
+        if (fstat(memoryFd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header))
+        {
+            PULSARION_LOG_ERROR("The shared channel fd {0} is not a channel", memoryFd);
+            return std::nullopt;
+        }
+        const auto size = static_cast<std::size_t>(info.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            PULSARION_LOG_ERROR("Failed to map the shared channel: {0}", std::strerror(errno));
+            return std::nullopt;
+        }
+        channel.m_Header = static_cast<Header*>(mapping);
+        channel.m_MappedSize = size;
+
+        const Header& header = *channel.m_Header;
+        if (header.Magic != ChannelMagic || header.Version != ChannelVersion)
+        {
+            PULSARION_LOG_ERROR("The shared channel has version {0}, expected {1}", header.Version, ChannelVersion);
+            return std::nullopt;
+        }
+        channel.m_EventCapacity = header.EventCapacity;
+        channel.m_MaxWidth = header.MaxWidth;
+        channel.m_MaxHeight = header.MaxHeight;
+        channel.m_EventsOffset = AlignUp(sizeof(Header), 64);
+        channel.m_FramesOffset = AlignUp(channel.m_EventsOffset + static_cast<std::size_t>(channel.m_EventCapacity) * sizeof(RemoteEvent), PageSize);
+        channel.m_FrameSize = AlignUp(static_cast<std::size_t>(channel.m_MaxWidth) * channel.m_MaxHeight * 4, PageSize);
+        // Create never makes fewer than two slots, and zero would pass the power of two check
+        if (channel.m_EventCapacity < 2 || (channel.m_EventCapacity & (channel.m_EventCapacity - 1)) != 0 || channel.m_FramesOffset + channel.m_FrameSize * 3 > size)
+        {
+            PULSARION_LOG_ERROR("The shared channel layout doesn't fit its {0} bytes", size);
+            return std::nullopt;
+        }
+        return channel;
+    }
+
+    RemoteEvent* SharedChannel::GetEvents() const
+    {
+        return reinterpret_cast<RemoteEvent*>(reinterpret_cast<std::byte*>(m_Header) + m_EventsOffset);
+    }
+
+    std::byte* SharedChannel::GetFramebuffer(std::uint8_t index) const
+    {
+        return reinterpret_cast<std::byte*>(m_Header) + m_FramesOffset + m_FrameSize * index;
+    }
+
+    bool SharedChannel::PushEvent(const RemoteEvent& event)
+    {
+        const std::uint64_t write = m_Header->EventWrite.load(std::memory_order_relaxed);
+        // Read is the client's counter, anything but write - capacity..write means it's full or broken
+        if (write - m_Header->EventRead.load(std::memory_order_acquire) >= m_EventCapacity)
+        {
+            m_DroppedEvents++;
+            return false;
+        }
+        GetEvents()[write & (m_EventCapacity - 1)] = event;
+        m_Header->EventWrite.store(write + 1, std::memory_order_release);
+        m_EventsPending = true;
+        return true;
+    }
+
+    void SharedChannel::FlushEvents()
+    {
+        if (!m_EventsPending)
+            return;
+        m_EventsPending = false;
+        Signal(m_EventFd);
+    }
+
+    std::optional<SharedFrame> SharedChannel::AcquireFrame()
+    {
+        if ((m_Header->FrameShared.load(std::memory_order_relaxed) & FreshBit) == 0)
+            return std::nullopt;
+        const std::uint8_t shared = m_Header->FrameShared.exchange(m_Front, std::memory_order_acq_rel);
+        const std::uint8_t index = shared & ~FreshBit;
+        if (index > 2)
+        {
+            // Only a broken client writes this, take our framebuffer back and keep showing the old frame
+            m_Header->FrameShared.store(m_Front, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        m_Front = index;
+
+        const SharedFrameInfo info = m_Header->Frames[index];
+        SharedFrame frame;
+        frame.Width = std::min(info.Width, m_MaxWidth);
+        frame.Height = std::min(info.Height, m_MaxHeight);
+        frame.Stride = m_MaxWidth * 4;
+        frame.Sequence = info.Sequence;
+        frame.Pixels = { GetFramebuffer(index), static_cast<std::size_t>(frame.Stride) * frame.Height };
+        return frame;
+    }
+
+    bool SharedChannel::IsCloseRequested() const
+    {
+        return m_Header->CloseRequested.load(std::memory_order_acquire) != 0;
+    }
+
+    std::uint64_t SharedChannel::GetClientHeartbeat() const
+    {
+        return m_Header->ClientHeartbeat.load(std::memory_order_relaxed);
+    }
+
+    bool SharedChannel::PopEvent(RemoteEvent& event)
+    {
+        const std::uint64_t read = m_Header->EventRead.load(std::memory_order_relaxed);
+        if (read == m_Header->EventWrite.load(std::memory_order_acquire))
+            return false;
+        event = GetEvents()[read & (m_EventCapacity - 1)];
+        m_Header->EventRead.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::span<std::byte> SharedChannel::GetBackBuffer()
+    {
+        return { GetFramebuffer(m_Back), static_cast<std::size_t>(m_MaxWidth) * m_MaxHeight * 4 };
+    }
+
+    void SharedChannel::Present(std::uint32_t width, std::uint32_t height)
+    {
+        m_Header->Frames[m_Back] = { std::min(width, m_MaxWidth), std::min(height, m_MaxHeight), ++m_FrameSequence };
+        const std::uint8_t previous = m_Header->FrameShared.exchange(m_Back | FreshBit, std::memory_order_acq_rel);
+        m_Back = previous & ~FreshBit;
+        // Only wake the host for the first frame it hasn't seen, it picks up the newest one anyway
+        if ((previous & FreshBit) == 0)
+            Signal(m_FrameFd);
+        Beat();
+    }
+
+    void SharedChannel::RequestClose()
+    {
+        m_Header->CloseRequested.store(1, std::memory_order_release);
+        Signal(m_FrameFd);
+    }
+
+    void SharedChannel::Beat()
+    {
+        m_Header->ClientHeartbeat.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void SharedChannel::ClearEventSignal()
+    {
+        ClearSignal(m_EventFd);
+    }
+
+    void SharedChannel::ClearFrameSignal()
+    {
+        ClearSignal(m_FrameFd);
+    }
+
+    RemoteWindowHost::RemoteWindowHost(EventBus& bus, SharedChannel& channel) : m_Bus(bus), m_Channel(channel)
+    {
+        // Before every other listener. Only Close is consumed, the host's own listeners still see every other event.
+        constexpr std::int32_t priority = INT32_MAX;
+        const auto with = [](EventType type) { RemoteEvent event; event.Type = type; return event; };
+
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Close>([this, with](void*)
+        {
+            Forward(with(EventType::Close));
+            return true; // The client decides
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::WindowVisibility>([this, with](void*, bool visible)
+        {
+            RemoteEvent event = with(EventType::WindowVisibility);
+            event.Flag = visible;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Focus>([this, with](void*, bool focused)
+        {
+            RemoteEvent event = with(EventType::Focus);
+            event.Flag = focused;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Resize>([this, with](void*, std::uint32_t width, std::uint32_t height)
+        {
+            RemoteEvent event = with(EventType::Resize);
+            event.X = width;
+            event.Y = height;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Move>([this, with](void*, std::uint32_t x, std::uint32_t y)
+        {
+            RemoteEvent event = with(EventType::Move);
+            event.X = x;
+            event.Y = y;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::BeforeResize>([this, with](void*)
+        {
+            Forward(with(EventType::BeforeResize));
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::AfterResize>([this, with](void*, std::uint32_t width, std::uint32_t height)
+        {
+            RemoteEvent event = with(EventType::AfterResize);
+            event.X = width;
+            event.Y = height;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Minimize>([this, with](void*)
+        {
+            Forward(with(EventType::Minimize));
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Maximize>([this, with](void*)
+        {
+            Forward(with(EventType::Maximize));
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Fullscreen>([this, with](void*, bool fullscreen)
+        {
+            RemoteEvent event = with(EventType::Fullscreen);
+            event.Flag = fullscreen;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Restore>([this, with](void*)
+        {
+            Forward(with(EventType::Restore));
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Occlusion>([this, with](void*, bool occluded)
+        {
+            RemoteEvent event = with(EventType::Occlusion);
+            event.Flag = occluded;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseEnter>([this, with](void*)
+        {
+            Forward(with(EventType::MouseEnter));
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseLeave>([this, with](void*)
+        {
+            Forward(with(EventType::MouseLeave));
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseDown>([this, with](void*, Point position, MouseCode button)
+        {
+            RemoteEvent event = with(EventType::MouseDown);
+            event.Position = position;
+            event.Button = button;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseUp>([this, with](void*, Point position, MouseCode button)
+        {
+            RemoteEvent event = with(EventType::MouseUp);
+            event.Position = position;
+            event.Button = button;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseMove>([this, with](void*, Point position)
+        {
+            RemoteEvent event = with(EventType::MouseMove);
+            event.Position = position;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseWheel>([this, with](void*, Point position, ScrollOffset offset)
+        {
+            RemoteEvent event = with(EventType::MouseWheel);
+            event.Position = position;
+            event.Offset = offset;
+            Forward(event);
+            return false;
+        }, priority));
+        // Only the sum crosses, the client sees it as a single sample
+        m_Subscriptions.push_back(bus.Subscribe<EventType::RawMouseMove>([this, with](void*, Point total, std::span<const Point>)
+        {
+            RemoteEvent event = with(EventType::RawMouseMove);
+            event.Offset = total;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::KeyDown>([this, with](void*, KeyCode key, Modifier modifiers, bool repeat)
+        {
+            RemoteEvent event = with(EventType::KeyDown);
+            event.Key = key;
+            event.Modifiers = modifiers;
+            event.Flag = repeat;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::KeyUp>([this, with](void*, KeyCode key, Modifier modifiers)
+        {
+            RemoteEvent event = with(EventType::KeyUp);
+            event.Key = key;
+            event.Modifiers = modifiers;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::KeyTyped>([this, with](void*, char character, Modifier modifiers)
+        {
+            RemoteEvent event = with(EventType::KeyTyped);
+            event.Text[0] = character;
+            event.TextSize = 1;
+            event.Modifiers = modifiers;
+            Forward(event);
+            return false;
+        }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::TextInput>([this, with](void*, std::string_view text)
+        {
+            while (!text.empty())
+            {
+                std::size_t size = std::min(text.size(), RemoteEvent::TextCapacity);
+                // Back off to the start of a UTF-8 sequence, a piece never ends inside one
+                while (size < text.size() && size > 0 && (static_cast<unsigned char>(text[size]) & 0xC0) == 0x80)
+                    size--;
+                if (size == 0)
+                    size = std::min(text.size(), RemoteEvent::TextCapacity); // Not UTF-8, split anywhere
+                RemoteEvent event = with(EventType::TextInput);
+                std::memcpy(event.Text, text.data(), size);
+                event.TextSize = static_cast<std::uint8_t>(size);
+                Forward(event);
+                text.remove_prefix(size);
+            }
+            return false;
+        }, priority));
+        // Touch contacts don't fit a fixed size slot and aren't forwarded
+    }
+
+    bool RemoteWindowHost::Update(TimePoint now, std::chrono::nanoseconds timeout)
+    {
+        if (m_Channel.IsCloseRequested() && m_Bus.GetWindow() != nullptr)
+            m_Bus.GetWindow()->SetShouldClose(true);
+
+        const std::uint64_t heartbeat = m_Channel.GetClientHeartbeat();
+        if (!m_Started || heartbeat != m_Heartbeat)
+        {
+            m_Started = true;
+            m_Heartbeat = heartbeat;
+            m_LastBeat = now;
+            m_Stale = false;
+            return true;
+        }
+        if (now - m_LastBeat <= timeout)
+            return true;
+        // Only logged once per stall, the host keeps calling while it decides what to do
+        if (!m_Stale)
+            PULSARION_LOG_WARN("[RemoteWindowHost] The client hasn't beaten for {0} ms", std::chrono::duration_cast<std::chrono::milliseconds>(now - m_LastBeat).count());
+        m_Stale = true;
+        return false;
+    }
+
+    std::size_t RemoteEventPump::Pump(EventBus& bus, void* userData)
+    {
+        m_Channel.ClearEventSignal();
+        std::size_t count = 0;
+        RemoteEvent event;
+        while (m_Channel.PopEvent(event))
+        {
+            Dispatch(bus, userData, event);
+            count++;
+        }
+        m_Channel.Beat();
+        return count;
+    }
+
+    void RemoteEventPump::Dispatch(EventBus& bus, void* userData, const RemoteEvent& event)
+    {
+        switch (event.Type)
+        {
+        case EventType::Close:
+            if (!bus.Dispatch<EventType::Close>(userData))
+                m_Channel.RequestClose();
+            break;
+        case EventType::WindowVisibility:
+            bus.Dispatch<EventType::WindowVisibility>(userData, event.Flag);
+            break;
+        case EventType::Focus:
+            bus.Dispatch<EventType::Focus>(userData, event.Flag);
+            break;
+        case EventType::Resize:
+            bus.Dispatch<EventType::Resize>(userData, event.X, event.Y);
+            break;
+        case EventType::Move:
+            bus.Dispatch<EventType::Move>(userData, event.X, event.Y);
+            break;
+        case EventType::BeforeResize:
+            bus.Dispatch<EventType::BeforeResize>(userData);
+            break;
+        case EventType::AfterResize:
+            bus.Dispatch<EventType::AfterResize>(userData, event.X, event.Y);
+            break;
+        case EventType::Minimize:
+            bus.Dispatch<EventType::Minimize>(userData);
+            break;
+        case EventType::Maximize:
+            bus.Dispatch<EventType::Maximize>(userData);
+            break;
+        case EventType::Fullscreen:
+            bus.Dispatch<EventType::Fullscreen>(userData, event.Flag);
+            break;
+        case EventType::Restore:
+            bus.Dispatch<EventType::Restore>(userData);
+            break;
+        case EventType::Occlusion:
+            bus.Dispatch<EventType::Occlusion>(userData, event.Flag);
+            break;
+        case EventType::MouseEnter:
+            bus.Dispatch<EventType::MouseEnter>(userData);
+            break;
+        case EventType::MouseLeave:
+            bus.Dispatch<EventType::MouseLeave>(userData);
+            break;
+        case EventType::MouseDown:
+            bus.Dispatch<EventType::MouseDown>(userData, event.Position, event.Button);
+            break;
+        case EventType::MouseUp:
+            bus.Dispatch<EventType::MouseUp>(userData, event.Position, event.Button);
+            break;
+        case EventType::MouseMove:
+            bus.Dispatch<EventType::MouseMove>(userData, event.Position);
+            break;
+        case EventType::MouseWheel:
+            bus.Dispatch<EventType::MouseWheel>(userData, event.Position, event.Offset);
+            break;
+        case EventType::RawMouseMove:
+            bus.Dispatch<EventType::RawMouseMove>(userData, event.Offset, std::span<const Point>(&event.Offset, 1));
+            break;
+        case EventType::KeyDown:
+            bus.Dispatch<EventType::KeyDown>(userData, event.Key, event.Modifiers, event.Flag);
+            break;
+        case EventType::KeyUp:
+            bus.Dispatch<EventType::KeyUp>(userData, event.Key, event.Modifiers);
+            break;
+        case EventType::KeyTyped:
+            bus.Dispatch<EventType::KeyTyped>(userData, event.Text[0], event.Modifiers);
+            break;
+        case EventType::TextInput:
+            bus.Dispatch<EventType::TextInput>(userData, std::string_view(event.Text, std::min<std::size_t>(event.TextSize, RemoteEvent::TextCapacity)));
+            break;
+        default:
+            break;
+        }
+    }
+}
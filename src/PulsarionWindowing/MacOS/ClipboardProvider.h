@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Cocoa/Cocoa.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common.hpp"
+
+// The pasteboard type for a clipboard format, MIME types without a native counterpart are used as the type name
+NSPasteboardType GetPasteboardType(std::string_view format);
+
+// Produces the offered formats once a pasteboard client asks for them
+@interface PulsarionClipboardProvider : NSObject <NSPasteboardItemDataProvider>
+{
+    std::shared_ptr<Pulsarion::Windowing::CocoaWindowState> m_State;
+    std::vector<std::string> m_Formats;
+    Pulsarion::Windowing::ClipboardProvider m_Provider;
+    NSPasteboardItem* m_Item; // Not retained, the pasteboard holds it while it is current
+}
+
+- (instancetype)initWithState:(std::shared_ptr<Pulsarion::Windowing::CocoaWindowState>)state formats:(std::vector<std::string>)formats provider:(Pulsarion::Windowing::ClipboardProvider)provider;
+
+// Creates the pasteboard item that promises every format, autoreleased
+- (NSPasteboardItem*)makeItem;
+
+// Produces everything that is still only promised, for when the window goes away while it owns the pasteboard
+- (void)provideAllData;
+
+@end
@@ -0,0 +1,97 @@
+#include "ClipboardProvider.h"
+
+#include <utility>
+
+NSPasteboardType GetPasteboardType(std::string_view format)
+{
+    if (format == Pulsarion::Windowing::ClipboardTextFormat)
+        return NSPasteboardTypeString; // Holds UTF-8, no conversion needed
+    if (format == Pulsarion::Windowing::ClipboardPngFormat)
+        return NSPasteboardTypePNG;
+    return [[[NSString alloc] initWithBytes:format.data() length:format.size() encoding:NSUTF8StringEncoding] autorelease];
+}
+
+namespace
+{
+    // Appends straight into the data the pasteboard item gets
+    class DataWriter final : public Pulsarion::Windowing::ClipboardWriter
+    {
+    public:
+        ~DataWriter() override { [m_Data release]; }
+
+        void Reserve(std::size_t size) override
+        {
+            if (m_Data == nil)
+                m_Data = [[NSMutableData alloc] initWithCapacity:size];
+        }
+
+        void Write(std::span<const std::byte> data) override
+        {
+            if (m_Data == nil)
+                m_Data = [[NSMutableData alloc] initWithCapacity:data.size()];
+            [m_Data appendBytes:data.data() length:data.size()];
+        }
+
+        [[nodiscard]] NSData* GetData() const { return m_Data != nil ? m_Data : [NSData data]; }
+
+    private:
+        NSMutableData* m_Data = nil;
+    };
+}
+
+@implementation PulsarionClipboardProvider
+
+- (instancetype)initWithState:(std::shared_ptr<Pulsarion::Windowing::CocoaWindowState>)state formats:(std::vector<std::string>)formats provider:(Pulsarion::Windowing::ClipboardProvider)provider
+{
+    self = [super init];
+    if (self)
+    {
+        m_State = std::move(state);
+        m_Formats = std::move(formats);
+        m_Provider = std::move(provider);
+        m_Item = nil;
+    }
+    return self;
+}
+
+- (NSPasteboardItem*)makeItem {
+    NSMutableArray<NSPasteboardType>* types = [NSMutableArray arrayWithCapacity:m_Formats.size()];
+    for (const auto& format : m_Formats)
+        [types addObject:GetPasteboardType(format)];
+
+    NSPasteboardItem* item = [[[NSPasteboardItem alloc] init] autorelease];
+    [item setDataProvider:self forTypes:types];
+    m_Item = item;
+    return item;
+}
+
+- (void)pasteboard:(NSPasteboard *)pasteboard item:(NSPasteboardItem *)item provideDataForType:(NSPasteboardType)type {
+    if (!m_Provider)
+        return;
+    for (const auto& format : m_Formats)
+    {
+        if (![GetPasteboardType(format) isEqualToString:type])
+            continue;
+        DataWriter writer;
+        m_Provider(m_State->UserData, format, writer);
+        [item setData:writer.GetData() forType:type];
+        return;
+    }
+}
+
+- (void)pasteboardFinishedWithDataProvider:(NSPasteboard *)pasteboard {
+    // Another application owns the pasteboard now, let go of whatever the provider captured
+    m_Provider = nullptr;
+    m_Item = nil;
+}
+
+- (void)provideAllData {
+    if (m_Item == nil || !m_Provider)
+        return;
+    @autoreleasepool {
+        for (const auto& format : m_Formats)
+            [self pasteboard:[NSPasteboard generalPasteboard] item:m_Item provideDataForType:GetPasteboardType(format)];
+    }
+}
+
+@end
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "../Window.hpp"
+#include "../TextInput.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace Pulsarion::Windowing
 {
@@ -8,13 +13,32 @@ namespace Pulsarion::Windowing
     {
         bool CloseRequested = false; // This is when the user clicks the close button or Cmd+Q
         void* UserData = nullptr;
+        TextInputBuffer TextInput; // Filled by the view's NSTextInputClient methods, flushed in PollEvents
+        CursorMode CurrentCursorMode = CursorMode::Normal;
+        Point RawMotion = { 0.0f, 0.0f };
+        std::vector<Point> RawMotionSamples = {}; // Flushed to OnRawMouseMove in PollEvents
+        std::vector<std::pair<std::string, ClipboardReceiver>> ClipboardRequests = {}; // Served at the end of PollEvents
+        TouchContactBuffer Touches; // Tablet pen contacts recorded by the view, flushed to OnTouch in PollEvents
+        TimerQueue Timers; // Dispatched at the end of PollEvents
+        Watchdog* LoopWatchdog = nullptr;
+        EventTypeFlags EventMask = EventTypeFlags::All;
+        // windowDidResize only records the content size, PollEvents reports the last one
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+        std::uint32_t PendingWidth = 0;
+        std::uint32_t PendingHeight = 0;
+        bool ResizePending = false;
+        bool ResizeEnded = false; // Set by windowDidEndLiveResize, AfterResize is called once the final size was reported
+        std::uint64_t SizeGeneration = 0;
 
         CocoaWindowState() = default;
 
+        // Handlers return before translating anything when this is false
+        [[nodiscard]] bool Wants(EventType type) const { return HasFlag(EventMask, type); }
+
         #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
         bool LimitEvents = false;
         std::uint64_t LimitedEvents = 0; // A bitmap is much more efficient,
-        constexpr static std::uint32_t WINDOW_RESIZE_EVENT = 1;
         #endif
 
     };
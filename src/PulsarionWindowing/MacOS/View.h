@@ -3,17 +3,26 @@
 #include <Cocoa/Cocoa.h>
 #include "Common.hpp"
 
-@interface PulsarionView: NSView
+@interface PulsarionView: NSView<NSTextInputClient>
 
 {
     std::shared_ptr<Pulsarion::Windowing::CocoaWindowState> state;
     NSTrackingArea* trackingArea;
+    NSMutableAttributedString* markedText; // The IME composition that has not been committed yet
+    NSCursor* currentCursor; // Not retained, the window's cursor cache or AppKit owns it
+    BOOL penIsEraser; // From the last tablet proximity event, tablet points don't say which end touches
 }
 
 - (void)mouseEntered:(NSEvent *)event;
 
 - (instancetype)initWithState:(std::shared_ptr<Pulsarion::Windowing::CocoaWindowState>)state;
 
+// Shown while the mouse is over the view, right away if it already is
+- (void)setCurrentCursor:(NSCursor *)cursor;
+
+// Recreates the tracking area with only the mouse events the state's event mask asks for
+- (void)updateTrackingAreas;
+
 @end
 
 
@@ -1,6 +1,6 @@
 #include "View.h"
 #include "PulsarionWindowing/Mouse.hpp"
-#include <Carbon/Carbon.h> // Necessary for key code definitions on macOS
+#include "PulsarionWindowing/KeyTable.hpp"
 
 static Pulsarion::Windowing::MouseCode GetMouseCode(NSUInteger buttonNumber)
 {
@@ -9,110 +9,6 @@ static Pulsarion::Windowing::MouseCode GetMouseCode(NSUInteger buttonNumber)
     return Pulsarion::Windowing::MouseCode::Unknown;
 }
 
-Pulsarion::Windowing::KeyCode ConvertMacKeyCodeToKeyCode(unsigned short macKeyCode) {
-    using KeyCode = Pulsarion::Windowing::KeyCode;
-    switch (macKeyCode) {
-        case kVK_Space: return KeyCode::Space;
-        case kVK_ANSI_A: return KeyCode::A;
-        case kVK_ANSI_B: return KeyCode::B;
-        case kVK_ANSI_C: return KeyCode::C;
-        case kVK_ANSI_D: return KeyCode::D;
-        case kVK_ANSI_E: return KeyCode::E;
-        case kVK_ANSI_F: return KeyCode::F;
-        case kVK_ANSI_G: return KeyCode::G;
-        case kVK_ANSI_H: return KeyCode::H;
-        case kVK_ANSI_I: return KeyCode::I;
-        case kVK_ANSI_J: return KeyCode::J;
-        case kVK_ANSI_K: return KeyCode::K;
-        case kVK_ANSI_L: return KeyCode::L;
-        case kVK_ANSI_M: return KeyCode::M;
-        case kVK_ANSI_N: return KeyCode::N;
-        case kVK_ANSI_O: return KeyCode::O;
-        case kVK_ANSI_P: return KeyCode::P;
-        case kVK_ANSI_Q: return KeyCode::Q;
-        case kVK_ANSI_R: return KeyCode::R;
-        case kVK_ANSI_S: return KeyCode::S;
-        case kVK_ANSI_T: return KeyCode::T;
-        case kVK_ANSI_U: return KeyCode::U;
-        case kVK_ANSI_V: return KeyCode::V;
-        case kVK_ANSI_W: return KeyCode::W;
-        case kVK_ANSI_X: return KeyCode::X;
-        case kVK_ANSI_Y: return KeyCode::Y;
-        case kVK_ANSI_Z: return KeyCode::Z;
-        case kVK_ANSI_0: return KeyCode::D0;
-        case kVK_ANSI_1: return KeyCode::D1;
-        case kVK_ANSI_2: return KeyCode::D2;
-        case kVK_ANSI_3: return KeyCode::D3;
-        case kVK_ANSI_4: return KeyCode::D4;
-        case kVK_ANSI_5: return KeyCode::D5;
-        case kVK_ANSI_6: return KeyCode::D6;
-        case kVK_ANSI_7: return KeyCode::D7;
-        case kVK_ANSI_8: return KeyCode::D8;
-        case kVK_ANSI_9: return KeyCode::D9;
-        case kVK_ANSI_Semicolon: return KeyCode::Semicolon;
-        case kVK_ANSI_Equal: return KeyCode::Equal;
-        case kVK_ANSI_Comma: return KeyCode::Comma;
-        case kVK_ANSI_Minus: return KeyCode::Minus;
-        case kVK_ANSI_Period: return KeyCode::Period;
-        case kVK_ANSI_Slash: return KeyCode::Slash;
-        case kVK_ANSI_Grave: return KeyCode::GraveAccent;
-        case kVK_ANSI_LeftBracket: return KeyCode::LeftBracket;
-        case kVK_ANSI_Backslash: return KeyCode::Backslash;
-        case kVK_ANSI_RightBracket: return KeyCode::RightBracket;
-        case kVK_ANSI_Quote: return KeyCode::Apostrophe;
-        case kVK_Return: return KeyCode::Enter;
-        case kVK_Tab: return KeyCode::Tab;
-        case kVK_Delete: return KeyCode::Backspace;
-        case kVK_ForwardDelete: return KeyCode::Delete;
-        case kVK_RightArrow: return KeyCode::Right;
-        case kVK_LeftArrow: return KeyCode::Left;
-        case kVK_DownArrow: return KeyCode::Down;
-        case kVK_UpArrow: return KeyCode::Up;
-        case kVK_Escape: return KeyCode::Escape;
-        case kVK_Command: return KeyCode::LeftSuper;
-        case kVK_Shift: return KeyCode::LeftShift;
-        case kVK_CapsLock: return KeyCode::CapsLock;
-        case kVK_Option: return KeyCode::LeftAlt;
-        case kVK_Control: return KeyCode::LeftControl;
-        case kVK_RightShift: return KeyCode::RightShift;
-        case kVK_RightOption: return KeyCode::RightAlt;
-        case kVK_RightControl: return KeyCode::RightControl;
-        // F1-F12
-        case kVK_F1: return KeyCode::F1;
-        case kVK_F2: return KeyCode::F2;
-        case kVK_F3: return KeyCode::F3;
-        case kVK_F4: return KeyCode::F4;
-        case kVK_F5: return KeyCode::F5;
-        case kVK_F6: return KeyCode::F6;
-        case kVK_F7: return KeyCode::F7;
-        case kVK_F8: return KeyCode::F8;
-        case kVK_F9: return KeyCode::F9;
-        case kVK_F10: return KeyCode::F10;
-        case kVK_F11: return KeyCode::F11;
-        case kVK_F12: return KeyCode::F12;
-        // Numpad
-        case kVK_ANSI_Keypad0: return KeyCode::KP0;
-        case kVK_ANSI_Keypad1: return KeyCode::KP1;
-        case kVK_ANSI_Keypad2: return KeyCode::KP2;
-        case kVK_ANSI_Keypad3: return KeyCode::KP3;
-        case kVK_ANSI_Keypad4: return KeyCode::KP4;
-        case kVK_ANSI_Keypad5: return KeyCode::KP5;
-        case kVK_ANSI_Keypad6: return KeyCode::KP6;
-        case kVK_ANSI_Keypad7: return KeyCode::KP7;
-        case kVK_ANSI_Keypad8: return KeyCode::KP8;
-        case kVK_ANSI_Keypad9: return KeyCode::KP9;
-        case kVK_ANSI_KeypadDecimal: return KeyCode::KPDecimal;
-        case kVK_ANSI_KeypadMultiply: return KeyCode::KPMultiply;
-        case kVK_ANSI_KeypadPlus: return KeyCode::KPAdd;
-        case kVK_ANSI_KeypadClear: return KeyCode::KPEnter;
-        case kVK_ANSI_KeypadDivide: return KeyCode::KPDivide;
-        case kVK_ANSI_KeypadEnter: return KeyCode::KPEnter;
-        case kVK_ANSI_KeypadMinus: return KeyCode::KPSubtract;
-        case kVK_ANSI_KeypadEquals: return KeyCode::KPEqual;
-        default: return KeyCode::Unknown;
-    }
-}
-
 static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 {
     Pulsarion::Windowing::Modifier modifier = 0;
@@ -127,6 +23,18 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
     return modifier;
 }
 
+static NSTrackingAreaOptions GetTrackingOptions(const Pulsarion::Windowing::CocoaWindowState& state)
+{
+    using Pulsarion::Windowing::EventType;
+    NSTrackingAreaOptions options = NSTrackingCursorUpdate; // The cursor is ours to set whatever the mask says
+    if (HasAnyFlag(state.EventMask, EventType::MouseEnter | EventType::MouseLeave))
+        options |= NSTrackingMouseEnteredAndExited;
+    // Raw motion is also read from mouseMoved:, so it keeps the mouse moved events alive
+    if (HasAnyFlag(state.EventMask, EventType::MouseMove | EventType::RawMouseMove))
+        options |= NSTrackingMouseMoved;
+    return options;
+}
+
 @implementation PulsarionView
 
 - (instancetype)initWithState:(std::shared_ptr<Pulsarion::Windowing::CocoaWindowState>)initState
@@ -136,12 +44,20 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
         return nil;
 
     state = initState;
-    NSTrackingAreaOptions options = NSTrackingActiveInKeyWindow | NSTrackingMouseEnteredAndExited | NSTrackingMouseMoved;
-    trackingArea = [[NSTrackingArea alloc] initWithRect:[self bounds] options:options owner:self userInfo:nil];
-    [self addTrackingArea:trackingArea];
+    markedText = [[NSMutableAttributedString alloc] init];
+    trackingArea = nil;
+    penIsEraser = NO;
+    currentCursor = nil;
+    [self updateTrackingAreas];
     return self;
 }
 
+- (void)dealloc {
+    [markedText release];
+    [trackingArea release];
+    [super dealloc];
+}
+
 - (void)viewWillMoveToWindow:(NSWindow *)newWindow {
     [super viewWillMoveToWindow:newWindow];
     if (newWindow) {
@@ -151,12 +67,33 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 
 - (void)updateTrackingAreas {
     [super updateTrackingAreas];
-    [self removeTrackingArea:trackingArea];
-    [trackingArea release];
-    trackingArea = [[NSTrackingArea alloc] initWithRect:[self bounds] options:NSTrackingActiveInKeyWindow | NSTrackingMouseEnteredAndExited | NSTrackingMouseMoved owner:self userInfo:nil];
+    if (trackingArea != nil)
+    {
+        [self removeTrackingArea:trackingArea];
+        [trackingArea release];
+        trackingArea = nil;
+    }
+
+    // With everything masked the window server only sends us the cursor updates
+    const NSTrackingAreaOptions options = GetTrackingOptions(*state);
+    trackingArea = [[NSTrackingArea alloc] initWithRect:[self bounds] options:NSTrackingActiveInKeyWindow | options owner:self userInfo:nil];
     [self addTrackingArea:trackingArea];
 }
 
+- (void)setCurrentCursor:(NSCursor *)cursor {
+    currentCursor = cursor;
+    NSWindow* window = [self window];
+    if (window == nil)
+        return;
+    const NSPoint point = [self convertPoint:[window mouseLocationOutsideOfEventStream] fromView:nil];
+    if (NSPointInRect(point, [self bounds]))
+        [(currentCursor != nil ? currentCursor : [NSCursor arrowCursor]) set];
+}
+
+- (void)cursorUpdate:(NSEvent *)event {
+    [(currentCursor != nil ? currentCursor : [NSCursor arrowCursor]) set];
+}
+
 - (BOOL)acceptsFirstResponder {
     return YES;
 }
@@ -170,21 +107,45 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 }
 
 - (void)mouseEntered:(NSEvent *)event {
-    if (state->OnMouseEnter)
+    if (state->OnMouseEnter && state->Wants(Pulsarion::Windowing::EventType::MouseEnter))
         state->OnMouseEnter(state->UserData);
 
     [super mouseEntered:event];
 }
 
 - (void)mouseExited:(NSEvent *)event {
-    if (state->OnMouseLeave)
+    if (state->OnMouseLeave && state->Wants(Pulsarion::Windowing::EventType::MouseLeave))
         state->OnMouseLeave(state->UserData);
 
     [super mouseExited:event];
 }
 
+- (void)tabletProximity:(NSEvent *)event {
+    penIsEraser = [event pointingDeviceType] == NSPointingDeviceTypeEraser;
+}
+
+// Tablet pens become touch contacts instead of mouse events while there is a touch callback, like WM_POINTER on Windows
+- (BOOL)recordPen:(NSEvent *)event phase:(Pulsarion::Windowing::TouchPhase)phase {
+    using namespace Pulsarion::Windowing;
+    if ([event subtype] != NSEventSubtypeTabletPoint || !state->OnTouch || !state->Wants(EventType::Touch))
+        return NO;
+
+    const Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
+    const Point tilt = { static_cast<float>(event.tilt.x * 90.0), static_cast<float>(event.tilt.y * 90.0) }; // Reported from -1 to 1
+    const std::uint64_t id = [event deviceID];
+    if (phase == TouchPhase::Began)
+        state->Touches.Begin(id, penIsEraser ? PointerKind::Eraser : PointerKind::Pen, point, event.pressure, tilt);
+    else if (phase == TouchPhase::Ended)
+        state->Touches.End(id, point);
+    else
+        state->Touches.Move(id, point, event.pressure, tilt);
+    return YES;
+}
+
 - (void)mouseDown:(NSEvent *)event {
-    if (state->OnMouseDown)
+    if ([self recordPen:event phase:Pulsarion::Windowing::TouchPhase::Began])
+        return;
+    if (state->OnMouseDown && state->Wants(Pulsarion::Windowing::EventType::MouseDown))
     {
          Pulsarion::Windowing::Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
          state->OnMouseDown(state->UserData, point, Pulsarion::Windowing::MouseCode::Button0);
@@ -192,7 +153,9 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 }
 
 - (void)mouseUp:(NSEvent *)event {
-    if (state->OnMouseUp)
+    if ([self recordPen:event phase:Pulsarion::Windowing::TouchPhase::Ended])
+        return;
+    if (state->OnMouseUp && state->Wants(Pulsarion::Windowing::EventType::MouseUp))
     {
          Pulsarion::Windowing::Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
          state->OnMouseUp(state->UserData, point, Pulsarion::Windowing::MouseCode::Button0);
@@ -200,7 +163,7 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 }
 
 - (void)rightMouseDown:(NSEvent *)event {
-    if (state->OnMouseDown)
+    if (state->OnMouseDown && state->Wants(Pulsarion::Windowing::EventType::MouseDown))
     {
          Pulsarion::Windowing::Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
          state->OnMouseDown(state->UserData, point, Pulsarion::Windowing::MouseCode::Button1);
@@ -208,7 +171,7 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 }
 
 - (void)rightMouseUp:(NSEvent *)event {
-    if (state->OnMouseUp)
+    if (state->OnMouseUp && state->Wants(Pulsarion::Windowing::EventType::MouseUp))
     {
          Pulsarion::Windowing::Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
          state->OnMouseUp(state->UserData, point, Pulsarion::Windowing::MouseCode::Button1);
@@ -216,7 +179,7 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 }
 
 - (void)otherMouseDown:(NSEvent *)event {
-    if (state->OnMouseDown)
+    if (state->OnMouseDown && state->Wants(Pulsarion::Windowing::EventType::MouseDown))
     {
          Pulsarion::Windowing::Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
          state->OnMouseDown(state->UserData, point, GetMouseCode(event.buttonNumber));
@@ -224,7 +187,7 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 }
 
 - (void)otherMouseUp:(NSEvent *)event {
-    if (state->OnMouseUp)
+    if (state->OnMouseUp && state->Wants(Pulsarion::Windowing::EventType::MouseUp))
     {
          Pulsarion::Windowing::Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
          state->OnMouseUp(state->UserData, point, GetMouseCode(event.buttonNumber));
@@ -232,8 +195,32 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 
 }
 
+- (void)recordRawMotion:(NSEvent *)event {
+    if (state->CurrentCursorMode != Pulsarion::Windowing::CursorMode::Captured || !state->Wants(Pulsarion::Windowing::EventType::RawMouseMove))
+        return;
+    const Pulsarion::Windowing::Point delta = { static_cast<float>(event.deltaX), static_cast<float>(event.deltaY) };
+    state->RawMotion.x += delta.x;
+    state->RawMotion.y += delta.y;
+    state->RawMotionSamples.push_back(delta);
+}
+
+- (void)mouseDragged:(NSEvent *)event {
+    if ([self recordPen:event phase:Pulsarion::Windowing::TouchPhase::Moved])
+        return;
+    [self recordRawMotion:event];
+}
+
+- (void)rightMouseDragged:(NSEvent *)event {
+    [self recordRawMotion:event];
+}
+
+- (void)otherMouseDragged:(NSEvent *)event {
+    [self recordRawMotion:event];
+}
+
 - (void)mouseMoved:(NSEvent *)event {
-    if (state->OnMouseMove)
+    [self recordRawMotion:event];
+    if (state->OnMouseMove && state->Wants(Pulsarion::Windowing::EventType::MouseMove))
     {
          Pulsarion::Windowing::Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
          state->OnMouseMove(state->UserData, point);
@@ -242,7 +229,7 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 }
 
 - (void)scrollWheel:(NSEvent *)event {
-    if (state->OnMouseWheel)
+    if (state->OnMouseWheel && state->Wants(Pulsarion::Windowing::EventType::MouseWheel))
     {
          Pulsarion::Windowing::Point point = { static_cast<float>(event.locationInWindow.x), static_cast<float>(event.locationInWindow.y) };
          state->OnMouseWheel(state->UserData, point, { static_cast<float>(event.scrollingDeltaX), static_cast<float>(event.scrollingDeltaY) });
@@ -255,7 +242,7 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
     static std::uint16_t lastModifier = 0;
     // lShift 56, rShift 60, lCtrl 59, lOpt 58, rOpt 61, lCmd 55, rCmd 54
 
-    if (!state->OnKeyDown)
+    if (!state->OnKeyDown || !state->Wants(Pulsarion::Windowing::EventType::KeyDown))
         return;
 
     switch (event.keyCode)
@@ -330,7 +317,7 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
 
 - (void)keyDown:(NSEvent *)event {
     Pulsarion::Windowing::Modifier modifier = GetModifier(event);
-    if (state->OnKeyTyped)
+    if (state->OnKeyTyped && state->Wants(Pulsarion::Windowing::EventType::KeyTyped))
     {
         NSString* characters = [[event charactersIgnoringModifiers] lowercaseString];
         // There should be only one character in the string
@@ -343,14 +330,79 @@ static Pulsarion::Windowing::Modifier GetModifier(NSEvent* event)
         }
     }
 
-    if (state->OnKeyDown)
-        state->OnKeyDown(state->UserData, ConvertMacKeyCodeToKeyCode([event keyCode]), modifier, [event isARepeat]);
+    if (state->OnKeyDown && state->Wants(Pulsarion::Windowing::EventType::KeyDown))
+        state->OnKeyDown(state->UserData, Pulsarion::Windowing::KeyTable::FromMacKeyCode([event keyCode]), modifier, [event isARepeat]);
+
+    // Routes the event through the input method, which calls back into insertText: with the composed text
+    if (state->OnTextInput && state->Wants(Pulsarion::Windowing::EventType::TextInput))
+        [self interpretKeyEvents:@[event]];
 }
 
 - (void)keyUp:(NSEvent *)event {
+    if (!state->Wants(Pulsarion::Windowing::EventType::KeyUp))
+        return;
     Pulsarion::Windowing::Modifier modifier = GetModifier(event);
     if (state->OnKeyUp)
-        state->OnKeyUp(state->UserData, ConvertMacKeyCodeToKeyCode([event keyCode]), modifier);
+        state->OnKeyUp(state->UserData, Pulsarion::Windowing::KeyTable::FromMacKeyCode([event keyCode]), modifier);
+}
+
+// --- NSTextInputClient ---
+
+- (void)insertText:(id)string replacementRange:(NSRange)replacementRange {
+    NSString* characters = [string isKindOfClass:[NSAttributedString class]] ? [string string] : string;
+    const NSUInteger length = [characters length];
+    for (NSUInteger i = 0; i < length; i++)
+        state->TextInput.AppendUtf16([characters characterAtIndex:i]);
+
+    [self unmarkText];
+}
+
+- (void)setMarkedText:(id)string selectedRange:(NSRange)selectedRange replacementRange:(NSRange)replacementRange {
+    [markedText release];
+    if ([string isKindOfClass:[NSAttributedString class]])
+        markedText = [[NSMutableAttributedString alloc] initWithAttributedString:string];
+    else
+        markedText = [[NSMutableAttributedString alloc] initWithString:string];
+}
+
+- (void)unmarkText {
+    [[markedText mutableString] setString:@""];
+}
+
+- (BOOL)hasMarkedText {
+    return [markedText length] > 0;
+}
+
+- (NSRange)markedRange {
+    if ([markedText length] > 0)
+        return NSMakeRange(0, [markedText length]);
+    return NSMakeRange(NSNotFound, 0);
+}
+
+- (NSRange)selectedRange {
+    return NSMakeRange(NSNotFound, 0);
+}
+
+- (NSArray<NSAttributedStringKey>*)validAttributesForMarkedText {
+    return [NSArray array];
+}
+
+- (NSAttributedString*)attributedSubstringForProposedRange:(NSRange)range actualRange:(NSRangePointer)actualRange {
+    return nil;
+}
+
+- (NSUInteger)characterIndexForPoint:(NSPoint)point {
+    return 0;
+}
+
+- (NSRect)firstRectForCharacterRange:(NSRange)range actualRange:(NSRangePointer)actualRange {
+    // Place the candidate window at the bottom left of the view
+    const NSRect frame = [self frame];
+    return [[self window] convertRectToScreen:NSMakeRect(frame.origin.x, frame.origin.y, 0.0, 0.0)];
+}
+
+- (void)doCommandBySelector:(SEL)selector {
+    // Commands such as deleteBackward: are already reported through the key events
 }
 
 @end
@@ -4,7 +4,7 @@
 
 namespace Pulsarion::Windowing
 {
-    class CocoaWindow : public Window
+    class PULSARION_WINDOWING_API CocoaWindow final : public Window
     {
     public:
         explicit CocoaWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config);
@@ -12,12 +12,28 @@ namespace Pulsarion::Windowing
 
         void SetVisible(bool visible) override;
         void PollEvents() override;
+        void WaitEvents(std::optional<std::chrono::nanoseconds> timeout) override;
+        TimerId AddTimer(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat) override;
+        void RemoveTimer(TimerId id) override;
         [[nodiscard]] bool ShouldClose() const override;
         void SetShouldClose(bool shouldClose) override;
         void SetTitle(const std::string& title) override;
         [[nodiscard]] std::optional<std::string> GetTitle() const override;
+        [[nodiscard]] std::string_view GetTitleView() const override;
         [[nodiscard]] void* GetNativeWindow() const override;
         void SetCursorMode(CursorMode mode) override;
+        void SetCursorShape(CursorShape shape) override;
+        void SetCursorImage(const ImageView& image, std::uint32_t hotspotX, std::uint32_t hotspotY) override;
+        void SetIcon(std::span<const ImageView> images) override;
+        void SetEventMask(EventTypeFlags mask) override;
+        [[nodiscard]] EventTypeFlags GetEventMask() const override;
+        [[nodiscard]] std::uint64_t GetSizeGeneration() const override;
+        [[nodiscard]] WindowSize GetContentSize() const override;
+        [[nodiscard]] DisplayTiming GetDisplayTiming() const override;
+        void SetWatchdog(Watchdog* watchdog) override;
+        bool SetClipboard(std::vector<std::string> formats, ClipboardProvider&& provider) override;
+        void RequestClipboard(std::string format, ClipboardReceiver&& receiver) override;
+        [[nodiscard]] bool HasClipboardFormat(std::string_view format) const override;
 
 #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
         void LimitEvents(bool limit) override;
@@ -25,43 +41,53 @@ namespace Pulsarion::Windowing
 #endif
 
         void SetOnClose(CloseCallback&& callback) override;
-        [[nodiscard]] CloseCallback GetOnClose() const override;
+        [[nodiscard]] const CloseCallback& GetOnClose() const override;
         void SetOnWindowVisibility(VisibilityCallback&& callback) override;
-        [[nodiscard]] VisibilityCallback GetOnWindowVisibility() const override;
+        [[nodiscard]] const VisibilityCallback& GetOnWindowVisibility() const override;
         void SetOnFocus(FocusCallback&& callback) override;
-        [[nodiscard]] FocusCallback GetOnFocus() const override;
+        [[nodiscard]] const FocusCallback& GetOnFocus() const override;
         void SetOnResize(ResizeCallback&& callback) override;
-        [[nodiscard]] ResizeCallback GetOnResize() const override;
+        [[nodiscard]] const ResizeCallback& GetOnResize() const override;
         void SetOnMove(MoveCallback&& callback) override;
-        [[nodiscard]] MoveCallback GetOnMove() const override;
+        [[nodiscard]] const MoveCallback& GetOnMove() const override;
         void SetBeforeResize(BeforeResizeCallback&& callback) override;
-        [[nodiscard]] BeforeResizeCallback GetBeforeResize() const override;
+        [[nodiscard]] const BeforeResizeCallback& GetBeforeResize() const override;
+        void SetAfterResize(AfterResizeCallback&& callback) override;
+        [[nodiscard]] const AfterResizeCallback& GetAfterResize() const override;
         void SetOnMinimize(MinimizeCallback&& callback) override;
-        [[nodiscard]] MinimizeCallback GetOnMinimize() const override;
+        [[nodiscard]] const MinimizeCallback& GetOnMinimize() const override;
         void SetOnMaximize(MaximizeCallback&& callback) override;
-        [[nodiscard]] MaximizeCallback GetOnMaximize() const override;
+        [[nodiscard]] const MaximizeCallback& GetOnMaximize() const override;
         void SetOnFullscreen(FullscreenCallback&& callback) override;
-        [[nodiscard]] FullscreenCallback GetOnFullscreen() const override;
+        [[nodiscard]] const FullscreenCallback& GetOnFullscreen() const override;
         void SetOnRestore(RestoreCallback&& callback) override;
-        [[nodiscard]] RestoreCallback GetOnRestore() const override;
+        [[nodiscard]] const RestoreCallback& GetOnRestore() const override;
+        void SetOnOcclusion(OcclusionCallback&& callback) override;
+        [[nodiscard]] const OcclusionCallback& GetOnOcclusion() const override;
         void SetOnMouseEnter(MouseEnterCallback&& callback) override;
-        [[nodiscard]] MouseEnterCallback GetOnMouseEnter() const override;
+        [[nodiscard]] const MouseEnterCallback& GetOnMouseEnter() const override;
         void SetOnMouseLeave(MouseLeaveCallback&& callback) override;
-        [[nodiscard]] MouseLeaveCallback GetOnMouseLeave() const override;
+        [[nodiscard]] const MouseLeaveCallback& GetOnMouseLeave() const override;
         void SetOnMouseDown(MouseDownCallback&& callback) override;
-        [[nodiscard]] MouseDownCallback GetOnMouseDown() const override;
+        [[nodiscard]] const MouseDownCallback& GetOnMouseDown() const override;
         void SetOnMouseUp(MouseUpCallback&& callback) override;
-        [[nodiscard]] MouseUpCallback GetOnMouseUp() const override;
+        [[nodiscard]] const MouseUpCallback& GetOnMouseUp() const override;
         void SetOnMouseMove(MouseMoveCallback&& callback) override;
-        [[nodiscard]] MouseMoveCallback GetOnMouseMove() const override;
+        [[nodiscard]] const MouseMoveCallback& GetOnMouseMove() const override;
         void SetOnMouseWheel(MouseWheelCallback&& callback) override;
-        [[nodiscard]] MouseWheelCallback GetOnMouseWheel() const override;
+        [[nodiscard]] const MouseWheelCallback& GetOnMouseWheel() const override;
+        void SetOnRawMouseMove(RawMouseMoveCallback&& callback) override;
+        [[nodiscard]] const RawMouseMoveCallback& GetOnRawMouseMove() const override;
+        void SetOnTouch(TouchCallback&& callback) override;
+        [[nodiscard]] const TouchCallback& GetOnTouch() const override;
         void SetOnKeyDown(KeyDownCallback&& callback) override;
-        [[nodiscard]] KeyDownCallback GetOnKeyDown() const override;
+        [[nodiscard]] const KeyDownCallback& GetOnKeyDown() const override;
         void SetOnKeyUp(KeyUpCallback&& callback) override;
-        [[nodiscard]] KeyUpCallback GetOnKeyUp() const override;
+        [[nodiscard]] const KeyUpCallback& GetOnKeyUp() const override;
         void SetOnKeyTyped(KeyTypedCallback&& callback) override;
-        [[nodiscard]] KeyTypedCallback GetOnKeyTyped() const override;
+        [[nodiscard]] const KeyTypedCallback& GetOnKeyTyped() const override;
+        void SetOnTextInput(TextInputCallback&& callback) override;
+        [[nodiscard]] const TextInputCallback& GetOnTextInput() const override;
 
         void SetUserData(void* userData) override;
         [[nodiscard]] void* GetUserData() const override;
@@ -3,14 +3,18 @@
 #include "PulsarionCore/Assert.hpp"
 
 #include "../Lifecycle.hpp"
+#include "../Watchdog.hpp"
 
 #include "Common.hpp"
 #include "AppDelegate.h"
 #include "PulsarionWindowing/MacOS/Application.h"
 #include "WindowDelegate.h"
+#include "ClipboardProvider.h"
 #include "NativeWindow.h"
 
 #include <Cocoa/Cocoa.h>
+#include <algorithm>
+#include <cstring>
 #include <vector>
 #include <utility>
 #include <memory>
@@ -18,6 +22,44 @@
 
 namespace Pulsarion::Windowing
 {
+    struct ObjectReleaser
+    {
+        void operator()(id object) const { [object release]; }
+    };
+
+    static NSCursor* GetShapeCursor(CursorShape shape)
+    {
+        switch (shape)
+        {
+        case CursorShape::IBeam: return [NSCursor IBeamCursor];
+        case CursorShape::Crosshair: return [NSCursor crosshairCursor];
+        case CursorShape::Hand: return [NSCursor pointingHandCursor];
+        case CursorShape::ResizeHorizontal: return [NSCursor resizeLeftRightCursor];
+        case CursorShape::ResizeVertical: return [NSCursor resizeUpDownCursor];
+        case CursorShape::ResizeAll: return [NSCursor openHandCursor];
+        case CursorShape::NotAllowed: return [NSCursor operationNotAllowedCursor];
+        // There are no public diagonal resize cursors, and the busy cursor is only ever shown by the system
+        default: return [NSCursor arrowCursor];
+        }
+    }
+
+    // Returns a retained image, nil for an invalid view
+    static NSImage* CreateImage(const ImageView& image)
+    {
+        if (!image.IsValid())
+            return nil;
+        NSBitmapImageRep* representation = [[NSBitmapImageRep alloc] initWithBitmapDataPlanes:nullptr
+            pixelsWide:image.Width pixelsHigh:image.Height bitsPerSample:8 samplesPerPixel:4 hasAlpha:YES isPlanar:NO
+            colorSpaceName:NSDeviceRGBColorSpace bitmapFormat:NSBitmapFormatAlphaNonpremultiplied bytesPerRow:image.Width * 4 bitsPerPixel:32];
+        if (representation == nil)
+            return nil;
+        std::memcpy([representation bitmapData], image.Pixels.data(), static_cast<std::size_t>(image.Width) * image.Height * 4);
+        NSImage* result = [[NSImage alloc] initWithSize:NSMakeSize(image.Width, image.Height)];
+        [result addRepresentation:representation];
+        [representation release];
+        return result;
+    }
+
     class CocoaWindow::Impl
     {
     public:
@@ -30,6 +72,13 @@ namespace Pulsarion::Windowing
         PulsarionWindowDelegate* m_WindowDelegate;
         PulsarionView* m_View;
         std::shared_ptr<CocoaWindowState> m_State;
+        std::string m_Title; // Cached, only we set the title
+        CGDirectDisplayID m_Display = kCGNullDirectDisplay; // The display m_RefreshRate was queried for
+        double m_RefreshRate = 0.0;
+        PulsarionClipboardProvider* m_ClipboardProvider = nil; // Our current offer on the general pasteboard
+        NSInteger m_ClipboardChangeCount = -1; // The pasteboard's change count right after our offer, it changes when someone else copies
+        NativeImageCache<NSCursor*, ObjectReleaser> m_Cursors; // Made from images, keyed by content and hotspot
+        NativeImageCache<NSImage*, ObjectReleaser> m_Icons;
 
         inline explicit Impl(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config)
             : m_State(std::make_shared<CocoaWindowState>())
@@ -51,7 +100,9 @@ namespace Pulsarion::Windowing
                 // Get height of screen
                 NSRect screenRect = [[NSScreen mainScreen] frame];
                 NSRect frame = NSMakeRect(bounds.X, ConvertCocoaY(bounds.Y, screenRect.size.height), bounds.Width, bounds.Height);
-                m_Window = [[PulsarionWindow alloc] initWithContentRect:frame styleMask:styleMask backing:NSBackingStoreBuffered defer:NO state:m_State];
+                m_Window = [[PulsarionWindow alloc] initWithContentRect:frame styleMask:styleMask backing:NSBackingStoreBuffered defer:(config.LazyRealize ? YES : NO) state:m_State];
+                m_State->Width = static_cast<std::uint32_t>(bounds.Width);
+                m_State->Height = static_cast<std::uint32_t>(bounds.Height);
                 m_WindowDelegate = [[PulsarionWindowDelegate alloc] initWithState:m_State];
                 m_View = [[PulsarionView alloc] initWithState:m_State];
                 NSTrackingAreaOptions options = NSTrackingActiveInKeyWindow | NSTrackingMouseEnteredAndExited | NSTrackingMouseMoved;
@@ -60,7 +111,8 @@ namespace Pulsarion::Windowing
                 [m_Window setContentView:m_View];
 
                 SetTitle(title);
-                if (config.StartVisible)
+                // A deferred window gets its window server counterpart the first time it is ordered on screen
+                if (config.StartVisible && !config.LazyRealize)
                     SetVisible(true);
 
                 if (initialized) // First time running or the app was terminated
@@ -70,6 +122,13 @@ namespace Pulsarion::Windowing
 
         ~Impl()
         {
+            if (m_ClipboardProvider != nil)
+            {
+                // Nobody could ask us for the data after this, so what we still own gets produced now
+                if ([[NSPasteboard generalPasteboard] changeCount] == m_ClipboardChangeCount)
+                    [m_ClipboardProvider provideAllData];
+                [m_ClipboardProvider release];
+            }
             if (m_Window == nil)
                 return;
             @autoreleasepool {
@@ -89,41 +148,191 @@ namespace Pulsarion::Windowing
                 else
                     [m_Window orderOut:nil];
 
-                if (m_State->OnWindowVisibility)
+                if (m_State->OnWindowVisibility && m_State->Wants(EventType::WindowVisibility))
                     m_State->OnWindowVisibility(m_State->UserData, visible);
             }
         }
 
-        inline void SetTitle(const std::string& title) const
+        inline void SetTitle(const std::string& title)
         {
+            if (title == m_Title)
+                return; // Saves the NSString round trip for callers that set the title every frame
+            m_Title = title;
+            // An owned string instead of an autoreleased one, so this doesn't need a pool
+            NSString* string = [[NSString alloc] initWithBytes:m_Title.data() length:m_Title.size() encoding:NSUTF8StringEncoding];
+            [m_Window setTitle:string];
+            [string release];
+        }
+
+        inline void SetCursorMode(CursorMode mode) const
+        {
+            const CursorMode currentMode = m_State->CurrentCursorMode;
+            if (mode == currentMode)
+                return;
             @autoreleasepool {
-                [m_Window setTitle:[NSString stringWithUTF8String:title.c_str()]];
+                // NSCursor hide and unhide are counted, so only call them when the visibility actually changes
+                if ((mode == CursorMode::Normal) != (currentMode == CursorMode::Normal))
+                {
+                    if (mode == CursorMode::Normal)
+                        [NSCursor unhide];
+                    else
+                        [NSCursor hide];
+                }
+
+                // Detaching the cursor from the mouse keeps it in place while the deltas keep coming, no warping needed
+                if (mode == CursorMode::Captured)
+                    CGAssociateMouseAndMouseCursorPosition(false);
+                else if (currentMode == CursorMode::Captured)
+                {
+                    CGAssociateMouseAndMouseCursorPosition(true);
+                    m_State->RawMotion = { 0.0f, 0.0f };
+                    m_State->RawMotionSamples.clear();
+                }
+            }
+            m_State->CurrentCursorMode = mode;
+        }
+
+        inline void SetEventMask(EventTypeFlags mask) const
+        {
+            m_State->EventMask = mask;
+            if (!m_State->Wants(EventType::RawMouseMove))
+            {
+                m_State->RawMotion = { 0.0f, 0.0f };
+                m_State->RawMotionSamples.clear();
             }
+            if (!m_State->Wants(EventType::TextInput))
+                m_State->TextInput.Clear();
+            // Drops or restores the mouse moved and entered/exited subscriptions
+            [m_View updateTrackingAreas];
         }
 
-        [[nodiscard]] inline std::string GetTitle() const
+        inline DisplayTiming GetDisplayTiming()
         {
+            DisplayTiming timing;
             @autoreleasepool {
-                return [[m_Window title] UTF8String];
+                NSScreen* screen = [m_Window screen];
+                if (screen == nil)
+                    return timing; // Off screen or not realized yet
+                const auto display = static_cast<CGDirectDisplayID>([[[screen deviceDescription] objectForKey:@"NSScreenNumber"] unsignedIntValue]);
+                if (display != m_Display)
+                {
+                    // Only asked again when the window moved to another screen
+                    m_Display = display;
+                    m_RefreshRate = 0.0;
+                    CGDisplayModeRef mode = CGDisplayCopyDisplayMode(display);
+                    if (mode != nullptr)
+                    {
+                        m_RefreshRate = CGDisplayModeGetRefreshRate(mode);
+                        CGDisplayModeRelease(mode);
+                    }
+                    // Built in panels report 0, ask the screen instead
+                    if (m_RefreshRate <= 0.0)
+                    {
+                        if (@available(macOS 12.0, *))
+                            m_RefreshRate = static_cast<double>([screen maximumFramesPerSecond]);
+                    }
+                }
             }
+            // The vblank phase would need a CVDisplayLink, we only report the rate
+            timing.RefreshRate = m_RefreshRate;
+            return timing;
         }
 
-        inline void SetCursorMode(CursorMode mode) const
+        inline void SetCursorImage(const ImageView& image, std::uint32_t hotspotX, std::uint32_t hotspotY)
+        {
+            const std::uint64_t hash = HashImage(image, (static_cast<std::uint64_t>(hotspotX) << 32) | hotspotY);
+            NSCursor* cursor = m_Cursors.GetOrCreate(hash, [&]() -> NSCursor*
+            {
+                NSImage* cursorImage = CreateImage(image);
+                if (cursorImage == nil)
+                    return nil;
+                NSCursor* created = [[NSCursor alloc] initWithImage:cursorImage hotSpot:NSMakePoint(hotspotX, hotspotY)];
+                [cursorImage release];
+                return created;
+            });
+            if (cursor != nil)
+                [m_View setCurrentCursor:cursor];
+        }
+
+        inline void SetIcon(std::span<const ImageView> images)
+        {
+            // Windows don't have their own icons on macOS, the Dock shows the application's, so the biggest image is used
+            const ImageView* biggest = nullptr;
+            for (const auto& image : images)
+            {
+                if (image.IsValid() && (biggest == nullptr || image.Width > biggest->Width))
+                    biggest = &image;
+            }
+            NSImage* icon = nil;
+            if (biggest != nullptr)
+                icon = m_Icons.GetOrCreate(HashImage(*biggest), [&]() { return CreateImage(*biggest); });
+            [NSApp setApplicationIconImage:icon]; // nil restores the bundle's icon
+        }
+
+        inline bool SetClipboard(std::vector<std::string> formats, ClipboardProvider&& provider)
         {
-            static CursorMode currentMode = CursorMode::Normal;
-            if (mode == currentMode)
-                return;
-            currentMode = mode;
             @autoreleasepool {
-                if (mode == CursorMode::Normal)
-                    [NSCursor unhide];
-                else
-                    [NSCursor hide];
+                [m_ClipboardProvider release];
+                m_ClipboardProvider = [[PulsarionClipboardProvider alloc] initWithState:m_State formats:std::move(formats) provider:std::move(provider)];
+                NSPasteboard* pasteboard = [NSPasteboard generalPasteboard];
+                [pasteboard clearContents];
+                // Only promises the types, the provider is asked for the data when someone pastes
+                const bool written = [pasteboard writeObjects:@[[m_ClipboardProvider makeItem]]];
+                m_ClipboardChangeCount = [pasteboard changeCount];
+                return written;
+            }
+        }
+
+        inline bool HasClipboardFormat(std::string_view format) const
+        {
+            @autoreleasepool {
+                return [[NSPasteboard generalPasteboard] availableTypeFromArray:@[GetPasteboardType(format)]] != nil;
+            }
+        }
+
+        inline void ServeClipboardRequests() const
+        {
+            // Moved out since a receiver may request again
+            auto requests = std::move(m_State->ClipboardRequests);
+            m_State->ClipboardRequests.clear();
+            @autoreleasepool {
+                NSPasteboard* pasteboard = [NSPasteboard generalPasteboard];
+                for (const auto& request : requests)
+                {
+                    // Blocks can't capture structured bindings
+                    const ClipboardReceiver& receiver = request.second;
+                    NSData* data = [pasteboard dataForType:GetPasteboardType(request.first)];
+                    if (data == nil)
+                    {
+                        receiver(m_State->UserData, {}, ClipboardStatus::Unavailable);
+                        continue;
+                    }
+                    const std::size_t total = [data length];
+                    if (total == 0)
+                    {
+                        receiver(m_State->UserData, {}, ClipboardStatus::Done);
+                        continue;
+                    }
+                    // Large data can be made of several ranges, walking them avoids the flat copy [data bytes] would make
+                    __block std::size_t delivered = 0;
+                    void* userData = m_State->UserData;
+                    [data enumerateByteRangesUsingBlock:^(const void* bytes, NSRange range, BOOL* stop) {
+                        const auto* begin = static_cast<const std::byte*>(bytes);
+                        for (std::size_t offset = 0; offset < range.length; offset += ClipboardChunkSize)
+                        {
+                            const std::size_t size = std::min(ClipboardChunkSize, range.length - offset);
+                            delivered += size;
+                            receiver(userData, { begin + offset, size }, delivered == total ? ClipboardStatus::Done : ClipboardStatus::More);
+                        }
+                    }];
+                }
             }
         }
 
         inline void PollEvents() const
         {
+            if (m_State->LoopWatchdog)
+                m_State->LoopWatchdog->BeginFrame();
             #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
             m_State->LimitedEvents = 0;
             #endif
@@ -136,6 +345,71 @@ namespace Pulsarion::Windowing
                         [NSApp sendEvent:event];
                 } while (event);
             }
+
+            if (m_State->ResizePending)
+            {
+                m_State->ResizePending = false;
+                if (m_State->PendingWidth != m_State->Width || m_State->PendingHeight != m_State->Height)
+                {
+                    m_State->Width = m_State->PendingWidth;
+                    m_State->Height = m_State->PendingHeight;
+                    m_State->SizeGeneration++;
+                    if (m_State->OnResize && m_State->Wants(EventType::Resize))
+                        m_State->OnResize(m_State->UserData, m_State->Width, m_State->Height);
+                }
+            }
+
+            if (m_State->ResizeEnded)
+            {
+                m_State->ResizeEnded = false;
+                if (m_State->AfterResize && m_State->Wants(EventType::AfterResize))
+                    m_State->AfterResize(m_State->UserData, m_State->Width, m_State->Height);
+            }
+
+            if (!m_State->TextInput.Empty())
+            {
+                if (m_State->OnTextInput)
+                    m_State->OnTextInput(m_State->UserData, m_State->TextInput.View());
+                m_State->TextInput.Clear();
+            }
+
+            if (!m_State->RawMotionSamples.empty())
+            {
+                if (m_State->OnRawMouseMove)
+                    m_State->OnRawMouseMove(m_State->UserData, m_State->RawMotion, m_State->RawMotionSamples);
+                m_State->RawMotion = { 0.0f, 0.0f };
+                m_State->RawMotionSamples.clear();
+            }
+
+            if (m_State->Touches.HasChanges())
+            {
+                if (m_State->OnTouch && m_State->Wants(EventType::Touch))
+                    m_State->OnTouch(m_State->UserData, m_State->Touches.View());
+                m_State->Touches.Flush();
+            }
+
+            if (!m_State->ClipboardRequests.empty())
+                ServeClipboardRequests();
+
+            m_State->Timers.Dispatch(m_State->UserData);
+
+            // Back in the application's hands until the next PollEvents
+            if (m_State->LoopWatchdog)
+                m_State->LoopWatchdog->Beat(LoopPhase::Frame);
+        }
+
+        inline void WaitEvents(std::optional<std::chrono::nanoseconds> timeout) const
+        {
+            timeout = m_State->Timers.ClampTimeout(timeout);
+            if (m_State->LoopWatchdog)
+                m_State->LoopWatchdog->Beat(LoopPhase::Waiting);
+            @autoreleasepool {
+                NSDate* until = timeout.has_value() ? [NSDate dateWithTimeIntervalSinceNow:std::chrono::duration<double>(*timeout).count()] : [NSDate distantFuture];
+                NSEvent* event = [NSApp nextEventMatchingMask:NSEventMaskAny untilDate:until inMode:NSDefaultRunLoopMode dequeue:YES];
+                if (event)
+                    [NSApp sendEvent:event];
+            }
+            PollEvents(); // Drains the rest and dispatches the timers
         }
     };
     CocoaWindow::CocoaWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config)
@@ -158,6 +432,21 @@ namespace Pulsarion::Windowing
         m_Impl->PollEvents();
     }
 
+    void CocoaWindow::WaitEvents(std::optional<std::chrono::nanoseconds> timeout)
+    {
+        m_Impl->WaitEvents(timeout);
+    }
+
+    TimerId CocoaWindow::AddTimer(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat)
+    {
+        return m_Impl->m_State->Timers.Add(period, std::move(callback), repeat);
+    }
+
+    void CocoaWindow::RemoveTimer(TimerId id)
+    {
+        m_Impl->m_State->Timers.Remove(id);
+    }
+
     bool CocoaWindow::ShouldClose() const
     {
         PULSARION_ASSERT([NSApp isKindOfClass:[PulsarionApplication class]], "NSApp is not of type PulsarionApplication");
@@ -176,7 +465,14 @@ namespace Pulsarion::Windowing
 
     std::optional<std::string> CocoaWindow::GetTitle() const
     {
-        return m_Impl->GetTitle();
+        if (m_Impl->m_Title.empty())
+            return std::nullopt;
+        return m_Impl->m_Title;
+    }
+
+    std::string_view CocoaWindow::GetTitleView() const
+    {
+        return m_Impl->m_Title;
     }
 
     void* CocoaWindow::GetNativeWindow() const
@@ -201,7 +497,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnClose = std::move(callback);
     }
 
-    Window::CloseCallback CocoaWindow::GetOnClose() const
+    const Window::CloseCallback& CocoaWindow::GetOnClose() const
     {
         return m_Impl->m_State->OnClose;
     }
@@ -211,7 +507,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnWindowVisibility = std::move(callback);
     }
 
-    Window::VisibilityCallback CocoaWindow::GetOnWindowVisibility() const
+    const Window::VisibilityCallback& CocoaWindow::GetOnWindowVisibility() const
     {
         return m_Impl->m_State->OnWindowVisibility;
     }
@@ -221,7 +517,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnFocus = std::move(callback);
     }
 
-    Window::FocusCallback CocoaWindow::GetOnFocus() const
+    const Window::FocusCallback& CocoaWindow::GetOnFocus() const
     {
         return m_Impl->m_State->OnFocus;
     }
@@ -231,7 +527,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnResize = std::move(callback);
     }
 
-    Window::ResizeCallback CocoaWindow::GetOnResize() const
+    const Window::ResizeCallback& CocoaWindow::GetOnResize() const
     {
         return m_Impl->m_State->OnResize;
     }
@@ -241,7 +537,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnMove = std::move(callback);
     }
 
-    Window::MoveCallback CocoaWindow::GetOnMove() const
+    const Window::MoveCallback& CocoaWindow::GetOnMove() const
     {
         return m_Impl->m_State->OnMove;
     }
@@ -251,17 +547,27 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->BeforeResize = std::move(callback);
     }
 
-    Window::BeforeResizeCallback CocoaWindow::GetBeforeResize() const
+    const Window::BeforeResizeCallback& CocoaWindow::GetBeforeResize() const
     {
         return m_Impl->m_State->BeforeResize;
     }
 
+    void CocoaWindow::SetAfterResize(Window::AfterResizeCallback&& callback)
+    {
+        m_Impl->m_State->AfterResize = std::move(callback);
+    }
+
+    const Window::AfterResizeCallback& CocoaWindow::GetAfterResize() const
+    {
+        return m_Impl->m_State->AfterResize;
+    }
+
     void CocoaWindow::SetOnMinimize(Window::MinimizeCallback&& callback)
     {
         m_Impl->m_State->OnMinimize = std::move(callback);
     }
 
-    Window::MinimizeCallback CocoaWindow::GetOnMinimize() const
+    const Window::MinimizeCallback& CocoaWindow::GetOnMinimize() const
     {
         return m_Impl->m_State->OnMinimize;
     }
@@ -271,7 +577,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnMaximize = std::move(callback);
     }
 
-    Window::MaximizeCallback CocoaWindow::GetOnMaximize() const
+    const Window::MaximizeCallback& CocoaWindow::GetOnMaximize() const
     {
         return m_Impl->m_State->OnMaximize;
     }
@@ -281,7 +587,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnFullscreen = std::move(callback);
     }
 
-    Window::FullscreenCallback CocoaWindow::GetOnFullscreen() const
+    const Window::FullscreenCallback& CocoaWindow::GetOnFullscreen() const
     {
         return m_Impl->m_State->OnFullscreen;
     }
@@ -291,17 +597,27 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnRestore = std::move(callback);
     }
 
-    Window::RestoreCallback CocoaWindow::GetOnRestore() const
+    const Window::RestoreCallback& CocoaWindow::GetOnRestore() const
     {
         return m_Impl->m_State->OnRestore;
     }
 
+    void CocoaWindow::SetOnOcclusion(Window::OcclusionCallback&& callback)
+    {
+        m_Impl->m_State->OnOcclusion = std::move(callback);
+    }
+
+    const Window::OcclusionCallback& CocoaWindow::GetOnOcclusion() const
+    {
+        return m_Impl->m_State->OnOcclusion;
+    }
+
     void CocoaWindow::SetOnMouseEnter(Window::MouseEnterCallback&& callback)
     {
         m_Impl->m_State->OnMouseEnter = std::move(callback);
     }
 
-    Window::MouseEnterCallback CocoaWindow::GetOnMouseEnter() const
+    const Window::MouseEnterCallback& CocoaWindow::GetOnMouseEnter() const
     {
         return m_Impl->m_State->OnMouseEnter;
     }
@@ -311,7 +627,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnMouseLeave = std::move(callback);
     }
 
-    Window::MouseLeaveCallback CocoaWindow::GetOnMouseLeave() const
+    const Window::MouseLeaveCallback& CocoaWindow::GetOnMouseLeave() const
     {
         return m_Impl->m_State->OnMouseLeave;
     }
@@ -321,7 +637,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnMouseDown = std::move(callback);
     }
 
-    Window::MouseDownCallback CocoaWindow::GetOnMouseDown() const
+    const Window::MouseDownCallback& CocoaWindow::GetOnMouseDown() const
     {
         return m_Impl->m_State->OnMouseDown;
     }
@@ -331,7 +647,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnMouseUp = std::move(callback);
     }
 
-    Window::MouseUpCallback CocoaWindow::GetOnMouseUp() const
+    const Window::MouseUpCallback& CocoaWindow::GetOnMouseUp() const
     {
         return m_Impl->m_State->OnMouseUp;
     }
@@ -341,7 +657,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnMouseMove = std::move(callback);
     }
 
-    Window::MouseMoveCallback CocoaWindow::GetOnMouseMove() const
+    const Window::MouseMoveCallback& CocoaWindow::GetOnMouseMove() const
     {
         return m_Impl->m_State->OnMouseMove;
     }
@@ -351,17 +667,37 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnMouseWheel = std::move(callback);
     }
 
-    Window::MouseWheelCallback CocoaWindow::GetOnMouseWheel() const
+    const Window::MouseWheelCallback& CocoaWindow::GetOnMouseWheel() const
     {
         return m_Impl->m_State->OnMouseWheel;
     }
 
+    void CocoaWindow::SetOnRawMouseMove(Window::RawMouseMoveCallback&& callback)
+    {
+        m_Impl->m_State->OnRawMouseMove = std::move(callback);
+    }
+
+    const Window::RawMouseMoveCallback& CocoaWindow::GetOnRawMouseMove() const
+    {
+        return m_Impl->m_State->OnRawMouseMove;
+    }
+
+    void CocoaWindow::SetOnTouch(Window::TouchCallback&& callback)
+    {
+        m_Impl->m_State->OnTouch = std::move(callback);
+    }
+
+    const Window::TouchCallback& CocoaWindow::GetOnTouch() const
+    {
+        return m_Impl->m_State->OnTouch;
+    }
+
     void CocoaWindow::SetOnKeyDown(Window::KeyDownCallback&& callback)
     {
         m_Impl->m_State->OnKeyDown = std::move(callback);
     }
 
-    Window::KeyDownCallback CocoaWindow::GetOnKeyDown() const
+    const Window::KeyDownCallback& CocoaWindow::GetOnKeyDown() const
     {
         return m_Impl->m_State->OnKeyDown;
     }
@@ -371,7 +707,7 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnKeyUp = std::move(callback);
     }
 
-    Window::KeyUpCallback CocoaWindow::GetOnKeyUp() const
+    const Window::KeyUpCallback& CocoaWindow::GetOnKeyUp() const
     {
         return m_Impl->m_State->OnKeyUp;
     }
@@ -381,11 +717,21 @@ namespace Pulsarion::Windowing
         m_Impl->m_State->OnKeyTyped = std::move(callback);
     }
 
-    Window::KeyTypedCallback CocoaWindow::GetOnKeyTyped() const
+    const Window::KeyTypedCallback& CocoaWindow::GetOnKeyTyped() const
     {
         return m_Impl->m_State->OnKeyTyped;
     }
 
+    void CocoaWindow::SetOnTextInput(Window::TextInputCallback&& callback)
+    {
+        m_Impl->m_State->OnTextInput = std::move(callback);
+    }
+
+    const Window::TextInputCallback& CocoaWindow::GetOnTextInput() const
+    {
+        return m_Impl->m_State->OnTextInput;
+    }
+
     void CocoaWindow::SetUserData(void* userData)
     {
         m_Impl->m_State->UserData = userData;
@@ -401,6 +747,67 @@ namespace Pulsarion::Windowing
         m_Impl->SetCursorMode(mode);
     }
 
+    void CocoaWindow::SetCursorShape(CursorShape shape)
+    {
+        [m_Impl->m_View setCurrentCursor:GetShapeCursor(shape)];
+    }
+
+    void CocoaWindow::SetCursorImage(const ImageView& image, std::uint32_t hotspotX, std::uint32_t hotspotY)
+    {
+        m_Impl->SetCursorImage(image, hotspotX, hotspotY);
+    }
+
+    void CocoaWindow::SetIcon(std::span<const ImageView> images)
+    {
+        m_Impl->SetIcon(images);
+    }
+
+    void CocoaWindow::SetEventMask(EventTypeFlags mask)
+    {
+        m_Impl->SetEventMask(mask);
+    }
+
+    EventTypeFlags CocoaWindow::GetEventMask() const
+    {
+        return m_Impl->m_State->EventMask;
+    }
+
+    std::uint64_t CocoaWindow::GetSizeGeneration() const
+    {
+        return m_Impl->m_State->SizeGeneration;
+    }
+
+    WindowSize CocoaWindow::GetContentSize() const
+    {
+        return { m_Impl->m_State->Width, m_Impl->m_State->Height };
+    }
+
+    DisplayTiming CocoaWindow::GetDisplayTiming() const
+    {
+        return m_Impl->GetDisplayTiming();
+    }
+
+    void CocoaWindow::SetWatchdog(Watchdog* watchdog)
+    {
+        m_Impl->m_State->LoopWatchdog = watchdog;
+    }
+
+    bool CocoaWindow::SetClipboard(std::vector<std::string> formats, ClipboardProvider&& provider)
+    {
+        return m_Impl->SetClipboard(std::move(formats), std::move(provider));
+    }
+
+    void CocoaWindow::RequestClipboard(std::string format, ClipboardReceiver&& receiver)
+    {
+        if (receiver)
+            m_Impl->m_State->ClipboardRequests.emplace_back(std::move(format), std::move(receiver));
+    }
+
+    bool CocoaWindow::HasClipboardFormat(std::string_view format) const
+    {
+        return m_Impl->HasClipboardFormat(format);
+    }
+
 
     std::shared_ptr<Window> CreateSharedWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config, std::optional<WindowEvents> events)
     {
@@ -417,4 +824,21 @@ namespace Pulsarion::Windowing
             SetWindowEvents(*window, *events);
         return window;
     }
+
+    std::vector<std::unique_ptr<Window>> CreateWindows(std::span<WindowDesc> descs)
+    {
+        std::vector<std::unique_ptr<Window>> windows;
+        windows.reserve(descs.size());
+        @autoreleasepool {
+            // The first window finishes launching the application, every other one only creates its NSWindow
+            for (auto& desc : descs)
+            {
+                auto window = std::make_unique<CocoaWindow>(std::move(desc.Title), desc.Bounds, desc.Styles, desc.Config);
+                if (desc.Events.has_value())
+                    SetWindowEvents(*window, *desc.Events);
+                windows.push_back(std::move(window));
+            }
+        }
+        return windows;
+    }
 }
@@ -22,43 +22,36 @@
 }
 
 - (void)windowDidResize:(NSNotification *)notification {
-    #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
-    if (m_State->LimitEvents)
-    {
-        if ((m_State->LimitedEvents & m_State->WINDOW_RESIZE_EVENT) == 0)
-            return;
-        m_State->LimitedEvents |= m_State->WINDOW_RESIZE_EVENT;
-    }
-    #endif
-
-    if (m_State->OnResize)
-    {
-        auto frame = [[notification object] frame];
-        m_State->OnResize(m_State->UserData, static_cast<std::uint32_t>(frame.size.width), static_cast<std::uint32_t>(frame.size.height));
-    }
+    // The content size, the frame also includes the title bar. Reported (once per poll) by PollEvents
+    NSWindow* window = [notification object];
+    const NSRect content = [window contentRectForFrameRect:[window frame]];
+    m_State->PendingWidth = static_cast<std::uint32_t>(content.size.width);
+    m_State->PendingHeight = static_cast<std::uint32_t>(content.size.height);
+    m_State->ResizePending = true;
 }
 
 - (void)windowWillStartLiveResize:(NSNotification *)notification {
-    if (m_State->BeforeResize)
-    {
-        NSRect frame = [[notification object] frame];
+    if (m_State->BeforeResize && m_State->Wants(Pulsarion::Windowing::EventType::BeforeResize))
         m_State->BeforeResize(m_State->UserData);
-    }
+}
+
+- (void)windowDidEndLiveResize:(NSNotification *)notification {
+    m_State->ResizeEnded = true;
 }
 
 - (void)windowDidBecomeMain:(NSNotification *)notification {
-    if (m_State->OnFocus)
+    if (m_State->OnFocus && m_State->Wants(Pulsarion::Windowing::EventType::Focus))
         m_State->OnFocus(m_State->UserData, true);
 }
 
 - (void)windowDidResignMain:(NSNotification *)notification {
-    if (m_State->OnFocus)
+    if (m_State->OnFocus && m_State->Wants(Pulsarion::Windowing::EventType::Focus))
         m_State->OnFocus(m_State->UserData, false);
 }
 
 
 - (void)windowDidMove:(NSNotification *)notification {
-    if (m_State->OnMove)
+    if (m_State->OnMove && m_State->Wants(Pulsarion::Windowing::EventType::Move))
     {
         NSRect frame = [[notification object] frame];
         m_State->OnMove(m_State->UserData, static_cast<std::uint32_t>(frame.origin.x), static_cast<std::uint32_t>(frame.origin.y));
@@ -66,32 +59,40 @@
 }
 
 - (void)windowDidMiniaturize:(NSNotification *)notification {
-    if (m_State->OnMinimize)
+    if (m_State->OnMinimize && m_State->Wants(Pulsarion::Windowing::EventType::Minimize))
         m_State->OnMinimize(m_State->UserData);
 }
 
 - (void)windowDidDeminiaturize:(NSNotification *)notification {
-    if (m_State->OnRestore)
+    if (m_State->OnRestore && m_State->Wants(Pulsarion::Windowing::EventType::Restore))
         m_State->OnRestore(m_State->UserData);
 }
 
 - (void)windowDidMaximize:(NSNotification *)notification {
-    if (m_State->OnMaximize)
+    if (m_State->OnMaximize && m_State->Wants(Pulsarion::Windowing::EventType::Maximize))
         m_State->OnMaximize(m_State->UserData);
 }
 
 - (void)windowDidDemaximize:(NSNotification *)notification {
-    if (m_State->OnRestore)
+    if (m_State->OnRestore && m_State->Wants(Pulsarion::Windowing::EventType::Restore))
         m_State->OnRestore(m_State->UserData);
 }
 
+- (void)windowDidChangeOcclusionState:(NSNotification *)notification {
+    if (m_State->OnOcclusion && m_State->Wants(Pulsarion::Windowing::EventType::Occlusion))
+    {
+        const bool occluded = ([[notification object] occlusionState] & NSWindowOcclusionStateVisible) == 0;
+        m_State->OnOcclusion(m_State->UserData, occluded);
+    }
+}
+
 - (void)windowDidEnterFullScreen:(NSNotification *)notification {
-    if (m_State->OnFullscreen)
+    if (m_State->OnFullscreen && m_State->Wants(Pulsarion::Windowing::EventType::Fullscreen))
         m_State->OnFullscreen(m_State->UserData, true);
 }
 
 - (void)windowDidExitFullScreen:(NSNotification *)notification {
-    if (m_State->OnFullscreen)
+    if (m_State->OnFullscreen && m_State->Wants(Pulsarion::Windowing::EventType::Fullscreen))
         m_State->OnFullscreen(m_State->UserData, false);
 }
 @end
@@ -0,0 +1,101 @@
+#include "MappedFile.hpp"
+
+#ifdef PULSARION_PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Pulsarion::Windowing
+{
+#ifdef PULSARION_PLATFORM_WINDOWS
+    std::optional<MappedFile> MappedFile::Open(const std::filesystem::path& path)
+    {
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return std::nullopt;
+
+        MappedFile mapped;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return std::nullopt;
+        }
+        if (size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return mapped; // CreateFileMapping fails for empty files
+        }
+
+        // The mapping keeps the file open, its handle isn't needed after this
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+            return std::nullopt;
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            CloseHandle(mapping);
+            return std::nullopt;
+        }
+
+        mapped.m_Data = static_cast<const std::byte*>(view);
+        mapped.m_Size = static_cast<std::size_t>(size.QuadPart);
+        mapped.m_Mapping = mapping;
+        return mapped;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data != nullptr)
+            UnmapViewOfFile(m_Data);
+        if (m_Mapping != nullptr)
+            CloseHandle(m_Mapping);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Mapping = nullptr;
+    }
+#else
+    std::optional<MappedFile> MappedFile::Open(const std::filesystem::path& path)
+    {
+        const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+            return std::nullopt;
+
+        MappedFile mapped;
+        struct stat info = {};
+        if (fstat(file, &info) != 0)
+        {
+            close(file);
+            return std::nullopt;
+        }
+        if (info.st_size == 0)
+        {
+            close(file);
+            return mapped; // mmap fails for a length of 0
+        }
+
+        // The mapping keeps its own reference to the file
+        void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (view == MAP_FAILED)
+            return std::nullopt;
+
+        mapped.m_Data = static_cast<const std::byte*>(view);
+        mapped.m_Size = static_cast<std::size_t>(info.st_size);
+        return mapped;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data != nullptr)
+            munmap(const_cast<std::byte*>(m_Data), m_Size);
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+#endif
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace Pulsarion::Windowing
+{
+    /*!
+     * @brief A read only view of a whole file mapped into memory, so cursor and icon pixels can be used without reading them into a buffer.
+     * The pages are loaded by the OS when they are first touched and shared with every other process mapping the same file.
+     */
+    class PULSARION_WINDOWING_API MappedFile
+    {
+    public:
+        // std::nullopt when the file can't be opened or mapped. An empty file maps to an empty span.
+        [[nodiscard]] static std::optional<MappedFile> Open(const std::filesystem::path& path);
+
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept
+            : m_Data(std::exchange(other.m_Data, nullptr)), m_Size(std::exchange(other.m_Size, 0)), m_Mapping(std::exchange(other.m_Mapping, nullptr)) { }
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Close();
+                m_Data = std::exchange(other.m_Data, nullptr);
+                m_Size = std::exchange(other.m_Size, 0);
+                m_Mapping = std::exchange(other.m_Mapping, nullptr);
+            }
+            return *this;
+        }
+
+        void Close();
+
+        [[nodiscard]] std::span<const std::byte> GetData() const { return { m_Data, m_Size }; }
+        [[nodiscard]] std::size_t GetSize() const { return m_Size; }
+
+    private:
+        const std::byte* m_Data = nullptr;
+        std::size_t m_Size = 0;
+        void* m_Mapping = nullptr; // The file mapping handle on Windows, unused on POSIX
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+// The window backend of the platform we are compiled for. The backends are final, so calls made through a NativeWindow
+// (or a template parameter bound to it) are direct and can be inlined, while Window stays available as the type erased interface.
+// Note that on Windows this pulls in <Windows.h>.
+
+#include "Core.hpp"
+
+#if defined(PULSARION_PLATFORM_WINDOWS)
+#include "Windows/Window.hpp"
+#elif defined(PULSARION_PLATFORM_MACOS)
+#include "MacOS/Window.hpp"
+#endif
+
+namespace Pulsarion::Windowing
+{
+#if defined(PULSARION_PLATFORM_WINDOWS)
+    using NativeWindow = WindowsWindow;
+#elif defined(PULSARION_PLATFORM_MACOS)
+    using NativeWindow = CocoaWindow;
+#endif
+}
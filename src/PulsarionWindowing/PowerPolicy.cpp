@@ -0,0 +1,63 @@
+#include "PowerPolicy.hpp"
+
+#include "PulsarionCore/Assert.hpp"
+
+#include <limits>
+
+namespace Pulsarion::Windowing
+{
+    PowerPolicy::PowerPolicy(EventBus& bus, PowerPolicyConfig config)
+        : m_Bus(bus), m_Config(config)
+    {
+        PULSARION_ASSERT(bus.GetWindow() != nullptr, "The event bus must be attached to a window");
+
+        // First in line and never consuming, so listeners that consume can't hide state changes from us
+        constexpr std::int32_t priority = std::numeric_limits<std::int32_t>::max();
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Focus>([this](void*, bool focused) { m_Focused = focused; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::WindowVisibility>([this](void*, bool visible) { m_Visible = visible; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Minimize>([this](void*) { m_Minimized = true; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Restore>([this](void*) { m_Minimized = false; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Maximize>([this](void*) { m_Minimized = false; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Occlusion>([this](void*, bool occluded) { m_Occluded = occluded; return false; }, priority));
+
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseMove>([this](void*, Point) { m_InputPending = true; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseDown>([this](void*, Point, MouseCode) { m_InputPending = true; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::MouseWheel>([this](void*, Point, ScrollOffset) { m_InputPending = true; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::KeyDown>([this](void*, KeyCode, Modifier, bool) { m_InputPending = true; return false; }, priority));
+        m_Subscriptions.push_back(bus.Subscribe<EventType::Touch>([this](void*, std::span<const TouchContact>) { m_InputPending = true; return false; }, priority));
+    }
+
+    PowerState PowerPolicy::Update(std::chrono::steady_clock::time_point now)
+    {
+        if (m_InputPending)
+        {
+            m_InputPending = false;
+            m_LastInput = now;
+        }
+
+        PowerState state = PowerState::Active;
+        if (m_Minimized || !m_Visible || m_Occluded)
+            state = PowerState::Hidden;
+        else if (!m_Focused && now - m_LastInput >= m_Config.InputBoost)
+            state = PowerState::Unfocused;
+
+        // The time since the last frame is booked to the state that frame ran in
+        if (m_HasUpdated)
+            m_Stats.Time[static_cast<std::size_t>(m_State)] += std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_LastUpdate);
+        else
+            m_LastFrameEnd = now;
+        m_HasUpdated = true;
+        m_LastUpdate = now;
+
+        if (state != m_State)
+            m_Stats.Transitions++;
+        m_State = state;
+        m_Stats.Frames[static_cast<std::size_t>(state)]++;
+        return state;
+    }
+
+    void PowerPolicy::Wait()
+    {
+        m_Bus.GetWindow()->WaitEvents(m_Config.HiddenTimeout);
+    }
+}
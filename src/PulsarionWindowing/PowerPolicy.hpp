@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Clock.hpp"
+#include "EventBus.hpp"
+#include "FrameLimiter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    enum class PowerState : std::uint8_t
+    {
+        Active = 0, // Full rate
+        Unfocused, // Another window has focus and there was no recent input
+        Hidden, // Minimized, hidden or occluded, nothing we render can be seen
+        Count
+    };
+
+    constexpr std::size_t PowerStateCount = static_cast<std::size_t>(PowerState::Count);
+
+    constexpr std::string_view PowerStateToString(PowerState state)
+    {
+        constexpr std::array<std::string_view, PowerStateCount> names = { "Active", "Unfocused", "Hidden" };
+        const auto index = static_cast<std::size_t>(state);
+        return index < names.size() ? names[index] : "Unknown";
+    }
+
+    struct PowerPolicyConfig
+    {
+        std::uint32_t UnfocusedFps = 10;
+        // How long a hidden window sleeps in WaitEvents, std::nullopt waits until an event (or a timer) wakes it
+        std::optional<std::chrono::nanoseconds> HiddenTimeout = std::nullopt;
+        // Input keeps an unfocused window at full rate for this long, hovering or scrolling works without focus
+        std::chrono::nanoseconds InputBoost = std::chrono::milliseconds(500);
+    };
+
+    struct PowerStats
+    {
+        std::array<std::chrono::nanoseconds, PowerStateCount> Time = {}; // Time spent in each state
+        std::array<std::uint64_t, PowerStateCount> Frames = {};
+        std::uint64_t Transitions = 0;
+    };
+
+    /*!
+     * @brief Lowers the frame rate while nobody is looking: UnfocusedFps without focus, a blocking WaitEvents while minimized, hidden or occluded.
+     * It listens on an attached EventBus (with the highest priority and without consuming anything), so it sees focus, minimize, restore,
+     * visibility, occlusion and input no matter what else is subscribed. Call EndFrame instead of FrameLimiter::EndFrame, the full rate
+     * is back on the first frame after a restore or input, since those events also wake the blocking wait.
+     */
+    class PULSARION_WINDOWING_API PowerPolicy
+    {
+    public:
+        explicit PowerPolicy(EventBus& bus, PowerPolicyConfig config = {});
+
+        PowerPolicy(const PowerPolicy&) = delete;
+        PowerPolicy& operator=(const PowerPolicy&) = delete;
+
+        template<Clock ClockType>
+        void EndFrame(BasicFrameLimiter<ClockType>& limiter)
+        {
+            const auto& clock = limiter.GetClock();
+            const auto now = clock.Now();
+            const PowerState state = Update(now);
+            if (state == PowerState::Active)
+                limiter.EndFrame(); // Keeps display sync and its own pacing untouched
+            else if (state == PowerState::Unfocused)
+                clock.SleepUntil(m_LastFrameEnd + std::chrono::nanoseconds(std::chrono::seconds(1)) / std::max<std::uint32_t>(m_Config.UnfocusedFps, 1));
+            else
+                Wait();
+            m_LastFrameEnd = clock.Now();
+        }
+
+        [[nodiscard]] PowerState GetState() const { return m_State; }
+        [[nodiscard]] const PowerStats& GetStats() const { return m_Stats; } // Updated by EndFrame
+        [[nodiscard]] const PowerPolicyConfig& GetConfig() const { return m_Config; }
+        void SetConfig(const PowerPolicyConfig& config) { m_Config = config; }
+
+    private:
+        PowerState Update(std::chrono::steady_clock::time_point now);
+        void Wait();
+
+        EventBus& m_Bus;
+        PowerPolicyConfig m_Config;
+        std::vector<Subscription> m_Subscriptions;
+
+        // Set by the listeners
+        bool m_Focused = true;
+        bool m_Minimized = false;
+        bool m_Visible = true;
+        bool m_Occluded = false;
+        bool m_InputPending = false;
+
+        PowerState m_State = PowerState::Active;
+        std::chrono::steady_clock::time_point m_LastInput;
+        std::chrono::steady_clock::time_point m_LastUpdate;
+        std::chrono::steady_clock::time_point m_LastFrameEnd;
+        bool m_HasUpdated = false;
+        PowerStats m_Stats;
+    };
+}
@@ -0,0 +1,183 @@
+#pragma once
+// Shared memory event and framebuffer channel between a window host process and an application process. Linux only.
+
+#include "Core.hpp"
+#include "EventBus.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    // One window event as it travels through the ring, the fields that don't apply to the type are zero
+    struct RemoteEvent
+    {
+        static constexpr std::size_t TextCapacity = 24;
+
+        EventType Type = EventType::Count;
+        Modifier Modifiers = 0;
+        bool Flag = false; // Focused, visible, fullscreen, occluded, or the key repeat
+        MouseCode Button = MouseCode::Unknown;
+        KeyCode Key = KeyCode::Unknown;
+        std::uint8_t TextSize = 0;
+        std::uint32_t X = 0; // The width for resizes, the position for moves
+        std::uint32_t Y = 0;
+        Point Position = { 0.0f, 0.0f };
+        Point Offset = { 0.0f, 0.0f }; // The scroll offset, or the summed raw motion
+        char Text[TextCapacity] = {}; // Text input is split into several events, never inside a UTF-8 sequence
+    };
+    static_assert(std::is_trivially_copyable_v<RemoteEvent> && sizeof(RemoteEvent) <= 64, "Ring slots are copied as plain bytes");
+
+    struct SharedChannelConfig
+    {
+        std::uint32_t EventCapacity = 4096; // Rounded up to a power of two
+        std::uint32_t MaxWidth = 1920; // The framebuffers are allocated for this size, frames can be smaller
+        std::uint32_t MaxHeight = 1080;
+    };
+
+    // A presented frame, straight RGBA8 rows of Stride bytes. Valid until the next AcquireFrame.
+    struct SharedFrame
+    {
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+        std::uint32_t Stride = 0;
+        std::uint64_t Sequence = 0;
+        std::span<const std::byte> Pixels;
+    };
+
+    /*!
+     * @brief A memfd holding an event ring (host to client) and three framebuffers (client to host), with an eventfd signalling each direction.
+     * The host creates it and hands the three fds to the client process with SCM_RIGHTS, or clears FD_CLOEXEC on them before exec. Both sides only ever touch the
+     * mapping: events are copied once into the ring, the client renders straight into its back buffer and presenting is an index swap,
+     * so the only frame copy left is the host's final present. Signalling costs at most one eventfd write per side and frame.
+     * Either side can die without hurting the other, the host keeps showing the last frame and sees the client's heartbeat stop.
+     * The memfd is sealed against resizing, so a client can't make the host fault by truncating it.
+     */
+    class PULSARION_WINDOWING_API SharedChannel
+    {
+    public:
+        // Host side
+        [[nodiscard]] static std::optional<SharedChannel> Create(const SharedChannelConfig& config = {});
+        // Client side, takes ownership of the fds and checks the layout
+        [[nodiscard]] static std::optional<SharedChannel> Adopt(int memoryFd, int eventFd, int frameFd);
+
+        SharedChannel() = default;
+        ~SharedChannel() { Close(); }
+
+        SharedChannel(const SharedChannel&) = delete;
+        SharedChannel& operator=(const SharedChannel&) = delete;
+        SharedChannel(SharedChannel&& other) noexcept { *this = std::move(other); }
+        SharedChannel& operator=(SharedChannel&& other) noexcept;
+
+        void Close();
+
+        [[nodiscard]] int GetMemoryFd() const { return m_MemoryFd; }
+        [[nodiscard]] int GetEventFd() const { return m_EventFd; } // Readable when the host flushed events, register it with an EventLoop
+        [[nodiscard]] int GetFrameFd() const { return m_FrameFd; } // Readable when the client presented a frame
+
+        // ----- Host -----
+        // false when the ring is full, the event is dropped and counted
+        bool PushEvent(const RemoteEvent& event);
+        // Wakes the client if anything was pushed since the last flush, call it once per PollEvents
+        void FlushEvents();
+        // The newest presented frame, std::nullopt if nothing new was presented since the last call
+        [[nodiscard]] std::optional<SharedFrame> AcquireFrame();
+        [[nodiscard]] bool IsCloseRequested() const;
+        [[nodiscard]] std::uint64_t GetClientHeartbeat() const;
+        [[nodiscard]] std::uint64_t GetDroppedEvents() const { return m_DroppedEvents; }
+
+        // ----- Client -----
+        bool PopEvent(RemoteEvent& event);
+        // Render into this, then Present. Stride is MaxWidth * 4.
+        [[nodiscard]] std::span<std::byte> GetBackBuffer();
+        void Present(std::uint32_t width, std::uint32_t height);
+        void RequestClose();
+        void Beat(); // Tells the host the client is alive, Present and pumping events call it
+        void ClearEventSignal(); // Reads the event fd, so a level triggered loop doesn't wake again
+
+        void ClearFrameSignal(); // The same for the host and the frame fd
+
+        [[nodiscard]] std::uint32_t GetMaxWidth() const { return m_MaxWidth; }
+        [[nodiscard]] std::uint32_t GetMaxHeight() const { return m_MaxHeight; }
+
+    private:
+        struct Header;
+
+        [[nodiscard]] RemoteEvent* GetEvents() const;
+        [[nodiscard]] std::byte* GetFramebuffer(std::uint8_t index) const;
+
+        Header* m_Header = nullptr;
+        std::size_t m_MappedSize = 0;
+        // Kept outside the mapping, a misbehaving peer can't make us index out of it
+        std::uint32_t m_EventCapacity = 0;
+        std::uint32_t m_MaxWidth = 0;
+        std::uint32_t m_MaxHeight = 0;
+        std::size_t m_EventsOffset = 0;
+        std::size_t m_FramesOffset = 0;
+        std::size_t m_FrameSize = 0;
+        int m_MemoryFd = -1;
+        int m_EventFd = -1;
+        int m_FrameFd = -1;
+        std::uint8_t m_Back = 2; // Client, the framebuffer being rendered
+        std::uint8_t m_Front = 0; // Host, the framebuffer being shown
+        bool m_EventsPending = false;
+        std::uint64_t m_DroppedEvents = 0;
+        std::uint64_t m_FrameSequence = 0;
+    };
+
+    // Host side: forwards the events of the window the bus is attached to into the channel. A close is forwarded and consumed,
+    // so the host's own Close listeners never see it. Update closes the window once the client asks for it, and tells when the
+    // client stopped beating, whether to close or restart it then is up to the host.
+    class PULSARION_WINDOWING_API RemoteWindowHost
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        RemoteWindowHost(EventBus& bus, SharedChannel& channel);
+
+        RemoteWindowHost(const RemoteWindowHost&) = delete;
+        RemoteWindowHost& operator=(const RemoteWindowHost&) = delete;
+
+        // Call after PollEvents, wakes the client once for everything that was forwarded
+        void Flush() { m_Channel.FlushEvents(); }
+        // Call once per frame. Sets ShouldClose on the bus's window when the client requested a close, returns false once the
+        // client's heartbeat hasn't moved for longer than timeout. The first call starts the clock.
+        bool Update(TimePoint now, std::chrono::nanoseconds timeout = std::chrono::seconds(2));
+
+    private:
+        void Forward(const RemoteEvent& event) { m_Channel.PushEvent(event); }
+
+        EventBus& m_Bus;
+        SharedChannel& m_Channel;
+        std::vector<Subscription> m_Subscriptions;
+        std::uint64_t m_Heartbeat = 0;
+        TimePoint m_LastBeat;
+        bool m_Started = false;
+        bool m_Stale = false;
+    };
+
+    // Client side: dispatches the events in the channel to the listeners of a bus, which doesn't need to be attached to a window.
+    // A close nobody consumed is sent back to the host as a close request.
+    class PULSARION_WINDOWING_API RemoteEventPump
+    {
+    public:
+        explicit RemoteEventPump(SharedChannel& channel) : m_Channel(channel) { }
+
+        // Returns the number of events dispatched
+        std::size_t Pump(EventBus& bus, void* userData = nullptr);
+
+    private:
+        void Dispatch(EventBus& bus, void* userData, const RemoteEvent& event);
+
+        SharedChannel& m_Channel;
+    };
+}
@@ -0,0 +1,62 @@
+#include "TextInput.hpp"
+
+namespace Pulsarion::Windowing
+{
+    TextInputBuffer::TextInputBuffer(std::size_t capacity)
+    {
+        m_Buffer.reserve(capacity);
+    }
+
+    void TextInputBuffer::AppendCodepoint(char32_t codepoint)
+    {
+        if (codepoint < 0x20 || (codepoint >= 0x7F && codepoint < 0xA0))
+            return;
+        if (codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            codepoint = 0xFFFD;
+
+        if (codepoint < 0x80)
+        {
+            m_Buffer.push_back(static_cast<char>(codepoint));
+        }
+        else if (codepoint < 0x800)
+        {
+            m_Buffer.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+            m_Buffer.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+        else if (codepoint < 0x10000)
+        {
+            m_Buffer.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+            m_Buffer.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            m_Buffer.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+        else
+        {
+            m_Buffer.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+            m_Buffer.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+            m_Buffer.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            m_Buffer.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+    }
+
+    void TextInputBuffer::AppendUtf16(char16_t unit)
+    {
+        if (unit >= 0xD800 && unit <= 0xDBFF)
+        {
+            m_HighSurrogate = unit;
+            return;
+        }
+
+        if (unit >= 0xDC00 && unit <= 0xDFFF)
+        {
+            if (m_HighSurrogate == 0)
+                return; // Lone low surrogate
+            const char32_t codepoint = 0x10000 + ((static_cast<char32_t>(m_HighSurrogate) - 0xD800) << 10) + (static_cast<char32_t>(unit) - 0xDC00);
+            m_HighSurrogate = 0;
+            AppendCodepoint(codepoint);
+            return;
+        }
+
+        m_HighSurrogate = 0;
+        AppendCodepoint(unit);
+    }
+}
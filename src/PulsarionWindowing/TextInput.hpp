@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Core.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace Pulsarion::Windowing
+{
+    /*!
+     * @brief Collects the text typed, pasted or composed by an IME between two PollEvents calls as UTF-8.
+     * The storage is reused between frames, so after warming up, appending never allocates.
+     */
+    class PULSARION_WINDOWING_API TextInputBuffer
+    {
+    public:
+        static constexpr std::size_t DefaultCapacity = 256;
+
+        explicit TextInputBuffer(std::size_t capacity = DefaultCapacity);
+
+        // Control characters are dropped, they are reported through the key events
+        void AppendCodepoint(char32_t codepoint);
+        // Accepts UTF-16 one code unit at a time, joining surrogate pairs (WM_CHAR, NSString)
+        void AppendUtf16(char16_t unit);
+
+        [[nodiscard]] std::string_view View() const { return m_Buffer; }
+        [[nodiscard]] bool Empty() const { return m_Buffer.empty(); }
+        void Clear() { m_Buffer.clear(); } // Keeps the capacity
+
+    private:
+        std::string m_Buffer;
+        char16_t m_HighSurrogate = 0;
+    };
+
+    /*!
+     * @brief Decodes UTF-8 text and calls callback(char32_t) for every codepoint. Invalid sequences produce U+FFFD.
+     */
+    template<typename Callback>
+    constexpr void ForEachCodepoint(std::string_view text, Callback&& callback)
+    {
+        constexpr char32_t replacement = 0xFFFD;
+        std::size_t i = 0;
+        while (i < text.size())
+        {
+            const auto lead = static_cast<unsigned char>(text[i]);
+            std::size_t length = 0;
+            char32_t codepoint = 0;
+            if (lead < 0x80)
+            {
+                length = 1;
+                codepoint = lead;
+            }
+            else if ((lead & 0xE0) == 0xC0)
+            {
+                length = 2;
+                codepoint = lead & 0x1F;
+            }
+            else if ((lead & 0xF0) == 0xE0)
+            {
+                length = 3;
+                codepoint = lead & 0x0F;
+            }
+            else if ((lead & 0xF8) == 0xF0)
+            {
+                length = 4;
+                codepoint = lead & 0x07;
+            }
+            else
+            {
+                callback(replacement);
+                i++;
+                continue;
+            }
+
+            if (i + length > text.size())
+            {
+                callback(replacement);
+                return;
+            }
+
+            bool valid = true;
+            for (std::size_t j = 1; j < length; j++)
+            {
+                const auto continuation = static_cast<unsigned char>(text[i + j]);
+                if ((continuation & 0xC0) != 0x80)
+                {
+                    valid = false;
+                    break;
+                }
+                codepoint = (codepoint << 6) | (continuation & 0x3F);
+            }
+
+            if (!valid)
+            {
+                callback(replacement);
+                i++;
+                continue;
+            }
+
+            callback(codepoint);
+            i += length;
+        }
+    }
+}
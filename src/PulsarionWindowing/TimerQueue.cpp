@@ -0,0 +1,85 @@
+#include "TimerQueue.hpp"
+
+#include <algorithm>
+
+namespace Pulsarion::Windowing
+{
+    // std heaps are max-heaps, inverting the comparison puts the earliest deadline at the front
+    static constexpr auto LaterDeadline = [](const auto& lhs, const auto& rhs) { return lhs.Deadline > rhs.Deadline; };
+
+    TimerId TimerQueue::Add(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat, Clock::time_point now)
+    {
+        // A zero period repeating timer would never let Dispatch return
+        period = std::max(period, std::chrono::nanoseconds(1));
+        const TimerId id = m_NextId++;
+        Push(Timer { now + period, period, id, repeat, std::move(callback) });
+        return id;
+    }
+
+    bool TimerQueue::Remove(TimerId id)
+    {
+        if (id == m_Running)
+        {
+            m_RunningRemoved = true;
+            return true;
+        }
+
+        const auto it = std::find_if(m_Timers.begin(), m_Timers.end(), [id](const Timer& timer) { return timer.Id == id; });
+        if (it == m_Timers.end())
+            return false;
+
+        m_Timers.erase(it);
+        std::make_heap(m_Timers.begin(), m_Timers.end(), LaterDeadline);
+        return true;
+    }
+
+    std::optional<TimerQueue::Clock::time_point> TimerQueue::GetNextDeadline() const
+    {
+        if (m_Timers.empty())
+            return std::nullopt;
+        return m_Timers.front().Deadline;
+    }
+
+    std::optional<std::chrono::nanoseconds> TimerQueue::ClampTimeout(std::optional<std::chrono::nanoseconds> timeout, Clock::time_point now) const
+    {
+        if (m_Timers.empty())
+            return timeout;
+
+        const auto untilDeadline = std::max(std::chrono::nanoseconds::zero(), std::chrono::duration_cast<std::chrono::nanoseconds>(m_Timers.front().Deadline - now));
+        if (!timeout.has_value())
+            return untilDeadline;
+        return std::min(*timeout, untilDeadline);
+    }
+
+    std::size_t TimerQueue::Dispatch(void* userData, Clock::time_point now)
+    {
+        std::size_t fired = 0;
+        while (!m_Timers.empty() && m_Timers.front().Deadline <= now)
+        {
+            std::pop_heap(m_Timers.begin(), m_Timers.end(), LaterDeadline);
+            Timer timer = std::move(m_Timers.back());
+            m_Timers.pop_back();
+
+            m_Running = timer.Id;
+            m_RunningRemoved = false;
+            if (timer.Callback)
+                timer.Callback(userData, timer.Id);
+            m_Running = InvalidTimerId;
+            fired++;
+
+            if (timer.Repeat && !m_RunningRemoved)
+            {
+                const auto missed = (now - timer.Deadline) / timer.Period;
+                timer.Deadline += timer.Period * (missed + 1);
+                Push(std::move(timer));
+            }
+        }
+        return fired;
+    }
+
+    void TimerQueue::Push(Timer&& timer)
+    {
+        m_Timers.push_back(std::move(timer));
+        std::push_heap(m_Timers.begin(), m_Timers.end(), LaterDeadline);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Core.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    using TimerId = std::uint64_t;
+    constexpr TimerId InvalidTimerId = 0;
+
+    // Called with the owner's user data, like the window event callbacks
+    using TimerCallback = std::function<void(void*, TimerId)>;
+
+    /*!
+     * @brief Min-heap of timer deadlines, used by the windows and the event loop to dispatch timers and bound their blocking waits.
+     * Repeating timers stay on their original schedule, periods that were missed entirely are skipped instead of fired back to back.
+     * Timers can be added and removed from inside a timer callback, including the one that is running.
+     */
+    class PULSARION_WINDOWING_API TimerQueue
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        TimerId Add(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat, Clock::time_point now = Clock::now());
+        bool Remove(TimerId id);
+
+        [[nodiscard]] std::optional<Clock::time_point> GetNextDeadline() const;
+        // The wait timeout that doesn't overshoot the next deadline, timeout is std::nullopt when waiting indefinitely
+        [[nodiscard]] std::optional<std::chrono::nanoseconds> ClampTimeout(std::optional<std::chrono::nanoseconds> timeout, Clock::time_point now = Clock::now()) const;
+        [[nodiscard]] bool Empty() const { return m_Timers.empty(); }
+
+        // Runs every timer that is due, returns how many fired
+        std::size_t Dispatch(void* userData, Clock::time_point now = Clock::now());
+
+    private:
+        struct Timer
+        {
+            Clock::time_point Deadline;
+            std::chrono::nanoseconds Period;
+            TimerId Id;
+            bool Repeat;
+            TimerCallback Callback;
+        };
+
+        void Push(Timer&& timer);
+
+        std::vector<Timer> m_Timers; // Heap ordered by the earliest deadline
+        TimerId m_NextId = 1;
+        TimerId m_Running = InvalidTimerId; // The timer whose callback is executing, it is not in the heap at that time
+        bool m_RunningRemoved = false;
+    };
+}
@@ -0,0 +1,113 @@
+#include "Touch.hpp"
+
+namespace Pulsarion::Windowing
+{
+    static bool IsFinished(TouchPhase phase)
+    {
+        return phase == TouchPhase::Ended || phase == TouchPhase::Cancelled;
+    }
+
+    std::size_t TouchContactBuffer::Find(std::uint64_t nativeId) const
+    {
+        for (std::size_t i = 0; i < m_Contacts.size(); i++)
+        {
+            if (m_NativeIds[i] == nativeId && !IsFinished(m_Contacts[i].Phase) && m_DeferredEnds[i] == TouchPhase::Began)
+                return i;
+        }
+        return m_Contacts.size();
+    }
+
+    void TouchContactBuffer::Begin(std::uint64_t nativeId, PointerKind kind, Point position, float pressure, Point tilt)
+    {
+        // We missed the end of the previous contact with this id, it can't still be down
+        const std::size_t existing = Find(nativeId);
+        if (existing != m_Contacts.size())
+            Finish(existing, TouchPhase::Cancelled);
+
+        m_Contacts.push_back({ m_NextId++, position, pressure, tilt, TouchPhase::Began, kind });
+        m_NativeIds.push_back(nativeId);
+        m_DeferredEnds.push_back(TouchPhase::Began);
+        m_Changed = true;
+    }
+
+    void TouchContactBuffer::Move(std::uint64_t nativeId, Point position, float pressure, Point tilt)
+    {
+        const std::size_t index = Find(nativeId);
+        if (index == m_Contacts.size())
+            return;
+        TouchContact& contact = m_Contacts[index];
+        contact.Position = position;
+        contact.Pressure = pressure;
+        contact.Tilt = tilt;
+        if (contact.Phase != TouchPhase::Began)
+            contact.Phase = TouchPhase::Moved;
+        m_Changed = true;
+    }
+
+    void TouchContactBuffer::End(std::uint64_t nativeId, Point position)
+    {
+        const std::size_t index = Find(nativeId);
+        if (index == m_Contacts.size())
+            return;
+        m_Contacts[index].Position = position;
+        Finish(index, TouchPhase::Ended);
+    }
+
+    void TouchContactBuffer::Cancel(std::uint64_t nativeId)
+    {
+        const std::size_t index = Find(nativeId);
+        if (index != m_Contacts.size())
+            Finish(index, TouchPhase::Cancelled);
+    }
+
+    void TouchContactBuffer::CancelAll()
+    {
+        for (std::size_t i = 0; i < m_Contacts.size(); i++)
+        {
+            if (!IsFinished(m_Contacts[i].Phase) && m_DeferredEnds[i] == TouchPhase::Began)
+                Finish(i, TouchPhase::Cancelled);
+        }
+    }
+
+    void TouchContactBuffer::Finish(std::size_t index, TouchPhase phase)
+    {
+        if (m_Contacts[index].Phase == TouchPhase::Began)
+            m_DeferredEnds[index] = phase;
+        else
+            m_Contacts[index].Phase = phase;
+        m_Changed = true;
+    }
+
+    void TouchContactBuffer::Flush()
+    {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < m_Contacts.size(); i++)
+        {
+            if (IsFinished(m_Contacts[i].Phase))
+                continue;
+            m_Contacts[kept] = m_Contacts[i];
+            m_NativeIds[kept] = m_NativeIds[i];
+            m_DeferredEnds[kept] = m_DeferredEnds[i];
+            kept++;
+        }
+        m_Contacts.resize(kept);
+        m_NativeIds.resize(kept);
+        m_DeferredEnds.resize(kept);
+
+        m_Changed = false;
+        for (std::size_t i = 0; i < m_Contacts.size(); i++)
+        {
+            if (m_DeferredEnds[i] != TouchPhase::Began)
+            {
+                // Reported as Began in the batch that just went out, the end goes out with the next one
+                m_Contacts[i].Phase = m_DeferredEnds[i];
+                m_DeferredEnds[i] = TouchPhase::Began;
+                m_Changed = true;
+            }
+            else
+            {
+                m_Contacts[i].Phase = TouchPhase::Stationary;
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Mouse.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    enum class TouchPhase : std::uint8_t
+    {
+        Began = 0,
+        Moved,
+        Stationary, // Still down, didn't change since the last batch
+        Ended,
+        Cancelled // The system took the contact away (a gesture, capture change), don't treat it like a release
+    };
+
+    enum class PointerKind : std::uint8_t
+    {
+        Touch = 0,
+        Pen,
+        Eraser // The back of a pen, or a pen with its eraser button held
+    };
+
+    struct TouchContact
+    {
+        std::uint32_t Id; // Stable while the contact is down and never reused, unlike the platform ids
+        Point Position; // Client coordinates, like the mouse events
+        float Pressure; // 0 to 1, 1 when the device doesn't report pressure
+        Point Tilt; // Degrees from perpendicular along x and y, 0 for fingers
+        TouchPhase Phase;
+        PointerKind Kind;
+    };
+
+    /*!
+     * @brief Collects the touch and pen contacts between two PollEvents calls, so OnTouch is called once per poll with all of them.
+     * The batch holds every contact that is down plus the ones that ended since the last batch. A contact that begins and ends
+     * within one poll (a quick tap) is reported as Began and ends in the next batch, so no contact is ever seen only as Ended.
+     * The storage is reused between polls, so after warming up, recording never allocates.
+     */
+    class PULSARION_WINDOWING_API TouchContactBuffer
+    {
+    public:
+        // nativeId is whatever the platform identifies the contact with while it is down
+        void Begin(std::uint64_t nativeId, PointerKind kind, Point position, float pressure, Point tilt);
+        void Move(std::uint64_t nativeId, Point position, float pressure, Point tilt);
+        void End(std::uint64_t nativeId, Point position);
+        void Cancel(std::uint64_t nativeId);
+        void CancelAll();
+
+        [[nodiscard]] bool HasChanges() const { return m_Changed; }
+        [[nodiscard]] std::span<const TouchContact> View() const { return m_Contacts; }
+        // Called after the batch was reported: drops ended contacts and marks the rest Stationary
+        void Flush();
+
+    private:
+        // Ended contacts and ones waiting for their deferred end don't match, the platform may already reuse their id
+        [[nodiscard]] std::size_t Find(std::uint64_t nativeId) const;
+        void Finish(std::size_t index, TouchPhase phase);
+
+        std::vector<TouchContact> m_Contacts;
+        std::vector<std::uint64_t> m_NativeIds; // Parallel to m_Contacts, so the batch itself stays contiguous
+        std::vector<TouchPhase> m_DeferredEnds; // Parallel to m_Contacts, Began when there is no deferred end
+        std::uint32_t m_NextId = 1;
+        bool m_Changed = false;
+    };
+}
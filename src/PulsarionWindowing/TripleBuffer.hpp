@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Core.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Pulsarion::Windowing
+{
+    /*!
+     * @brief Hands the newest value from one writer thread to one reader thread, wait-free on both sides.
+     * There are three slots: the writer owns the back one, the reader owns the front one and the third is swapped between them
+     * with a single atomic exchange. The writer never waits for the reader and the reader always gets the newest complete value,
+     * values the reader was too slow to see are dropped. Use one buffer per reader thread if there are several.
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    class TripleBuffer
+    {
+    public:
+        TripleBuffer() = default;
+        explicit TripleBuffer(const T& initial)
+        {
+            for (auto& slot : m_Slots)
+                slot.Value = initial;
+        }
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        // Writer thread: fill the back slot, then publish it
+        [[nodiscard]] T& GetBack() { return m_Slots[m_Back].Value; }
+
+        void Publish()
+        {
+            // Release so the reader sees the whole slot, acquire so we don't write into the slot the reader just gave back before it's done with it
+            m_Back = m_Shared.exchange(static_cast<std::uint8_t>(m_Back | FreshBit), std::memory_order_acq_rel) & IndexMask;
+        }
+
+        void Publish(const T& value)
+        {
+            GetBack() = value;
+            Publish();
+        }
+
+        // Reader thread: takes the newest published slot if there is one, returns false if nothing was published since the last call
+        bool Update()
+        {
+            if ((m_Shared.load(std::memory_order_relaxed) & FreshBit) == 0)
+                return false;
+            m_Front = m_Shared.exchange(m_Front, std::memory_order_acq_rel) & IndexMask;
+            return true;
+        }
+
+        // Reader thread: stays valid and unchanged until the next Update or Read
+        [[nodiscard]] const T& GetFront() const { return m_Slots[m_Front].Value; }
+
+        [[nodiscard]] const T& Read()
+        {
+            Update();
+            return GetFront();
+        }
+
+    private:
+        static constexpr std::uint8_t IndexMask = 0x3;
+        static constexpr std::uint8_t FreshBit = 0x4; // Set while the shared slot holds a value the reader hasn't taken
+
+        // On separate cache lines, so the writer filling its slot doesn't slow down the reader copying out of its own
+        struct alignas(64) Slot
+        {
+            T Value {};
+        };
+
+        std::array<Slot, 3> m_Slots;
+        alignas(64) std::atomic<std::uint8_t> m_Shared = 1;
+        alignas(64) std::uint8_t m_Back = 2; // Only touched by the writer
+        alignas(64) std::uint8_t m_Front = 0; // Only touched by the reader
+    };
+}
@@ -0,0 +1,105 @@
+#include "Watchdog.hpp"
+#include "EventBus.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Pulsarion::Windowing
+{
+    Watchdog::Watchdog(WatchdogConfig config)
+        : m_Config(config), m_Thread([this] { Run(); })
+    {
+    }
+
+    Watchdog::~Watchdog()
+    {
+        if (m_Bus != nullptr)
+            m_Bus->SetWatchdog(nullptr);
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Wake.notify_one();
+        m_Thread.join();
+    }
+
+    void Watchdog::Watch(EventBus& bus)
+    {
+        if (m_Bus != nullptr)
+            m_Bus->SetWatchdog(nullptr);
+        m_Bus = &bus;
+        bus.SetWatchdog(this);
+    }
+
+    void Watchdog::SetOnStall(StallCallback&& onStall, void* userData)
+    {
+        std::lock_guard lock(m_Mutex);
+        m_OnStall = std::move(onStall);
+        m_UserData = userData;
+    }
+
+    StallReport Watchdog::GetReport() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_Report;
+    }
+
+    void Watchdog::Run()
+    {
+        // Checking four times per timeout detects a stall at most a quarter timeout late
+        const auto interval = std::max<std::chrono::nanoseconds>(m_Config.Timeout / 4, std::chrono::milliseconds(1));
+        std::uint64_t lastBeat = m_Beat.load(std::memory_order_relaxed);
+        auto lastChange = std::chrono::steady_clock::now();
+
+        std::unique_lock lock(m_Mutex);
+        while (!m_Wake.wait_for(lock, interval, [this] { return m_Stop; }))
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const std::uint64_t beat = m_Beat.load(std::memory_order_relaxed);
+            const LoopPhase phase = m_Phase.load(std::memory_order_relaxed);
+            if (beat != lastBeat || phase == LoopPhase::Idle || phase == LoopPhase::Sleeping || phase == LoopPhase::Waiting)
+            {
+                if (m_Stalled.load(std::memory_order_relaxed))
+                    EndStall(now);
+                lastBeat = beat;
+                lastChange = now;
+                continue;
+            }
+            if (m_Stalled.load(std::memory_order_relaxed) || now - lastChange < m_Config.Timeout)
+                continue;
+
+            m_Current.Start = lastChange;
+            m_Current.Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastChange);
+            m_Current.Phase = phase;
+            m_Current.Event = m_Event.load(std::memory_order_relaxed);
+            m_Current.Frame = m_Frame.load(std::memory_order_relaxed);
+            m_Stalled.store(true, std::memory_order_relaxed);
+            if (m_OnStall)
+            {
+                // Unlocked, so the hook can query the report
+                const StallCallback onStall = m_OnStall;
+                void* userData = m_UserData;
+                lock.unlock();
+                onStall(userData, m_Current);
+                lock.lock();
+            }
+        }
+    }
+
+    void Watchdog::EndStall(std::chrono::steady_clock::time_point now)
+    {
+        m_Stalled.store(false, std::memory_order_relaxed);
+        // Only known to within a check interval, the beat that ended it happened somewhere in the last one
+        m_Current.Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_Current.Start);
+
+        m_Report.Stalls++;
+        m_Report.Total += m_Current.Duration;
+        if (m_Current.Duration > m_Report.Longest.Duration)
+            m_Report.Longest = m_Current;
+        if (m_Config.MaxRecords == 0)
+            return;
+        if (m_Report.Recent.size() >= m_Config.MaxRecords)
+            m_Report.Recent.erase(m_Report.Recent.begin());
+        m_Report.Recent.push_back(m_Current);
+    }
+}
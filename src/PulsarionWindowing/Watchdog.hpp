@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Core.hpp"
+#include "EventType.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Pulsarion::Windowing
+{
+    class EventBus;
+
+    // What the event loop was doing at its last heartbeat
+    enum class LoopPhase : std::uint8_t
+    {
+        Idle = 0, // No heartbeat yet
+        PollEvents, // Inside PollEvents, in native code
+        Dispatching, // Inside a listener, the event type says which
+        Frame, // After PollEvents returned, the application's own work
+        Sleeping, // FrameLimiter pacing the frame, which isn't a stall
+        Waiting, // Blocked in WaitEvents, which isn't a stall either
+        Count
+    };
+
+    constexpr std::size_t LoopPhaseCount = static_cast<std::size_t>(LoopPhase::Count);
+
+    constexpr std::string_view LoopPhaseToString(LoopPhase phase)
+    {
+        constexpr std::array<std::string_view, LoopPhaseCount> names = { "Idle", "PollEvents", "Dispatching", "Frame", "Sleeping", "Waiting" };
+        const auto index = static_cast<std::size_t>(phase);
+        return index < names.size() ? names[index] : "Unknown";
+    }
+
+    struct StallRecord
+    {
+        std::chrono::steady_clock::time_point Start; // The last heartbeat before the stall
+        std::chrono::nanoseconds Duration = {}; // Up to when it was detected for the hook, the whole stall in the report
+        LoopPhase Phase = LoopPhase::Idle;
+        EventType Event = EventType::Count; // The last event dispatched, Count if none was
+        std::uint64_t Frame = 0;
+    };
+
+    struct StallReport
+    {
+        std::uint64_t Stalls = 0;
+        std::chrono::nanoseconds Total = {};
+        StallRecord Longest;
+        std::vector<StallRecord> Recent; // The last WatchdogConfig::MaxRecords stalls, oldest first
+    };
+
+    struct WatchdogConfig
+    {
+        std::chrono::milliseconds Timeout = std::chrono::milliseconds(500); // No heartbeat for this long is a stall
+        std::size_t MaxRecords = 32;
+    };
+
+    /*!
+     * @brief A thread that notices when the event loop stops beating, for the "window not responding" freezes nobody can reproduce.
+     * The loop beats it from PollEvents, WaitEvents (Window::SetWatchdog), FrameLimiter::EndFrame (FrameLimiter::SetWatchdog) and,
+     * with Watch, from every event dispatched through a bus. A beat is a couple of relaxed atomic stores on the loop's thread.
+     * When no beat arrives within the timeout outside of WaitEvents and FrameLimiter's sleep, the phase, last event and frame number are recorded and the
+     * OnStall hook is called on the watchdog thread, while the loop is still stuck. Stalls are summarised in GetReport once they end.
+     */
+    class PULSARION_WINDOWING_API Watchdog
+    {
+    public:
+        using StallCallback = std::function<void(void*, const StallRecord&)>;
+
+        explicit Watchdog(WatchdogConfig config = {});
+        ~Watchdog();
+
+        Watchdog(const Watchdog&) = delete;
+        Watchdog& operator=(const Watchdog&) = delete;
+
+        // Loop thread
+        void Beat(LoopPhase phase)
+        {
+            m_Phase.store(phase, std::memory_order_relaxed);
+            m_Beat.store(++m_BeatCount, std::memory_order_relaxed);
+        }
+        void BeginFrame()
+        {
+            m_Frame.store(++m_FrameCount, std::memory_order_relaxed);
+            Beat(LoopPhase::PollEvents);
+        }
+        void BeginDispatch(EventType type)
+        {
+            if (m_DispatchDepth++ == 0)
+                m_PhaseBeforeDispatch = m_Phase.load(std::memory_order_relaxed);
+            m_Event.store(type, std::memory_order_relaxed);
+            Beat(LoopPhase::Dispatching);
+        }
+        // Goes back to the phase the outermost dispatch started in
+        void EndDispatch()
+        {
+            Beat(--m_DispatchDepth == 0 ? m_PhaseBeforeDispatch : LoopPhase::Dispatching);
+        }
+
+        // Beats with every event dispatched through the bus, so a stall names the event whose listener hangs.
+        // The watchdog must not outlive the bus, destroying it detaches it from the bus.
+        void Watch(EventBus& bus);
+
+        // Called on the watchdog thread, once per stall
+        void SetOnStall(StallCallback&& onStall, void* userData = nullptr);
+        [[nodiscard]] StallReport GetReport() const;
+        [[nodiscard]] bool IsStalled() const { return m_Stalled.load(std::memory_order_relaxed); }
+
+    private:
+        void Run();
+        void EndStall(std::chrono::steady_clock::time_point now);
+
+        WatchdogConfig m_Config;
+
+        // Written by the loop thread only
+        std::atomic<std::uint64_t> m_Beat = 0;
+        std::atomic<std::uint64_t> m_Frame = 0;
+        std::atomic<LoopPhase> m_Phase = LoopPhase::Idle;
+        std::atomic<EventType> m_Event = EventType::Count;
+        std::uint64_t m_BeatCount = 0;
+        std::uint64_t m_FrameCount = 0;
+        std::uint32_t m_DispatchDepth = 0;
+        LoopPhase m_PhaseBeforeDispatch = LoopPhase::Idle;
+        EventBus* m_Bus = nullptr;
+
+        std::atomic<bool> m_Stalled = false;
+        StallRecord m_Current; // Watchdog thread only
+
+        mutable std::mutex m_Mutex; // Guards everything below
+        std::condition_variable m_Wake;
+        bool m_Stop = false;
+        StallCallback m_OnStall;
+        void* m_UserData = nullptr;
+        StallReport m_Report;
+
+        std::thread m_Thread; // Last, so it starts after everything it uses
+    };
+}
@@ -1,18 +1,41 @@
 #pragma once
 
 #include "Core.hpp"
+#include "Clipboard.hpp"
 #include "Mouse.hpp"
+#include "Touch.hpp"
 #include "Keyboard.hpp"
 #include "Cursor.hpp"
+#include "Image.hpp"
 #include "WindowStyles.hpp"
+#include "EventType.hpp"
+#include "TimerQueue.hpp"
 
+#include <chrono>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <functional>
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace Pulsarion::Windowing
 {
+    // Timing of the monitor a window is on
+    struct DisplayTiming
+    {
+        double RefreshRate = 0.0; // In Hz, 0 when it isn't known
+        std::optional<std::chrono::steady_clock::time_point> LastVblank; // Only set when the platform reports the vblank phase
+    };
+
+    struct WindowSize
+    {
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+    };
+
+    class Watchdog;
 
     class Window
     {
@@ -21,11 +44,44 @@ namespace Pulsarion::Windowing
 
         virtual void SetVisible(bool visible) = 0;
         virtual void PollEvents() = 0;
+        // Sleeps until an event arrives, a timer is due or the timeout expires, then handles everything like PollEvents.
+        // std::nullopt waits indefinitely, which is what idle tools want instead of spinning on PollEvents.
+        virtual void WaitEvents(std::optional<std::chrono::nanoseconds> timeout = std::nullopt) = 0;
+        // Timers fire from inside PollEvents and WaitEvents on the window's thread, with the window's user data
+        virtual TimerId AddTimer(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat = true) = 0;
+        virtual void RemoveTimer(TimerId id) = 0;
         [[nodiscard]] virtual bool ShouldClose() const = 0;
         virtual void SetShouldClose(bool shouldClose) = 0;
         virtual void SetTitle(const std::string& title) = 0;
         virtual void SetCursorMode(CursorMode mode) = 0;
+        // The cursor shown over the client area while the cursor mode is Normal. Native cursors made from images are cached by the
+        // content hash, so switching between shapes and images that were used before only swaps a handle.
+        virtual void SetCursorShape(CursorShape shape) = 0;
+        virtual void SetCursorImage(const ImageView& image, std::uint32_t hotspotX, std::uint32_t hotspotY) = 0;
+        // Several sizes can be given, the platform picks the ones closest to what it shows. An empty span restores the default icon.
+        virtual void SetIcon(std::span<const ImageView> images) = 0;
+        // Masked event types are dropped before they are translated (no key mapping, no raw input reads, no text decoding)
+        // and their callbacks are not called. Where the platform allows it, the window also stops asking for them.
+        virtual void SetEventMask(EventTypeFlags mask) = 0;
+        [[nodiscard]] virtual EventTypeFlags GetEventMask() const = 0;
+        // Resizes are coalesced and reported once per poll with the final content size, this is incremented every time one is.
+        // Comparing it with last frame's value is enough to know whether swapchains and framebuffers need to be recreated.
+        [[nodiscard]] virtual std::uint64_t GetSizeGeneration() const = 0;
+        // The content size as last reported to OnResize, or as created before the first resize. 0x0 until the window is realized.
+        [[nodiscard]] virtual WindowSize GetContentSize() const = 0;
+        // Cheap enough to call every frame, the backend re-queries the refresh rate when the window moves to another monitor
+        [[nodiscard]] virtual DisplayTiming GetDisplayTiming() const = 0;
+        // PollEvents beats the watchdog (and counts the frame), WaitEvents tells it that blocking is expected. nullptr detaches it.
+        virtual void SetWatchdog(Watchdog* watchdog) = 0;
+        // Offers the formats without producing any data, the provider is only called once someone pastes one of them.
+        // Returns false when the clipboard couldn't be taken, another application has it open or the window isn't realized yet.
+        virtual bool SetClipboard(std::vector<std::string> formats, ClipboardProvider&& provider) = 0;
+        // Never blocks, the receiver is called from a later PollEvents with the data in chunks
+        virtual void RequestClipboard(std::string format, ClipboardReceiver&& receiver) = 0;
+        [[nodiscard]] virtual bool HasClipboardFormat(std::string_view format) const = 0;
         [[nodiscard]] virtual std::optional<std::string> GetTitle() const = 0;
+        // The title as last set, cached by the backend so reading it doesn't ask the native window
+        [[nodiscard]] virtual std::string_view GetTitleView() const = 0;
         [[nodiscard]] virtual void* GetNativeWindow() const = 0;
 
         // --- Event Callbacks ---
@@ -34,66 +90,85 @@ namespace Pulsarion::Windowing
         using FocusCallback = std::function<void(void*, bool)>;
         using ResizeCallback = std::function<void(void*, std::uint32_t, std::uint32_t)>;
         using MoveCallback = std::function<void(void*, std::uint32_t, std::uint32_t)>;
-        using BeforeResizeCallback = std::function<void(void*)>;
+        using BeforeResizeCallback = std::function<void(void*)>; // The user started resizing the window
+        using AfterResizeCallback = std::function<void(void*, std::uint32_t, std::uint32_t)>;
         using MinimizeCallback = std::function<void(void*)>;
         using MaximizeCallback = std::function<void(void*)>;
         using FullscreenCallback = std::function<void(void*, bool)>;
         using RestoreCallback = std::function<void(void*)>;
+        using OcclusionCallback = std::function<void(void*, bool)>; // True when nothing of the window can be seen, Win32 has no notification for it
         using MouseEnterCallback = std::function<void(void*)>;
         using MouseLeaveCallback = std::function<void(void*)>;
         using MouseDownCallback = std::function<void(void*, Point, MouseCode)>;
         using MouseUpCallback = std::function<void(void*, Point, MouseCode)>;
         using MouseMoveCallback = std::function<void(void*, Point)>;
         using MouseWheelCallback = std::function<void(void*, Point, ScrollOffset)>;
+        // Called once per PollEvents while the cursor is captured, with the summed unaccelerated motion and every raw sample behind it
+        using RawMouseMoveCallback = std::function<void(void*, Point, std::span<const Point>)>;
+        // Called once per PollEvents with every touch and pen contact that is down or ended since the last call
+        using TouchCallback = std::function<void(void*, std::span<const TouchContact>)>;
         using KeyDownCallback = std::function<void(void*, KeyCode, Modifier, bool)>;
         using KeyUpCallback = std::function<void(void*, KeyCode, Modifier)>;
         using KeyTypedCallback = std::function<void(void*, char, Modifier)>;
+        // Called at most once per PollEvents with everything typed, pasted or composed since the last poll, as UTF-8.
+        // The view is only valid for the duration of the callback.
+        using TextInputCallback = std::function<void(void*, std::string_view)>;
 
         // ----- Window Event Callbacks -----
         virtual void SetOnClose(CloseCallback&& onClose) = 0;
-        [[nodiscard]] virtual CloseCallback GetOnClose() const = 0;
+        [[nodiscard]] virtual const CloseCallback& GetOnClose() const = 0;
         virtual void SetOnWindowVisibility(VisibilityCallback&& onWindowVisibility) = 0;
-        [[nodiscard]] virtual VisibilityCallback GetOnWindowVisibility() const = 0;
+        [[nodiscard]] virtual const VisibilityCallback& GetOnWindowVisibility() const = 0;
         virtual void SetUserData(void* userData) = 0;
         [[nodiscard]] virtual void* GetUserData() const = 0;
         virtual void SetOnFocus(FocusCallback&& onFocus) = 0;
-        [[nodiscard]] virtual FocusCallback GetOnFocus() const = 0;
+        [[nodiscard]] virtual const FocusCallback& GetOnFocus() const = 0;
         virtual void SetOnResize(ResizeCallback&& onResize) = 0;
-        [[nodiscard]] virtual ResizeCallback GetOnResize() const = 0;
+        [[nodiscard]] virtual const ResizeCallback& GetOnResize() const = 0;
         virtual void SetOnMove(MoveCallback&& onMove) = 0;
-        [[nodiscard]] virtual MoveCallback GetOnMove() const = 0;
+        [[nodiscard]] virtual const MoveCallback& GetOnMove() const = 0;
         virtual void SetBeforeResize(BeforeResizeCallback&& beforeResize) = 0;
-        [[nodiscard]] virtual BeforeResizeCallback GetBeforeResize() const = 0;
+        [[nodiscard]] virtual const BeforeResizeCallback& GetBeforeResize() const = 0;
+        virtual void SetAfterResize(AfterResizeCallback&& afterResize) = 0;
+        [[nodiscard]] virtual const AfterResizeCallback& GetAfterResize() const = 0;
         virtual void SetOnMinimize(MinimizeCallback&& onMinimize) = 0;
-        [[nodiscard]] virtual MinimizeCallback GetOnMinimize() const = 0;
+        [[nodiscard]] virtual const MinimizeCallback& GetOnMinimize() const = 0;
         virtual void SetOnMaximize(MaximizeCallback&& onMaximize) = 0;
-        [[nodiscard]] virtual MaximizeCallback GetOnMaximize() const = 0;
+        [[nodiscard]] virtual const MaximizeCallback& GetOnMaximize() const = 0;
         virtual void SetOnFullscreen(FullscreenCallback&& onFullscreen) = 0;
-        [[nodiscard]] virtual FullscreenCallback GetOnFullscreen() const = 0;
+        [[nodiscard]] virtual const FullscreenCallback& GetOnFullscreen() const = 0;
         virtual void SetOnRestore(RestoreCallback&& onRestore) = 0;
-        [[nodiscard]] virtual RestoreCallback GetOnRestore() const = 0;
+        [[nodiscard]] virtual const RestoreCallback& GetOnRestore() const = 0;
+        virtual void SetOnOcclusion(OcclusionCallback&& onOcclusion) = 0;
+        [[nodiscard]] virtual const OcclusionCallback& GetOnOcclusion() const = 0;
 
         // ----- Mouse Event Callbacks -----
         virtual void SetOnMouseEnter(MouseEnterCallback&& onMouseEnter) = 0;
-        [[nodiscard]] virtual MouseEnterCallback GetOnMouseEnter() const = 0;
+        [[nodiscard]] virtual const MouseEnterCallback& GetOnMouseEnter() const = 0;
         virtual void SetOnMouseLeave(MouseLeaveCallback&& onMouseLeave) = 0;
-        [[nodiscard]] virtual MouseLeaveCallback GetOnMouseLeave() const = 0;
+        [[nodiscard]] virtual const MouseLeaveCallback& GetOnMouseLeave() const = 0;
         virtual void SetOnMouseDown(MouseDownCallback&& onMouseDown) = 0;
-        [[nodiscard]] virtual MouseDownCallback GetOnMouseDown() const = 0;
+        [[nodiscard]] virtual const MouseDownCallback& GetOnMouseDown() const = 0;
         virtual void SetOnMouseUp(MouseUpCallback&& onMouseUp) = 0;
-        [[nodiscard]] virtual MouseUpCallback GetOnMouseUp() const = 0;
+        [[nodiscard]] virtual const MouseUpCallback& GetOnMouseUp() const = 0;
         virtual void SetOnMouseMove(MouseMoveCallback&& onMouseMove) = 0;
-        [[nodiscard]] virtual MouseMoveCallback GetOnMouseMove() const = 0;
+        [[nodiscard]] virtual const MouseMoveCallback& GetOnMouseMove() const = 0;
         virtual void SetOnMouseWheel(MouseWheelCallback&& onMouseWheel) = 0;
-        [[nodiscard]] virtual MouseWheelCallback GetOnMouseWheel() const = 0;
+        [[nodiscard]] virtual const MouseWheelCallback& GetOnMouseWheel() const = 0;
+        virtual void SetOnRawMouseMove(RawMouseMoveCallback&& onRawMouseMove) = 0;
+        [[nodiscard]] virtual const RawMouseMoveCallback& GetOnRawMouseMove() const = 0;
+        virtual void SetOnTouch(TouchCallback&& onTouch) = 0;
+        [[nodiscard]] virtual const TouchCallback& GetOnTouch() const = 0;
 
         // ----- Keyboard Event Callbacks -----
         virtual void SetOnKeyDown(KeyDownCallback&& onKeyDown) = 0;
-        [[nodiscard]] virtual KeyDownCallback GetOnKeyDown() const = 0;
+        [[nodiscard]] virtual const KeyDownCallback& GetOnKeyDown() const = 0;
         virtual void SetOnKeyUp(KeyUpCallback&& onKeyUp) = 0;
-        [[nodiscard]] virtual KeyUpCallback GetOnKeyUp() const = 0;
+        [[nodiscard]] virtual const KeyUpCallback& GetOnKeyUp() const = 0;
         virtual void SetOnKeyTyped(KeyTypedCallback&& onKeyTyped) = 0;
-        [[nodiscard]] virtual KeyTypedCallback GetOnKeyTyped() const = 0;
+        [[nodiscard]] virtual const KeyTypedCallback& GetOnKeyTyped() const = 0;
+        virtual void SetOnTextInput(TextInputCallback&& onTextInput) = 0;
+        [[nodiscard]] virtual const TextInputCallback& GetOnTextInput() const = 0;
 
         #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
         virtual void LimitEvents(bool limitEvents) = 0;
@@ -109,19 +184,24 @@ namespace Pulsarion::Windowing
         Window::ResizeCallback OnResize = nullptr;
         Window::MoveCallback OnMove = nullptr;
         Window::BeforeResizeCallback BeforeResize = nullptr;
+        Window::AfterResizeCallback AfterResize = nullptr;
         Window::MinimizeCallback OnMinimize = nullptr;
         Window::MaximizeCallback OnMaximize = nullptr;
         Window::FullscreenCallback OnFullscreen = nullptr;
         Window::RestoreCallback OnRestore = nullptr;
+        Window::OcclusionCallback OnOcclusion = nullptr;
         Window::MouseEnterCallback OnMouseEnter = nullptr;
         Window::MouseLeaveCallback OnMouseLeave = nullptr;
         Window::MouseDownCallback OnMouseDown = nullptr;
         Window::MouseUpCallback OnMouseUp = nullptr;
         Window::MouseMoveCallback OnMouseMove = nullptr;
         Window::MouseWheelCallback OnMouseWheel = nullptr;
+        Window::RawMouseMoveCallback OnRawMouseMove = nullptr;
+        Window::TouchCallback OnTouch = nullptr;
         Window::KeyDownCallback OnKeyDown = nullptr;
         Window::KeyUpCallback OnKeyUp = nullptr;
         Window::KeyTypedCallback OnKeyTyped = nullptr;
+        Window::TextInputCallback OnTextInput = nullptr;
     };
 
     inline static void SetWindowEvents(Window& window, WindowEvents& events)
@@ -132,21 +212,38 @@ namespace Pulsarion::Windowing
         window.SetOnResize(std::move(events.OnResize));
         window.SetOnMove(std::move(events.OnMove));
         window.SetBeforeResize(std::move(events.BeforeResize));
+        window.SetAfterResize(std::move(events.AfterResize));
         window.SetOnMinimize(std::move(events.OnMinimize));
         window.SetOnMaximize(std::move(events.OnMaximize));
         window.SetOnFullscreen(std::move(events.OnFullscreen));
         window.SetOnRestore(std::move(events.OnRestore));
+        window.SetOnOcclusion(std::move(events.OnOcclusion));
         window.SetOnMouseEnter(std::move(events.OnMouseEnter));
         window.SetOnMouseLeave(std::move(events.OnMouseLeave));
         window.SetOnMouseDown(std::move(events.OnMouseDown));
         window.SetOnMouseUp(std::move(events.OnMouseUp));
         window.SetOnMouseMove(std::move(events.OnMouseMove));
         window.SetOnMouseWheel(std::move(events.OnMouseWheel));
+        window.SetOnRawMouseMove(std::move(events.OnRawMouseMove));
+        window.SetOnTouch(std::move(events.OnTouch));
         window.SetOnKeyDown(std::move(events.OnKeyDown));
         window.SetOnKeyUp(std::move(events.OnKeyUp));
         window.SetOnKeyTyped(std::move(events.OnKeyTyped));
+        window.SetOnTextInput(std::move(events.OnTextInput));
     }
 
+    struct WindowDesc
+    {
+        std::string Title;
+        WindowBounds Bounds;
+        WindowStyles Styles = WindowStyles::None;
+        WindowConfig Config;
+        std::optional<WindowEvents> Events = std::nullopt;
+    };
+
     extern PULSARION_WINDOWING_API std::shared_ptr<Window> CreateSharedWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config, std::optional<WindowEvents> events = std::nullopt);
     extern PULSARION_WINDOWING_API std::unique_ptr<Window> CreateUniqueWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config, std::optional<WindowEvents> events = std::nullopt);
+    // Creates the windows in one go so the per process setup is only paid once, the titles and events are moved out of descs.
+    // Windows that failed to be created are nullptr, in the same position as their description.
+    extern PULSARION_WINDOWING_API std::vector<std::unique_ptr<Window>> CreateWindows(std::span<WindowDesc> descs);
 }
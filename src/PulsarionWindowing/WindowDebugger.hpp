@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Window.hpp"
+#include "NativeWindow.hpp"
+#include "EventBus.hpp"
+#include "Clock.hpp"
+#include "CallbackProfiler.hpp"
 
 #include "PulsarionCore/Log.hpp"
 
@@ -22,22 +26,34 @@ namespace Pulsarion::Windowing
 
         bool LogDeltaTime = false;
 
+        // Times every callback the backend calls, see GetCallbackProfiler
+        bool ProfileCallbacks = false;
+
         constexpr DebugOptions() = default;
-        constexpr DebugOptions(bool logCalls, bool logToggles, bool logEvents, bool logState, bool logDeltaTime) : LogCalls(logCalls), LogToggles(logToggles), LogEvents(logEvents), LogState(logState), LogDeltaTime(logDeltaTime)
+        constexpr DebugOptions(bool logCalls, bool logToggles, bool logEvents, bool logState, bool logDeltaTime, bool profileCallbacks = false)
+            : LogCalls(logCalls), LogToggles(logToggles), LogEvents(logEvents), LogState(logState), LogDeltaTime(logDeltaTime), ProfileCallbacks(profileCallbacks)
         {
 
         }
     };
 
-    // We use a template so additional debug options won't affect performance
-    template<DebugOptions options, typename T>
+    // We use a template so additional debug options won't affect performance.
+    // The backend is held by value, usually NativeWindow, so the forwarding calls are direct instead of a second virtual hop.
+    // The clock only matters for LogDeltaTime and ProfileCallbacks, ManualClock makes their statistics deterministic.
+    template<DebugOptions options, typename T, Clock ClockType = SteadyClock>
     requires std::derived_from<T, Window>
-    class DebugWindow : public T
+    class DebugWindow : public Window
     {
     protected:
+        // The backend's callbacks go through our state when we log or time them
+        static constexpr bool InterceptsEvents = options.LogEvents || options.ProfileCallbacks;
+
+        struct None { };
+
         struct WindowData : WindowEvents
         {
             void* UserData = nullptr;
+            [[no_unique_address]] std::conditional_t<options.ProfileCallbacks, BasicCallbackProfiler<ClockType>, None> Profiler;
 
             WindowData() = default;
         };
@@ -45,176 +61,261 @@ namespace Pulsarion::Windowing
         struct DeltaTime
         {
             // We log maximum once per second
-            std::chrono::steady_clock::time_point LastLogTime = std::chrono::steady_clock::now();
-            std::chrono::steady_clock::time_point LastFrameTime = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::time_point LastLogTime;
+            std::chrono::steady_clock::time_point LastFrameTime;
             std::size_t FrameCount = 0;
             std::size_t TotalTimeMicroseconds = 0;
         };
 
-        void SetDebugCallbacks()
-        requires (options.LogEvents)
+        template<EventType Type, typename Callback, typename... Args>
+        static decltype(auto) Invoke(WindowData* state, const Callback& callback, Args... args)
         {
-            m_Window->SetUserData(&m_State);
-
-            m_Window->SetOnClose([](void* data) -> bool
-            {
-                PULSARION_LOG_TRACE("[Window::OnClose] Window close callback called");
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnClose)
-                    return state->OnClose(data);
-                return true;
-            });
-
-            m_Window->SetOnWindowVisibility([](void* data, bool visible)
-            {
-                PULSARION_LOG_TRACE("[Window::OnWindowVisibility] Window visibility callback called with visibility {0}", visible);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnWindowVisibility)
-                    state->OnWindowVisibility(data, visible);
-            });
-
-            m_Window->SetOnFocus([](void* data, bool focused)
-            {
-                PULSARION_LOG_TRACE("[Window::OnFocus] Window focus callback called with focus {0}", focused);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnFocus)
-                    state->OnFocus(data, focused);
-            });
-
-            m_Window->SetOnResize([](void* data, std::uint32_t width, std::uint32_t height)
-            {
-                PULSARION_LOG_TRACE("[Window::OnResize] Window resize callback called with width {0} and height {1}", width, height);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnResize)
-                    state->OnResize(data, width, height);
-            });
-
-            m_Window->SetOnMove([](void* data, std::uint32_t x, std::uint32_t y)
-            {
-                PULSARION_LOG_TRACE("[Window::OnMove] Window move callback called with x {0} and y {1}", x, y);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMove)
-                    state->OnMove(data, x, y);
-            });
-
-            m_Window->SetBeforeResize([](void* data)
-            {
-                PULSARION_LOG_TRACE("[Window::BeforeResize] Window before resize callback called");
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->BeforeResize)
-                    state->BeforeResize(data);
-            });
-
-            m_Window->SetOnMinimize([](void* data)
-            {
-                PULSARION_LOG_TRACE("[Window::OnMinimize] Window minimize callback called");
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMinimize)
-                    state->OnMinimize(data);
-            });
-
-            m_Window->SetOnMaximize([](void* data)
-            {
-                PULSARION_LOG_TRACE("[Window::OnMaximize] Window maximize callback called");
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMaximize)
-                    state->OnMaximize(data);
-            });
-
-            m_Window->SetOnFullscreen([](void* data, bool fullscreen)
-            {
-                PULSARION_LOG_TRACE("[Window::OnFullscreen] Window fullscreen callback called with fullscreen {0}", fullscreen);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnFullscreen)
-                    state->OnFullscreen(data, fullscreen);
-            });
-
-            m_Window->SetOnRestore([](void* data)
-            {
-                PULSARION_LOG_TRACE("[Window::OnRestore] Window restore callback called");
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnRestore)
-                    state->OnRestore(data);
-            });
-
-            m_Window->SetOnMouseEnter([](void* data)
-            {
-                PULSARION_LOG_TRACE("[Window::OnMouseEnter] Window mouse enter callback called");
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMouseEnter)
-                    state->OnMouseEnter(data);
-            });
-
-            m_Window->SetOnMouseLeave([](void* data)
+            if constexpr (options.ProfileCallbacks)
             {
-                PULSARION_LOG_TRACE("[Window::OnMouseLeave] Window mouse enter callback called");
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMouseLeave)
-                    state->OnMouseLeave(data);
-            });
-
-            m_Window->SetOnMouseDown([](void* data, Point position, MouseCode button)
-            {
-                PULSARION_LOG_TRACE("[Window::OnMouseDown] Window mouse down callback called with button {0} and position ({1}, {2})", static_cast<std::uint8_t>(button), position.x, position.y);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMouseDown)
-                    state->OnMouseDown(data, position, button);
-            });
-
-            m_Window->SetOnMouseUp([](void* data, Point position, MouseCode button)
-            {
-                PULSARION_LOG_TRACE("[Window::OnMouseUp] Window mouse up callback called with button {0} and position ({1}, {2})", static_cast<std::uint8_t>(button), position.x, position.y);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMouseUp)
-                    state->OnMouseUp(data, position, button);
-            });
-
-            m_Window->SetOnMouseMove([](void* data, Point position)
-            {
-                PULSARION_LOG_TRACE("[Window::OnMouseMove] Window mouse move callback called with position ({0}, {1})", position.x, position.y);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMouseMove)
-                    state->OnMouseMove(data, position);
-            });
-
-            m_Window->SetOnMouseWheel([](void* data, Point position, ScrollOffset offset)
-            {
-                PULSARION_LOG_TRACE("[Window::OnMouseWheel] Window mouse scroll callback called with offset ({0}, {1}) and position ({2}, {3})", offset.x, offset.y, position.x, position.y);
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnMouseWheel)
-                    state->OnMouseWheel(data, position, offset);
-            });
-
-            m_Window->SetOnKeyDown([](void* data, KeyCode key, Modifier modifier, bool repeat)
-            {
-                PULSARION_LOG_TRACE("[Window::OnKeyDown] Window key down callback called with [key, modifier, repeat]: {0}, {1}, {2}", KeyCodeToString(key), static_cast<std::uint16_t>(modifier), repeat ? "true" : "false");
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnKeyDown)
-                    state->OnKeyDown(data, key, modifier, repeat);
-            });
-
-            m_Window->SetOnKeyUp([](void* data, KeyCode key, Modifier modifier)
+                const auto scope = state->Profiler.Measure(Type);
+                return callback(state->UserData, args...);
+            }
+            else
             {
-                PULSARION_LOG_TRACE("[Window::OnKeyUp] Window key up callback called with key {0}, modifier {1}", KeyCodeToString(key), static_cast<std::uint16_t>(modifier));
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnKeyUp)
-                    state->OnKeyUp(data, key, modifier);
-            });
+                return callback(state->UserData, args...);
+            }
+        }
 
-            m_Window->SetOnKeyTyped([](void* data, char key, Modifier modifier)
+        // Only installed while the user has a callback for the event, an installed callback changes what some backends do
+        // (Win32 stops promoting pointer input to mouse messages once OnTouch is set, and buffers text for OnTextInput)
+        template<EventType Type>
+        void SetDebugCallback(bool install)
+        requires (InterceptsEvents)
+        {
+            if (!install)
             {
-                PULSARION_LOG_TRACE("[Window::OnKeyTyped] Window key typed callback called with key {0}, modifier {1}", key, static_cast<std::uint16_t>(modifier));
-                const auto& state = static_cast<WindowData*>(data);
-                if (state->OnKeyTyped)
-                    state->OnKeyTyped(data, key, modifier);
-            });
+                SetWindowCallback<Type>(m_Window, nullptr);
+                return;
+            }
+            if constexpr (Type == EventType::Close)
+                m_Window.SetOnClose([](void* data) -> bool
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnClose] Window close callback called");
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnClose)
+                        return Invoke<EventType::Close>(state, state->OnClose);
+                    return true;
+                });
+            else if constexpr (Type == EventType::WindowVisibility)
+                m_Window.SetOnWindowVisibility([](void* data, bool visible)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnWindowVisibility] Window visibility callback called with visibility {0}", visible);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnWindowVisibility)
+                        Invoke<EventType::WindowVisibility>(state, state->OnWindowVisibility, visible);
+                });
+            else if constexpr (Type == EventType::Focus)
+                m_Window.SetOnFocus([](void* data, bool focused)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnFocus] Window focus callback called with focus {0}", focused);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnFocus)
+                        Invoke<EventType::Focus>(state, state->OnFocus, focused);
+                });
+            else if constexpr (Type == EventType::Resize)
+                m_Window.SetOnResize([](void* data, std::uint32_t width, std::uint32_t height)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnResize] Window resize callback called with width {0} and height {1}", width, height);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnResize)
+                        Invoke<EventType::Resize>(state, state->OnResize, width, height);
+                });
+            else if constexpr (Type == EventType::Move)
+                m_Window.SetOnMove([](void* data, std::uint32_t x, std::uint32_t y)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMove] Window move callback called with x {0} and y {1}", x, y);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMove)
+                        Invoke<EventType::Move>(state, state->OnMove, x, y);
+                });
+            else if constexpr (Type == EventType::BeforeResize)
+                m_Window.SetBeforeResize([](void* data)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::BeforeResize] Window before resize callback called");
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->BeforeResize)
+                        Invoke<EventType::BeforeResize>(state, state->BeforeResize);
+                });
+            else if constexpr (Type == EventType::AfterResize)
+                m_Window.SetAfterResize([](void* data, std::uint32_t width, std::uint32_t height)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::AfterResize] Window after resize callback called with width {0} and height {1}", width, height);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->AfterResize)
+                        Invoke<EventType::AfterResize>(state, state->AfterResize, width, height);
+                });
+            else if constexpr (Type == EventType::Minimize)
+                m_Window.SetOnMinimize([](void* data)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMinimize] Window minimize callback called");
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMinimize)
+                        Invoke<EventType::Minimize>(state, state->OnMinimize);
+                });
+            else if constexpr (Type == EventType::Maximize)
+                m_Window.SetOnMaximize([](void* data)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMaximize] Window maximize callback called");
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMaximize)
+                        Invoke<EventType::Maximize>(state, state->OnMaximize);
+                });
+            else if constexpr (Type == EventType::Fullscreen)
+                m_Window.SetOnFullscreen([](void* data, bool fullscreen)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnFullscreen] Window fullscreen callback called with fullscreen {0}", fullscreen);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnFullscreen)
+                        Invoke<EventType::Fullscreen>(state, state->OnFullscreen, fullscreen);
+                });
+            else if constexpr (Type == EventType::Restore)
+                m_Window.SetOnRestore([](void* data)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnRestore] Window restore callback called");
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnRestore)
+                        Invoke<EventType::Restore>(state, state->OnRestore);
+                });
+            else if constexpr (Type == EventType::Occlusion)
+                m_Window.SetOnOcclusion([](void* data, bool occluded)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnOcclusion] Window occlusion callback called with occluded {0}", occluded);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnOcclusion)
+                        Invoke<EventType::Occlusion>(state, state->OnOcclusion, occluded);
+                });
+            else if constexpr (Type == EventType::MouseEnter)
+                m_Window.SetOnMouseEnter([](void* data)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMouseEnter] Window mouse enter callback called");
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMouseEnter)
+                        Invoke<EventType::MouseEnter>(state, state->OnMouseEnter);
+                });
+            else if constexpr (Type == EventType::MouseLeave)
+                m_Window.SetOnMouseLeave([](void* data)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMouseLeave] Window mouse enter callback called");
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMouseLeave)
+                        Invoke<EventType::MouseLeave>(state, state->OnMouseLeave);
+                });
+            else if constexpr (Type == EventType::MouseDown)
+                m_Window.SetOnMouseDown([](void* data, Point position, MouseCode button)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMouseDown] Window mouse down callback called with button {0} and position ({1}, {2})", static_cast<std::uint8_t>(button), position.x, position.y);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMouseDown)
+                        Invoke<EventType::MouseDown>(state, state->OnMouseDown, position, button);
+                });
+            else if constexpr (Type == EventType::MouseUp)
+                m_Window.SetOnMouseUp([](void* data, Point position, MouseCode button)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMouseUp] Window mouse up callback called with button {0} and position ({1}, {2})", static_cast<std::uint8_t>(button), position.x, position.y);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMouseUp)
+                        Invoke<EventType::MouseUp>(state, state->OnMouseUp, position, button);
+                });
+            else if constexpr (Type == EventType::MouseMove)
+                m_Window.SetOnMouseMove([](void* data, Point position)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMouseMove] Window mouse move callback called with position ({0}, {1})", position.x, position.y);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMouseMove)
+                        Invoke<EventType::MouseMove>(state, state->OnMouseMove, position);
+                });
+            else if constexpr (Type == EventType::MouseWheel)
+                m_Window.SetOnMouseWheel([](void* data, Point position, ScrollOffset offset)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnMouseWheel] Window mouse scroll callback called with offset ({0}, {1}) and position ({2}, {3})", offset.x, offset.y, position.x, position.y);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnMouseWheel)
+                        Invoke<EventType::MouseWheel>(state, state->OnMouseWheel, position, offset);
+                });
+            else if constexpr (Type == EventType::RawMouseMove)
+                m_Window.SetOnRawMouseMove([](void* data, Point delta, std::span<const Point> samples)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnRawMouseMove] Window raw mouse move callback called with delta ({0}, {1}) from {2} samples", delta.x, delta.y, samples.size());
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnRawMouseMove)
+                        Invoke<EventType::RawMouseMove>(state, state->OnRawMouseMove, delta, samples);
+                });
+            else if constexpr (Type == EventType::Touch)
+                m_Window.SetOnTouch([](void* data, std::span<const TouchContact> contacts)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnTouch] Window touch callback called with {0} contacts", contacts.size());
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnTouch)
+                        Invoke<EventType::Touch>(state, state->OnTouch, contacts);
+                });
+            else if constexpr (Type == EventType::KeyDown)
+                m_Window.SetOnKeyDown([](void* data, KeyCode key, Modifier modifier, bool repeat)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnKeyDown] Window key down callback called with [key, modifier, repeat]: {0}, {1}, {2}", KeyCodeToString(key), static_cast<std::uint16_t>(modifier), repeat ? "true" : "false");
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnKeyDown)
+                        Invoke<EventType::KeyDown>(state, state->OnKeyDown, key, modifier, repeat);
+                });
+            else if constexpr (Type == EventType::KeyUp)
+                m_Window.SetOnKeyUp([](void* data, KeyCode key, Modifier modifier)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnKeyUp] Window key up callback called with key {0}, modifier {1}", KeyCodeToString(key), static_cast<std::uint16_t>(modifier));
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnKeyUp)
+                        Invoke<EventType::KeyUp>(state, state->OnKeyUp, key, modifier);
+                });
+            else if constexpr (Type == EventType::KeyTyped)
+                m_Window.SetOnKeyTyped([](void* data, char key, Modifier modifier)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnKeyTyped] Window key typed callback called with key {0}, modifier {1}", key, static_cast<std::uint16_t>(modifier));
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnKeyTyped)
+                        Invoke<EventType::KeyTyped>(state, state->OnKeyTyped, key, modifier);
+                });
+            else if constexpr (Type == EventType::TextInput)
+                m_Window.SetOnTextInput([](void* data, std::string_view text)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnTextInput] Window text input callback called with text {0}", text);
+                    const auto& state = static_cast<WindowData*>(data);
+                    if (state->OnTextInput)
+                        Invoke<EventType::TextInput>(state, state->OnTextInput, text);
+                });
         }
 
 
         void LogDeltaTime()
         requires (options.LogDeltaTime)
         {
-            const auto currentTime = std::chrono::steady_clock::now();
+            const auto currentTime = m_Clock.Now();
             const auto deltaTime = std::chrono::duration_cast<std::chrono::microseconds>(currentTime - m_DeltaTime.LastLogTime).count();
             if (deltaTime <= 1'000'000)
                 return;
@@ -237,22 +338,34 @@ namespace Pulsarion::Windowing
             m_DeltaTime.LastLogTime = currentTime;
         }
     public:
-        explicit DebugWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config) : m_Window(CreateSharedWindow(std::move(title), bounds, styles, config)), m_State()
+        explicit DebugWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config, ClockType clock = ClockType())
+            : m_Window(std::move(title), bounds, styles, config), m_State(), m_Clock(std::move(clock))
         {
+            m_DeltaTime.LastLogTime = m_Clock.Now();
+            m_DeltaTime.LastFrameTime = m_DeltaTime.LastLogTime;
+            if constexpr (options.ProfileCallbacks)
+                m_State.Profiler = BasicCallbackProfiler<ClockType>(m_Clock); // Shares the time of a ManualClock
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::Window] Creating window");
-            if constexpr (options.LogEvents)
-                SetDebugCallbacks();
+            if constexpr (InterceptsEvents)
+                m_Window.SetUserData(&m_State);
             if constexpr (options.LogState)
                 LogState();
         }
         ~DebugWindow() override = default;
 
+        // Per event type call counts and times of the callbacks, and the slow call threshold
+        [[nodiscard]] BasicCallbackProfiler<ClockType>& GetCallbackProfiler()
+        requires (options.ProfileCallbacks)
+        {
+            return m_State.Profiler;
+        }
+
         inline void SetVisible(bool visible) override
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetVisible] Setting window visibility to {0}", visible);
-            m_Window->SetVisible(visible);
+            m_Window.SetVisible(visible);
         }
 
         inline void PollEvents() override
@@ -262,47 +375,162 @@ namespace Pulsarion::Windowing
             if constexpr (options.LogDeltaTime)
             {
                 m_DeltaTime.FrameCount++;
-                m_DeltaTime.TotalTimeMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_DeltaTime.LastFrameTime).count();
+                m_DeltaTime.TotalTimeMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(m_Clock.Now() - m_DeltaTime.LastFrameTime).count();
                 LogDeltaTime();
-                m_DeltaTime.LastFrameTime = std::chrono::steady_clock::now();
+                m_DeltaTime.LastFrameTime = m_Clock.Now();
             }
 
-            m_Window->PollEvents();
+            m_Window.PollEvents();
+        }
+
+        inline void WaitEvents(std::optional<std::chrono::nanoseconds> timeout) override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::WaitEvents] Waiting for window events");
+            m_Window.WaitEvents(timeout);
+        }
+
+        inline TimerId AddTimer(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::AddTimer] Adding {0} timer with a period of {1}ns", repeat ? "repeating" : "single shot", period.count());
+            if constexpr (InterceptsEvents)
+            {
+                // The window's user data points to our state while we log events, hand the timer the real one
+                return m_Window.AddTimer(period, [callback = std::move(callback)](void* data, TimerId id)
+                {
+                    if constexpr (options.LogEvents)
+                        PULSARION_LOG_TRACE("[Window::OnTimer] Timer {0} fired", id);
+                    callback(static_cast<WindowData*>(data)->UserData, id);
+                }, repeat);
+            }
+            else
+            {
+                return m_Window.AddTimer(period, std::move(callback), repeat);
+            }
+        }
+
+        inline void RemoveTimer(TimerId id) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::RemoveTimer] Removing timer {0}", id);
+            m_Window.RemoveTimer(id);
         }
 
         [[nodiscard]] inline bool ShouldClose() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::ShouldClose] Checking if window should close");
-            return m_Window->ShouldClose();
+            return m_Window.ShouldClose();
         }
 
         inline void SetShouldClose(bool shouldClose) override
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetShouldClose] Setting window should close to {0}", shouldClose);
-            m_Window->SetShouldClose(shouldClose);
+            m_Window.SetShouldClose(shouldClose);
         }
 
         inline void SetTitle(const std::string& title) override
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetTitle] Setting window title to {0}", title);
-            m_Window->SetTitle(title);
+            m_Window.SetTitle(title);
         }
 
         inline void SetCursorMode(CursorMode mode) override
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetCursorMode] Setting window cursor mode to {0}", static_cast<std::uint8_t>(mode));
-            m_Window->SetCursorMode(mode);
+            m_Window.SetCursorMode(mode);
+        }
+
+        inline void SetCursorShape(CursorShape shape) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetCursorShape] Setting window cursor shape to {0}", static_cast<std::uint8_t>(shape));
+            m_Window.SetCursorShape(shape);
+        }
+
+        inline void SetCursorImage(const ImageView& image, std::uint32_t hotspotX, std::uint32_t hotspotY) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetCursorImage] Setting window cursor to a {0}x{1} image", image.Width, image.Height);
+            m_Window.SetCursorImage(image, hotspotX, hotspotY);
+        }
+
+        inline void SetIcon(std::span<const ImageView> images) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetIcon] Setting window icon from {0} images", images.size());
+            m_Window.SetIcon(images);
+        }
+
+        inline void SetEventMask(EventTypeFlags mask) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetEventMask] Setting window event mask to {0:#x}", static_cast<std::uint32_t>(mask));
+            m_Window.SetEventMask(mask);
+        }
+
+        [[nodiscard]] inline EventTypeFlags GetEventMask() const override
+        {
+            return m_Window.GetEventMask();
+        }
+
+        [[nodiscard]] inline std::uint64_t GetSizeGeneration() const override
+        {
+            return m_Window.GetSizeGeneration();
+        }
+
+        [[nodiscard]] inline WindowSize GetContentSize() const override
+        {
+            return m_Window.GetContentSize();
+        }
+
+        [[nodiscard]] inline DisplayTiming GetDisplayTiming() const override
+        {
+            return m_Window.GetDisplayTiming();
+        }
+
+        inline void SetWatchdog(Watchdog* watchdog) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetWatchdog] {0} the watchdog", watchdog != nullptr ? "Attaching" : "Detaching");
+            m_Window.SetWatchdog(watchdog);
+        }
+
+        inline bool SetClipboard(std::vector<std::string> formats, ClipboardProvider&& provider) override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::SetClipboard] Offering {0} clipboard formats", formats.size());
+            return m_Window.SetClipboard(std::move(formats), std::move(provider));
+        }
+
+        inline void RequestClipboard(std::string format, ClipboardReceiver&& receiver) override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::RequestClipboard] Requesting clipboard format {0}", format);
+            m_Window.RequestClipboard(std::move(format), std::move(receiver));
+        }
+
+        [[nodiscard]] inline bool HasClipboardFormat(std::string_view format) const override
+        {
+            return m_Window.HasClipboardFormat(format);
         }
 
         [[nodiscard]] inline std::optional<std::string> GetTitle() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetTitle] Getting window title");
-            return m_Window->GetTitle();
+            return m_Window.GetTitle();
+        }
+
+        [[nodiscard]] inline std::string_view GetTitleView() const override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::GetTitleView] Getting window title");
+            return m_Window.GetTitleView();
         }
 
         #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
@@ -310,14 +538,14 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::LimitEvents] Setting window event limiting to {0}", limitEvents);
-            m_Window->LimitEvents(limitEvents);
+            m_Window.LimitEvents(limitEvents);
         }
 
         [[nodiscard]] bool IsLimitingEvents() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::IsLimitingEvents] Getting window event limiting");
-            return m_Window->IsLimitingEvents();
+            return m_Window.IsLimitingEvents();
         }
         #endif
 
@@ -325,8 +553,8 @@ namespace Pulsarion::Windowing
         requires (options.LogState)
         {
             PULSARION_LOG_TRACE("[Window::LogState] Window state:");
-            PULSARION_LOG_TRACE("  Title: {0}", m_Window->GetTitle().value_or("No title"));
-            PULSARION_LOG_TRACE("  Should close: {0}", m_Window->ShouldClose()); // We don't use ShouldClose() because it logs the function call
+            PULSARION_LOG_TRACE("  Title: {0}", m_Window.GetTitle().value_or("No title"));
+            PULSARION_LOG_TRACE("  Should close: {0}", m_Window.ShouldClose()); // We don't use ShouldClose() because it logs the function call
         }
 
         // --- Event Callbacks ---
@@ -335,15 +563,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnClose] Setting window close callback");
-            m_State.OnClose = std::move(onClose);
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnClose(std::move(onClose));
+            else
+            {
+                m_State.OnClose = std::move(onClose);
+                SetDebugCallback<EventType::Close>(static_cast<bool>(m_State.OnClose));
+            }
         }
 
-        [[nodiscard]] Window::CloseCallback GetOnClose() const override
+        [[nodiscard]] const Window::CloseCallback& GetOnClose() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnClose] Getting window close callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnClose();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnClose();
             return m_State.OnClose;
         }
 
@@ -351,18 +585,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnWindowVisibility] Setting window visibility callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnWindowVisibility(std::move(onWindowVisibility));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnWindowVisibility(std::move(onWindowVisibility));
             else
+            {
                 m_State.OnWindowVisibility = std::move(onWindowVisibility);
+                SetDebugCallback<EventType::WindowVisibility>(static_cast<bool>(m_State.OnWindowVisibility));
+            }
         }
 
-        [[nodiscard]] Window::VisibilityCallback GetOnWindowVisibility() const override
+        [[nodiscard]] const Window::VisibilityCallback& GetOnWindowVisibility() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnWindowVisibility] Getting window visibility callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnWindowVisibility();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnWindowVisibility();
             return m_State.OnWindowVisibility;
         }
 
@@ -370,18 +607,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnFocus] Setting window focus callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnFocus(std::move(onFocus));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnFocus(std::move(onFocus));
             else
+            {
                 m_State.OnFocus = std::move(onFocus);
+                SetDebugCallback<EventType::Focus>(static_cast<bool>(m_State.OnFocus));
+            }
         }
 
-        [[nodiscard]] Window::FocusCallback GetOnFocus() const override
+        [[nodiscard]] const Window::FocusCallback& GetOnFocus() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnFocus] Getting window focus callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnFocus();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnFocus();
             return m_State.OnFocus;
         }
 
@@ -389,18 +629,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnResize] Setting window resize callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnResize(std::move(onResize));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnResize(std::move(onResize));
             else
+            {
                 m_State.OnResize = std::move(onResize);
+                SetDebugCallback<EventType::Resize>(static_cast<bool>(m_State.OnResize));
+            }
         }
 
-        [[nodiscard]] Window::ResizeCallback GetOnResize() const override
+        [[nodiscard]] const Window::ResizeCallback& GetOnResize() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnResize] Getting window resize callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnResize();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnResize();
             return m_State.OnResize;
         }
 
@@ -408,18 +651,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnMove] Setting window move callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMove(std::move(onMove));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMove(std::move(onMove));
             else
+            {
                 m_State.OnMove = std::move(onMove);
+                SetDebugCallback<EventType::Move>(static_cast<bool>(m_State.OnMove));
+            }
         }
 
-        [[nodiscard]] Window::MoveCallback GetOnMove() const override
+        [[nodiscard]] const Window::MoveCallback& GetOnMove() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnMove] Getting window move callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMove();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMove();
             return m_State.OnMove;
         }
 
@@ -427,37 +673,65 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetBeforeResize] Setting window before resize callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetBeforeResize(std::move(beforeResize));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetBeforeResize(std::move(beforeResize));
             else
+            {
                 m_State.BeforeResize = std::move(beforeResize);
+                SetDebugCallback<EventType::BeforeResize>(static_cast<bool>(m_State.BeforeResize));
+            }
         }
 
-        [[nodiscard]] Window::BeforeResizeCallback GetBeforeResize() const override
+        [[nodiscard]] const Window::BeforeResizeCallback& GetBeforeResize() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetBeforeResize] Getting window before resize callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetBeforeResize();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetBeforeResize();
             return m_State.BeforeResize;
         }
 
+        void SetAfterResize(Window::AfterResizeCallback&& afterResize) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetAfterResize] Setting window after resize callback");
+            if constexpr (!InterceptsEvents)
+                m_Window.SetAfterResize(std::move(afterResize));
+            else
+            {
+                m_State.AfterResize = std::move(afterResize);
+                SetDebugCallback<EventType::AfterResize>(static_cast<bool>(m_State.AfterResize));
+            }
+        }
+
+        [[nodiscard]] const Window::AfterResizeCallback& GetAfterResize() const override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::GetAfterResize] Getting window after resize callback");
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetAfterResize();
+            return m_State.AfterResize;
+        }
+
         void SetOnMinimize(Window::MinimizeCallback&& onMinimize) override
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetMinimize] Setting window minimize callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMinimize(std::move(onMinimize));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMinimize(std::move(onMinimize));
             else
+            {
                 m_State.OnMinimize = std::move(onMinimize);
+                SetDebugCallback<EventType::Minimize>(static_cast<bool>(m_State.OnMinimize));
+            }
         }
 
-        [[nodiscard]] Window::MinimizeCallback GetOnMinimize() const override
+        [[nodiscard]] const Window::MinimizeCallback& GetOnMinimize() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetMinimize] Getting window minimize callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMinimize();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMinimize();
             return m_State.OnMinimize;
         }
 
@@ -465,18 +739,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetMaximize] Setting window maximize callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMaximize(std::move(onMaximize));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMaximize(std::move(onMaximize));
             else
+            {
                 m_State.OnMaximize = std::move(onMaximize);
+                SetDebugCallback<EventType::Maximize>(static_cast<bool>(m_State.OnMaximize));
+            }
         }
 
-        [[nodiscard]] Window::MaximizeCallback GetOnMaximize() const override
+        [[nodiscard]] const Window::MaximizeCallback& GetOnMaximize() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetMaximize] Getting window maximize callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMaximize();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMaximize();
             return m_State.OnMaximize;
         }
 
@@ -484,18 +761,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetFullscreen] Setting window fullscreen callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnFullscreen(std::move(onFullscreen));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnFullscreen(std::move(onFullscreen));
             else
+            {
                 m_State.OnFullscreen = std::move(onFullscreen);
+                SetDebugCallback<EventType::Fullscreen>(static_cast<bool>(m_State.OnFullscreen));
+            }
         }
 
-        [[nodiscard]] Window::FullscreenCallback GetOnFullscreen() const override
+        [[nodiscard]] const Window::FullscreenCallback& GetOnFullscreen() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetFullscreen] Getting window fullscreen callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnFullscreen();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnFullscreen();
             return m_State.OnFullscreen;
         }
 
@@ -503,37 +783,65 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetRestore] Setting window restore callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnRestore(std::move(onRestore));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnRestore(std::move(onRestore));
             else
+            {
                 m_State.OnRestore = std::move(onRestore);
+                SetDebugCallback<EventType::Restore>(static_cast<bool>(m_State.OnRestore));
+            }
         }
 
-        [[nodiscard]] Window::RestoreCallback GetOnRestore() const override
+        [[nodiscard]] const Window::RestoreCallback& GetOnRestore() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetRestore] Getting window restore callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnRestore();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnRestore();
             return m_State.OnRestore;
         }
 
+        void SetOnOcclusion(Window::OcclusionCallback&& onOcclusion) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetOnOcclusion] Setting window occlusion callback");
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnOcclusion(std::move(onOcclusion));
+            else
+            {
+                m_State.OnOcclusion = std::move(onOcclusion);
+                SetDebugCallback<EventType::Occlusion>(static_cast<bool>(m_State.OnOcclusion));
+            }
+        }
+
+        [[nodiscard]] const Window::OcclusionCallback& GetOnOcclusion() const override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::GetOnOcclusion] Getting window occlusion callback");
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnOcclusion();
+            return m_State.OnOcclusion;
+        }
+
         void SetOnMouseEnter(Window::MouseEnterCallback&& onMouseEnter) override
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnMouseEnter] Setting window mouse enter callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMouseEnter(std::move(onMouseEnter));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMouseEnter(std::move(onMouseEnter));
             else
+            {
                 m_State.OnMouseEnter = std::move(onMouseEnter);
+                SetDebugCallback<EventType::MouseEnter>(static_cast<bool>(m_State.OnMouseEnter));
+            }
         }
 
-        [[nodiscard]] Window::MouseEnterCallback GetOnMouseEnter() const override
+        [[nodiscard]] const Window::MouseEnterCallback& GetOnMouseEnter() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnMouseEnter] Getting window mouse enter callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMouseEnter();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMouseEnter();
             return m_State.OnMouseEnter;
         }
 
@@ -541,18 +849,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnMouseLeave] Setting window mouse enter callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMouseLeave(std::move(onMouseLeave));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMouseLeave(std::move(onMouseLeave));
             else
+            {
                 m_State.OnMouseLeave = std::move(onMouseLeave);
+                SetDebugCallback<EventType::MouseLeave>(static_cast<bool>(m_State.OnMouseLeave));
+            }
         }
 
-        [[nodiscard]] Window::MouseLeaveCallback GetOnMouseLeave() const override
+        [[nodiscard]] const Window::MouseLeaveCallback& GetOnMouseLeave() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnMouseLeave] Getting window mouse enter callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMouseLeave();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMouseLeave();
             return m_State.OnMouseLeave;
         }
 
@@ -560,18 +871,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnMouseDown] Setting window mouse down callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMouseDown(std::move(onMouseDown));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMouseDown(std::move(onMouseDown));
             else
+            {
                 m_State.OnMouseDown = std::move(onMouseDown);
+                SetDebugCallback<EventType::MouseDown>(static_cast<bool>(m_State.OnMouseDown));
+            }
         }
 
-        [[nodiscard]] Window::MouseDownCallback GetOnMouseDown() const override
+        [[nodiscard]] const Window::MouseDownCallback& GetOnMouseDown() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnMouseDown] Getting window mouse down callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMouseDown();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMouseDown();
             return m_State.OnMouseDown;
         }
 
@@ -579,18 +893,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnMouseUp] Setting window mouse up callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMouseUp(std::move(onMouseUp));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMouseUp(std::move(onMouseUp));
             else
+            {
                 m_State.OnMouseUp = std::move(onMouseUp);
+                SetDebugCallback<EventType::MouseUp>(static_cast<bool>(m_State.OnMouseUp));
+            }
         }
 
-        [[nodiscard]] Window::MouseUpCallback GetOnMouseUp() const override
+        [[nodiscard]] const Window::MouseUpCallback& GetOnMouseUp() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnMouseUp] Getting window mouse up callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMouseUp();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMouseUp();
             return m_State.OnMouseUp;
         }
 
@@ -598,18 +915,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnMouseMove] Setting window mouse move callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMouseMove(std::move(onMouseMove));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMouseMove(std::move(onMouseMove));
             else
+            {
                 m_State.OnMouseMove = std::move(onMouseMove);
+                SetDebugCallback<EventType::MouseMove>(static_cast<bool>(m_State.OnMouseMove));
+            }
         }
 
-        [[nodiscard]] Window::MouseMoveCallback GetOnMouseMove() const override
+        [[nodiscard]] const Window::MouseMoveCallback& GetOnMouseMove() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnMouseMove] Getting window mouse move callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMouseMove();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMouseMove();
             return m_State.OnMouseMove;
         }
 
@@ -617,37 +937,87 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnMouseWheel] Setting window mouse scroll callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnMouseWheel(std::move(onMouseWheel));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnMouseWheel(std::move(onMouseWheel));
             else
+            {
                 m_State.OnMouseWheel = std::move(onMouseWheel);
+                SetDebugCallback<EventType::MouseWheel>(static_cast<bool>(m_State.OnMouseWheel));
+            }
         }
 
-        [[nodiscard]] Window::MouseWheelCallback GetOnMouseWheel() const override
+        [[nodiscard]] const Window::MouseWheelCallback& GetOnMouseWheel() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnMouseWheel] Getting window mouse scroll callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnMouseWheel();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnMouseWheel();
             return m_State.OnMouseWheel;
         }
 
+        void SetOnRawMouseMove(Window::RawMouseMoveCallback&& onRawMouseMove) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetOnRawMouseMove] Setting window raw mouse move callback");
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnRawMouseMove(std::move(onRawMouseMove));
+            else
+            {
+                m_State.OnRawMouseMove = std::move(onRawMouseMove);
+                SetDebugCallback<EventType::RawMouseMove>(static_cast<bool>(m_State.OnRawMouseMove));
+            }
+        }
+
+        [[nodiscard]] const Window::RawMouseMoveCallback& GetOnRawMouseMove() const override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::GetOnRawMouseMove] Getting window raw mouse move callback");
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnRawMouseMove();
+            return m_State.OnRawMouseMove;
+        }
+
+        void SetOnTouch(Window::TouchCallback&& onTouch) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetOnTouch] Setting window touch callback");
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnTouch(std::move(onTouch));
+            else
+            {
+                m_State.OnTouch = std::move(onTouch);
+                SetDebugCallback<EventType::Touch>(static_cast<bool>(m_State.OnTouch));
+            }
+        }
+
+        [[nodiscard]] const Window::TouchCallback& GetOnTouch() const override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::GetOnTouch] Getting window touch callback");
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnTouch();
+            return m_State.OnTouch;
+        }
+
         void SetOnKeyDown(Window::KeyDownCallback&& onKeyDown) override
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnKeyDown] Setting window key down callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnKeyDown(std::move(onKeyDown));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnKeyDown(std::move(onKeyDown));
             else
+            {
                 m_State.OnKeyDown = std::move(onKeyDown);
+                SetDebugCallback<EventType::KeyDown>(static_cast<bool>(m_State.OnKeyDown));
+            }
         }
 
-        [[nodiscard]] Window::KeyDownCallback GetOnKeyDown() const override
+        [[nodiscard]] const Window::KeyDownCallback& GetOnKeyDown() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnKeyDown] Getting window key down callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnKeyDown();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnKeyDown();
             return m_State.OnKeyDown;
         }
 
@@ -655,18 +1025,21 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnKeyUp] Setting window key up callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnKeyUp(std::move(onKeyUp));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnKeyUp(std::move(onKeyUp));
             else
+            {
                 m_State.OnKeyUp = std::move(onKeyUp);
+                SetDebugCallback<EventType::KeyUp>(static_cast<bool>(m_State.OnKeyUp));
+            }
         }
 
-        [[nodiscard]] Window::KeyUpCallback GetOnKeyUp() const override
+        [[nodiscard]] const Window::KeyUpCallback& GetOnKeyUp() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnKeyUp] Getting window key up callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnKeyUp();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnKeyUp();
             return m_State.OnKeyUp;
         }
 
@@ -675,27 +1048,52 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetOnKeyTyped] Setting window key typed callback");
-            if constexpr (!options.LogEvents)
-                m_Window->SetOnKeyTyped(std::move(onKeyTyped));
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnKeyTyped(std::move(onKeyTyped));
             else
+            {
                 m_State.OnKeyTyped = std::move(onKeyTyped);
+                SetDebugCallback<EventType::KeyTyped>(static_cast<bool>(m_State.OnKeyTyped));
+            }
         }
 
-        [[nodiscard]] Window::KeyTypedCallback GetOnKeyTyped() const override
+        [[nodiscard]] const Window::KeyTypedCallback& GetOnKeyTyped() const override
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetOnKeyTyped] Getting window key typed callback");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetOnKeyTyped();
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnKeyTyped();
             return m_State.OnKeyTyped;
         }
 
+        void SetOnTextInput(Window::TextInputCallback&& onTextInput) override
+        {
+            if constexpr (options.LogToggles)
+                PULSARION_LOG_TRACE("[Window::SetOnTextInput] Setting window text input callback");
+            if constexpr (!InterceptsEvents)
+                m_Window.SetOnTextInput(std::move(onTextInput));
+            else
+            {
+                m_State.OnTextInput = std::move(onTextInput);
+                SetDebugCallback<EventType::TextInput>(static_cast<bool>(m_State.OnTextInput));
+            }
+        }
+
+        [[nodiscard]] const Window::TextInputCallback& GetOnTextInput() const override
+        {
+            if constexpr (options.LogCalls)
+                PULSARION_LOG_TRACE("[Window::GetOnTextInput] Getting window text input callback");
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetOnTextInput();
+            return m_State.OnTextInput;
+        }
+
         void SetUserData(void* userData) override
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::SetUserData] Setting window user data");
-            if constexpr (!options.LogEvents)
-                m_Window->SetUserData(userData);
+            if constexpr (!InterceptsEvents)
+                m_Window.SetUserData(userData);
             else
                 m_State.UserData = userData;
         }
@@ -704,8 +1102,8 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogToggles)
                 PULSARION_LOG_TRACE("[Window::GetUserData] Getting window user data");
-            if constexpr (!options.LogEvents)
-                return m_Window->GetUserData(); // We don't use the state
+            if constexpr (!InterceptsEvents)
+                return m_Window.GetUserData(); // We don't use the state
 
             return m_State.UserData;
         }
@@ -714,13 +1112,13 @@ namespace Pulsarion::Windowing
         {
             if constexpr (options.LogCalls)
                 PULSARION_LOG_TRACE("[Window::GetNativeWindow] Getting window native window");
-            return m_Window->GetNativeWindow();
+            return m_Window.GetNativeWindow();
         }
 
     private:
-        struct None { };
-        std::shared_ptr<Window> m_Window;
+        T m_Window;
         WindowData  m_State;
+        [[no_unique_address]] ClockType m_Clock;
         DeltaTime m_DeltaTime;
     };
 }
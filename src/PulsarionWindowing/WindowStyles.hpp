@@ -24,6 +24,7 @@ namespace Pulsarion::Windowing
     {
         bool StartVisible = true;
         bool StartFocused = true;
+        bool LazyRealize = false; // Defer creating the native window until the first SetVisible(true), StartVisible is ignored
     };
 
     enum class WindowStyles : std::uint64_t
@@ -0,0 +1,261 @@
+#include "Clipboard.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <utility>
+
+namespace Pulsarion::Windowing
+{
+    // Input and output text is converted in pieces of this many bytes (UTF-8) or units (UTF-16), so no whole copy is made
+    constexpr std::size_t TextConversionChunk = ClipboardChunkSize / 3;
+
+    // Grows a movable global memory block, the only storage SetClipboardData takes
+    class GlobalMemoryWriter final : public ClipboardWriter
+    {
+    public:
+        GlobalMemoryWriter() = default;
+        ~GlobalMemoryWriter() override
+        {
+            if (m_Handle)
+                GlobalFree(m_Handle);
+        }
+
+        GlobalMemoryWriter(const GlobalMemoryWriter&) = delete;
+        GlobalMemoryWriter& operator=(const GlobalMemoryWriter&) = delete;
+
+        void Reserve(std::size_t size) override
+        {
+            Grow(size, true);
+        }
+
+        void Write(std::span<const std::byte> data) override
+        {
+            if (data.empty() || m_Failed || !Grow(m_Size + data.size(), false))
+                return;
+            auto* memory = static_cast<std::byte*>(GlobalLock(m_Handle));
+            std::memcpy(memory + m_Size, data.data(), data.size());
+            GlobalUnlock(m_Handle);
+            m_Size += data.size();
+        }
+
+        [[nodiscard]] std::size_t GetSize() const { return m_Size; }
+
+        // Gives up ownership of the block, trimmed to what was written
+        HGLOBAL Release()
+        {
+            if (m_Failed || m_Handle == nullptr)
+                return nullptr;
+            if (m_Capacity > m_Size)
+            {
+                if (HGLOBAL trimmed = GlobalReAlloc(m_Handle, std::max<std::size_t>(m_Size, 1), GMEM_MOVEABLE))
+                    m_Handle = trimmed;
+            }
+            return std::exchange(m_Handle, nullptr);
+        }
+
+    private:
+        bool Grow(std::size_t capacity, bool exact)
+        {
+            if (capacity <= m_Capacity)
+                return true;
+            if (!exact)
+                capacity = std::max(capacity, m_Capacity * 2);
+            HGLOBAL handle = m_Handle ? GlobalReAlloc(m_Handle, capacity, GMEM_MOVEABLE) : GlobalAlloc(GMEM_MOVEABLE, capacity);
+            if (handle == nullptr)
+            {
+                m_Failed = true;
+                return false;
+            }
+            m_Handle = handle;
+            m_Capacity = capacity;
+            return true;
+        }
+
+        HGLOBAL m_Handle = nullptr;
+        std::size_t m_Size = 0;
+        std::size_t m_Capacity = 0;
+        bool m_Failed = false;
+    };
+
+    static std::size_t GetSequenceLength(unsigned char lead)
+    {
+        if ((lead & 0xE0) == 0xC0)
+            return 2;
+        if ((lead & 0xF0) == 0xE0)
+            return 3;
+        if ((lead & 0xF8) == 0xF0)
+            return 4;
+        return 1; // ASCII, and invalid bytes that become U+FFFD on their own
+    }
+
+    // The length of the bytes without a sequence that is cut off at the end
+    static std::size_t GetCompleteLength(std::span<const std::byte> bytes)
+    {
+        const std::size_t lookback = std::min<std::size_t>(bytes.size(), 3);
+        for (std::size_t i = 1; i <= lookback; i++)
+        {
+            const auto byte = static_cast<unsigned char>(bytes[bytes.size() - i]);
+            if ((byte & 0xC0) == 0x80)
+                continue; // Continuation byte, keep looking for the lead
+            return GetSequenceLength(byte) > i ? bytes.size() - i : bytes.size();
+        }
+        return bytes.size();
+    }
+
+    // Converts the UTF-8 the provider writes into the null terminated UTF-16 CF_UNICODETEXT wants, one piece at a time
+    class Utf16GlobalWriter final : public ClipboardWriter
+    {
+    public:
+        void Reserve(std::size_t size) override
+        {
+            // A UTF-8 byte never becomes more than one UTF-16 unit
+            m_Memory.Reserve((size + 1) * sizeof(wchar_t));
+        }
+
+        void Write(std::span<const std::byte> data) override
+        {
+            // Finish a sequence the last write cut off
+            if (!m_Carry.empty())
+            {
+                const std::size_t length = GetSequenceLength(static_cast<unsigned char>(m_Carry[0]));
+                const std::size_t take = std::min(length - m_Carry.size(), data.size());
+                m_Carry.append(reinterpret_cast<const char*>(data.data()), take);
+                data = data.subspan(take);
+                if (m_Carry.size() < length)
+                    return;
+                Convert(std::as_bytes(std::span(m_Carry.data(), m_Carry.size())));
+                m_Carry.clear();
+            }
+
+            while (!data.empty())
+            {
+                const auto piece = data.first(std::min(data.size(), TextConversionChunk));
+                const std::size_t complete = GetCompleteLength(piece);
+                if (complete == 0)
+                {
+                    // Only the start of a sequence is left, the next write has the rest
+                    m_Carry.assign(reinterpret_cast<const char*>(piece.data()), piece.size());
+                    return;
+                }
+                Convert(piece.first(complete));
+                data = data.subspan(complete);
+            }
+        }
+
+        HGLOBAL Release()
+        {
+            if (m_Memory.GetSize() == 0 && m_Carry.empty())
+                return nullptr;
+            const wchar_t terminator = L'\0';
+            m_Memory.Write(std::as_bytes(std::span(&terminator, 1)));
+            return m_Memory.Release();
+        }
+
+    private:
+        void Convert(std::span<const std::byte> utf8)
+        {
+            const auto* text = reinterpret_cast<const char*>(utf8.data());
+            const int length = static_cast<int>(utf8.size());
+            const int units = MultiByteToWideChar(CP_UTF8, 0, text, length, nullptr, 0);
+            if (units <= 0)
+                return;
+            m_Buffer.resize(static_cast<std::size_t>(units));
+            MultiByteToWideChar(CP_UTF8, 0, text, length, m_Buffer.data(), units);
+            m_Memory.Write(std::as_bytes(std::span(m_Buffer.data(), m_Buffer.size())));
+        }
+
+        GlobalMemoryWriter m_Memory;
+        std::wstring m_Buffer; // Reused for every piece
+        std::string m_Carry;
+    };
+
+    UINT GetNativeClipboardFormat(std::string_view format)
+    {
+        if (format == ClipboardTextFormat)
+            return CF_UNICODETEXT;
+        if (format == ClipboardPngFormat)
+            return RegisterClipboardFormatW(L"PNG");
+        // MIME types are ASCII, widening each character is enough
+        const std::wstring name(format.begin(), format.end());
+        return RegisterClipboardFormatW(name.c_str());
+    }
+
+    HGLOBAL RenderClipboardData(UINT nativeFormat, std::string_view format, const ClipboardProvider& provider, void* userData)
+    {
+        if (!provider)
+            return nullptr;
+        if (nativeFormat == CF_UNICODETEXT)
+        {
+            Utf16GlobalWriter writer;
+            provider(userData, format, writer);
+            return writer.Release();
+        }
+        GlobalMemoryWriter writer;
+        provider(userData, format, writer);
+        return writer.GetSize() != 0 ? writer.Release() : nullptr;
+    }
+
+    static void ReadBytes(std::span<const std::byte> data, const ClipboardReceiver& receiver, void* userData)
+    {
+        if (data.empty())
+        {
+            receiver(userData, {}, ClipboardStatus::Done);
+            return;
+        }
+        for (std::size_t offset = 0; offset < data.size(); offset += ClipboardChunkSize)
+        {
+            const std::size_t size = std::min(ClipboardChunkSize, data.size() - offset);
+            const bool last = offset + size == data.size();
+            receiver(userData, data.subspan(offset, size), last ? ClipboardStatus::Done : ClipboardStatus::More);
+        }
+    }
+
+    static void ReadText(std::span<const wchar_t> text, const ClipboardReceiver& receiver, void* userData)
+    {
+        if (text.empty())
+        {
+            receiver(userData, {}, ClipboardStatus::Done);
+            return;
+        }
+        std::string buffer;
+        buffer.resize(TextConversionChunk * 3); // A UTF-16 unit never becomes more than three UTF-8 bytes
+        std::size_t offset = 0;
+        while (offset < text.size())
+        {
+            std::size_t count = std::min(TextConversionChunk, text.size() - offset);
+            // Don't split a surrogate pair between two pieces
+            const wchar_t lastUnit = text[offset + count - 1];
+            if (offset + count < text.size() && count > 1 && lastUnit >= 0xD800 && lastUnit <= 0xDBFF)
+                count--;
+            const int size = WideCharToMultiByte(CP_UTF8, 0, text.data() + offset, static_cast<int>(count), buffer.data(), static_cast<int>(buffer.size()), nullptr, nullptr);
+            offset += count;
+            const bool last = offset == text.size();
+            receiver(userData, std::as_bytes(std::span(buffer.data(), static_cast<std::size_t>(std::max(size, 0)))), last ? ClipboardStatus::Done : ClipboardStatus::More);
+        }
+    }
+
+    void ReadClipboardData(UINT nativeFormat, const ClipboardReceiver& receiver, void* userData)
+    {
+        HANDLE handle = nativeFormat != 0 && IsClipboardFormatAvailable(nativeFormat) ? GetClipboardData(nativeFormat) : nullptr;
+        const void* memory = handle ? GlobalLock(handle) : nullptr;
+        if (memory == nullptr)
+        {
+            receiver(userData, {}, ClipboardStatus::Unavailable);
+            return;
+        }
+
+        const std::size_t size = GlobalSize(handle);
+        if (nativeFormat == CF_UNICODETEXT)
+        {
+            const auto* text = static_cast<const wchar_t*>(memory);
+            ReadText({ text, wcsnlen(text, size / sizeof(wchar_t)) }, receiver, userData);
+        }
+        else
+        {
+            ReadBytes({ static_cast<const std::byte*>(memory), size }, receiver, userData);
+        }
+        GlobalUnlock(handle);
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../Clipboard.hpp"
+
+#include <Windows.h>
+
+#include <string_view>
+
+namespace Pulsarion::Windowing
+{
+    // CF_UNICODETEXT for text, "PNG" for PNG like other Windows applications use, every other MIME type is registered by name. 0 on failure.
+    UINT GetNativeClipboardFormat(std::string_view format);
+
+    // Lets the provider write the format into a global memory block for SetClipboardData, text is converted to UTF-16 as it is written.
+    // Returns nullptr when the provider wrote nothing or the allocation failed.
+    HGLOBAL RenderClipboardData(UINT nativeFormat, std::string_view format, const ClipboardProvider& provider, void* userData);
+
+    // Calls the receiver with the format in chunks, the clipboard has to be open. The chunks point into the clipboard's own memory,
+    // only text is converted to UTF-8 a chunk at a time.
+    void ReadClipboardData(UINT nativeFormat, const ClipboardReceiver& receiver, void* userData);
+}
@@ -1,108 +1,255 @@
 #include "Window.hpp"
 
+#include "../KeyTable.hpp"
+#include "../Watchdog.hpp"
+#include "Clipboard.hpp"
+
 #include "PulsarionCore/Assert.hpp"
 
+#include <dwmapi.h>
+
+#include <algorithm>
+#include <cmath>
+
 namespace Pulsarion::Windowing
 {
-    static std::string GetUniqueName() {
-        static int counter = 0;
-        return "PulsarionWindow" + std::to_string(counter++);
-    }
-
-    KeyCode ConvertFromVirtualKey(UINT vkCode) {
-        if (vkCode >= 'A' && vkCode <= 'Z') {
-            return static_cast<KeyCode>(vkCode);
-        }
-        if (vkCode >= '0' && vkCode <= '9') {
-            return static_cast<KeyCode>(vkCode);
-        }
-
-        switch (vkCode) {
-            case VK_BACK: return KeyCode::Backspace;
-            case VK_TAB: return KeyCode::Tab;
-            //case VK_CLEAR:
-            case VK_RETURN: return KeyCode::Enter;
-            case VK_SHIFT: return KeyCode::LeftShift;
-            case VK_CONTROL: return KeyCode::LeftControl;
-            case VK_MENU: return KeyCode::LeftAlt;
-            case VK_PAUSE: return KeyCode::Pause;
-            case VK_CAPITAL: return KeyCode::CapsLock;
-            case VK_ESCAPE: return KeyCode::Escape;
-            case VK_SPACE: return KeyCode::Space;
-            case VK_PRIOR: return KeyCode::PageUp;
-            case VK_NEXT: return KeyCode::PageDown;
-            case VK_END: return KeyCode::End;
-            case VK_HOME: return KeyCode::Home;
-            case VK_LEFT: return KeyCode::Left;
-            case VK_UP: return KeyCode::Up;
-            case VK_RIGHT: return KeyCode::Right;
-            case VK_DOWN: return KeyCode::Down;
-            //case VK_SELECT: return KeyCode::Select;
-            //case VK_PRINT: return KeyCode::Print;
-            //case VK_EXECUTE: return KeyCode::Execute;
-            case VK_SNAPSHOT: return KeyCode::PrintScreen;
-            case VK_INSERT: return KeyCode::Insert;
-            case VK_DELETE: return KeyCode::Delete;
-            //case VK_HELP: return KeyCode::Help;
-            case VK_F1: return KeyCode::F1;
-            case VK_F2: return KeyCode::F2;
-            case VK_F3: return KeyCode::F3;
-            case VK_F4: return KeyCode::F4;
-            case VK_F5: return KeyCode::F5;
-            case VK_F6: return KeyCode::F6;
-            case VK_F7: return KeyCode::F7;
-            case VK_F8: return KeyCode::F8;
-            case VK_F9: return KeyCode::F9;
-            case VK_F10: return KeyCode::F10;
-            case VK_F11: return KeyCode::F11;
-            case VK_F12: return KeyCode::F12;
-            case VK_F13: return KeyCode::F13;
-            case VK_F14: return KeyCode::F14;
-            case VK_F15: return KeyCode::F15;
-            case VK_F16: return KeyCode::F16;
-            case VK_F17: return KeyCode::F17;
-            case VK_F18: return KeyCode::F18;
-            case VK_F19: return KeyCode::F19;
-            case VK_F20: return KeyCode::F20;
-            case VK_F21: return KeyCode::F21;
-            case VK_F22: return KeyCode::F22;
-            case VK_F23: return KeyCode::F23;
-            case VK_F24: return KeyCode::F24;
-            case VK_NUMLOCK: return KeyCode::NumLock;
-            case VK_SCROLL: return KeyCode::ScrollLock;
-            case VK_LSHIFT: return KeyCode::LeftShift;
-            case VK_RSHIFT: return KeyCode::RightShift;
-            case VK_LCONTROL: return KeyCode::LeftControl;
-            case VK_RCONTROL: return KeyCode::RightControl;
-            case VK_LMENU: return KeyCode::LeftAlt;
-            case VK_RMENU: return KeyCode::RightAlt;
-            case VK_OEM_1: return KeyCode::Semicolon;
-            case VK_OEM_PLUS: return KeyCode::Equal;
-            case VK_OEM_COMMA: return KeyCode::Comma;
-            case VK_OEM_MINUS: return KeyCode::Minus;
-            case VK_OEM_PERIOD: return KeyCode::Period;
-            case VK_OEM_2: return KeyCode::Slash;
-            case VK_OEM_3: return KeyCode::GraveAccent;
-            case VK_OEM_4: return KeyCode::LeftBracket;
-            case VK_OEM_5: return KeyCode::Backslash;
-            case VK_OEM_6: return KeyCode::RightBracket;
-            case VK_OEM_7: return KeyCode::Apostrophe;
-            //case VK_OEM_8: return KeyCode::OEM_8;
-            case VK_OEM_102: return KeyCode::Backslash;
-            default: return KeyCode::Unknown;
+    constexpr const wchar_t* WindowClassName = L"PulsarionWindow";
+
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    std::uint32_t WindowsWindow::s_WindowCount = 0;
+
+    // Every window shares one class, the per window state lives in GWLP_USERDATA so the class doesn't need to differ
+    void WindowsWindow::AcquireWindowClass()
+    {
+        if (s_WindowCount++ != 0)
+            return;
+
+        WNDCLASSW wc = {};
+        wc.hInstance = GetModuleHandle(nullptr);
+        wc.lpfnWndProc = WindowProc;
+        wc.lpszClassName = WindowClassName;
+        RegisterClassW(&wc);
+    }
+
+    void WindowsWindow::ReleaseWindowClass()
+    {
+        if (--s_WindowCount == 0)
+            UnregisterClassW(WindowClassName, GetModuleHandle(nullptr));
+    }
+
+    // The window class is registered as unicode so WM_CHAR delivers UTF-16, all strings we expose are UTF-8
+    static std::wstring ToWide(std::string_view utf8)
+    {
+        if (utf8.empty())
+            return {};
+        const int size = MultiByteToWideChar(CP_UTF8, 0, utf8.data(), static_cast<int>(utf8.size()), nullptr, 0);
+        std::wstring result(static_cast<std::size_t>(size), L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, utf8.data(), static_cast<int>(utf8.size()), result.data(), size);
+        return result;
+    }
+
+    static void ClipCursorToClientArea(HWND hWnd)
+    {
+        RECT rect;
+        GetClientRect(hWnd, &rect);
+        MapWindowPoints(hWnd, nullptr, reinterpret_cast<POINT*>(&rect), 2);
+        ClipCursor(&rect);
+    }
+
+    static bool RegisterRawMouse(HWND hWnd, bool enable)
+    {
+        RAWINPUTDEVICE device = {};
+        device.usUsagePage = 0x01; // HID_USAGE_PAGE_GENERIC
+        device.usUsage = 0x02; // HID_USAGE_GENERIC_MOUSE
+        device.dwFlags = enable ? 0 : RIDEV_REMOVE;
+        device.hwndTarget = enable ? hWnd : nullptr;
+        return RegisterRawInputDevices(&device, 1, sizeof(device)) == TRUE;
+    }
+
+    // Records a WM_POINTER message of a touch or pen into the batch, returns false for pointer types we leave to the mouse messages
+    static bool RecordPointer(HWND hWnd, TouchContactBuffer& touches, UINT msg, WPARAM wParam)
+    {
+        const UINT32 id = GET_POINTERID_WPARAM(wParam);
+        POINTER_INPUT_TYPE type = PT_POINTER;
+        if (!GetPointerType(id, &type))
+            return false;
+
+        POINTER_INFO info = {};
+        PointerKind kind = PointerKind::Touch;
+        float pressure = 1.0f;
+        Point tilt = { 0.0f, 0.0f };
+        if (type == PT_PEN)
+        {
+            POINTER_PEN_INFO pen = {};
+            if (!GetPointerPenInfo(id, &pen))
+                return false;
+            info = pen.pointerInfo;
+            kind = (pen.penFlags & (PEN_FLAG_ERASER | PEN_FLAG_INVERTED)) != 0 ? PointerKind::Eraser : PointerKind::Pen;
+            if ((pen.penMask & PEN_MASK_PRESSURE) != 0)
+                pressure = static_cast<float>(pen.pressure) / 1024.0f;
+            if ((pen.penMask & PEN_MASK_TILT_X) != 0)
+                tilt.x = static_cast<float>(pen.tiltX);
+            if ((pen.penMask & PEN_MASK_TILT_Y) != 0)
+                tilt.y = static_cast<float>(pen.tiltY);
+        }
+        else if (type == PT_TOUCH)
+        {
+            POINTER_TOUCH_INFO touch = {};
+            if (!GetPointerTouchInfo(id, &touch))
+                return false;
+            info = touch.pointerInfo;
+            if ((touch.touchMask & TOUCH_MASK_PRESSURE) != 0)
+                pressure = static_cast<float>(touch.pressure) / 1024.0f;
+        }
+        else
+        {
+            return false; // Mice and touchpads only send WM_POINTER with EnableMouseInPointer, which we don't use
+        }
+
+        POINT point = info.ptPixelLocation;
+        ScreenToClient(hWnd, &point);
+        const Point position = { static_cast<float>(point.x), static_cast<float>(point.y) };
+        if ((info.pointerFlags & POINTER_FLAG_CANCELED) != 0)
+            touches.Cancel(id);
+        else if (msg == WM_POINTERDOWN)
+            touches.Begin(id, kind, position, pressure, tilt);
+        else if (msg == WM_POINTERUP)
+            touches.End(id, position);
+        else if ((info.pointerFlags & POINTER_FLAG_INCONTACT) != 0)
+            touches.Move(id, position, pressure, tilt); // A hovering pen isn't a contact
+        return true;
+    }
+
+    static LPCTSTR GetCursorResource(CursorShape shape)
+    {
+        switch (shape)
+        {
+        case CursorShape::IBeam: return IDC_IBEAM;
+        case CursorShape::Crosshair: return IDC_CROSS;
+        case CursorShape::Hand: return IDC_HAND;
+        case CursorShape::ResizeHorizontal: return IDC_SIZEWE;
+        case CursorShape::ResizeVertical: return IDC_SIZENS;
+        case CursorShape::ResizeDiagonalDown: return IDC_SIZENWSE;
+        case CursorShape::ResizeDiagonalUp: return IDC_SIZENESW;
+        case CursorShape::ResizeAll: return IDC_SIZEALL;
+        case CursorShape::NotAllowed: return IDC_NO;
+        case CursorShape::Wait: return IDC_WAIT;
+        default: return IDC_ARROW;
+        }
+    }
+
+    // A cursor (with a hotspot) or an icon from straight RGBA, through a 32 bit DIB so the alpha channel is kept
+    static HICON CreateIconFromImage(const ImageView& image, bool cursor, std::uint32_t hotspotX, std::uint32_t hotspotY)
+    {
+        if (!image.IsValid())
+            return nullptr;
+
+        BITMAPV5HEADER header = {};
+        header.bV5Size = sizeof(header);
+        header.bV5Width = static_cast<LONG>(image.Width);
+        header.bV5Height = -static_cast<LONG>(image.Height); // Negative for rows top to bottom, like ours
+        header.bV5Planes = 1;
+        header.bV5BitCount = 32;
+        header.bV5Compression = BI_BITFIELDS;
+        header.bV5RedMask = 0x00FF0000;
+        header.bV5GreenMask = 0x0000FF00;
+        header.bV5BlueMask = 0x000000FF;
+        header.bV5AlphaMask = 0xFF000000;
+
+        void* bits = nullptr;
+        HDC dc = GetDC(nullptr);
+        HBITMAP color = CreateDIBSection(dc, reinterpret_cast<const BITMAPINFO*>(&header), DIB_RGB_COLORS, &bits, nullptr, 0);
+        ReleaseDC(nullptr, dc);
+        if (color == nullptr)
+            return nullptr;
+
+        // RGBA to BGRA
+        auto* destination = static_cast<std::uint8_t*>(bits);
+        const auto* source = reinterpret_cast<const std::uint8_t*>(image.Pixels.data());
+        const std::size_t pixels = static_cast<std::size_t>(image.Width) * image.Height;
+        for (std::size_t i = 0; i < pixels; i++)
+        {
+            destination[i * 4 + 0] = source[i * 4 + 2];
+            destination[i * 4 + 1] = source[i * 4 + 1];
+            destination[i * 4 + 2] = source[i * 4 + 0];
+            destination[i * 4 + 3] = source[i * 4 + 3];
+        }
+
+        // Unused with a 32 bit color bitmap, but CreateIconIndirect requires one
+        HBITMAP mask = CreateBitmap(static_cast<int>(image.Width), static_cast<int>(image.Height), 1, 1, nullptr);
+        ICONINFO info = {};
+        info.fIcon = cursor ? FALSE : TRUE;
+        info.xHotspot = hotspotX;
+        info.yHotspot = hotspotY;
+        info.hbmMask = mask;
+        info.hbmColor = color;
+        HICON icon = CreateIconIndirect(&info); // Copies the bitmaps
+        DeleteObject(color);
+        DeleteObject(mask);
+        return icon;
+    }
+
+    static bool IsCursorOverClientArea(HWND hWnd)
+    {
+        POINT point;
+        if (!GetCursorPos(&point) || WindowFromPoint(point) != hWnd)
+            return false;
+        ScreenToClient(hWnd, &point);
+        RECT client;
+        GetClientRect(hWnd, &client);
+        return PtInRect(&client, point) != FALSE;
+    }
+
+    // The image of the requested size, or the smallest one bigger than it, or else the biggest one
+    static const ImageView* PickIconImage(std::span<const ImageView> images, std::uint32_t size)
+    {
+        const ImageView* best = nullptr;
+        for (const auto& image : images)
+        {
+            if (!image.IsValid())
+                continue;
+            if (best == nullptr)
+                best = &image;
+            else if (best->Width < size ? image.Width > best->Width : (image.Width >= size && image.Width < best->Width))
+                best = &image;
         }
+        return best;
+    }
+
+    static double QueryRefreshRate(HMONITOR monitor)
+    {
+        MONITORINFOEXW info = {};
+        info.cbSize = sizeof(info);
+        if (!GetMonitorInfoW(monitor, &info))
+            return 0.0;
+        DEVMODEW mode = {};
+        mode.dmSize = sizeof(mode);
+        if (!EnumDisplaySettingsW(info.szDevice, ENUM_CURRENT_SETTINGS, &mode) || mode.dmDisplayFrequency <= 1)
+            return 0.0; // 0 and 1 mean the hardware default, which we can't know
+        return static_cast<double>(mode.dmDisplayFrequency);
+    }
+
+    void WindowsWindow::UpdateMonitor(HWND hWnd, Data& data)
+    {
+        const HMONITOR monitor = MonitorFromWindow(hWnd, MONITOR_DEFAULTTONEAREST);
+        if (monitor == data.Monitor)
+            return;
+        data.Monitor = monitor;
+        data.RefreshRate = QueryRefreshRate(monitor);
     }
 
     WindowsWindow::WindowsWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config)
+        : m_WindowHandle(nullptr), m_Title(std::move(title)), m_Pending(PendingWindow { bounds, styles, config })
     {
-        m_Data = {};
-        m_WindowClassName = GetUniqueName();
+        AcquireWindowClass();
 
-        WNDCLASS wc = {};
-        wc.hInstance = GetModuleHandle(nullptr);
-        wc.lpfnWndProc = WindowProc;
-        wc.lpszClassName = m_WindowClassName.c_str();
-        RegisterClass(&wc);
+        if (!config.LazyRealize)
+            Realize();
+    }
+
+    void WindowsWindow::Realize()
+    {
+        const auto& [bounds, styles, config] = *m_Pending;
 
         DWORD styleMask = 0;
         if (HasFlag(styles, WindowStyles::WSCaption))
@@ -118,12 +265,13 @@ namespace Pulsarion::Windowing
         //if (HasFlag(styles.Flags, WindowFlags::AlwaysOnTop))
         //    styleMask |= WS_EX_TOPMOST;
 
-        if (config.StartVisible)
+        // A lazily realized window is created by SetVisible, which shows it right after
+        if (config.StartVisible && !config.LazyRealize)
             styleMask |= WS_VISIBLE;
 
-        m_WindowHandle = CreateWindow(
-            m_WindowClassName.c_str(),
-            title.c_str(),
+        m_WindowHandle = CreateWindowW(
+            WindowClassName,
+            ToWide(m_Title).c_str(),
             styleMask,
             bounds.X, bounds.Y, bounds.Width, bounds.Height,
             nullptr,
@@ -134,49 +282,325 @@ namespace Pulsarion::Windowing
 
         if (!m_WindowHandle)
             return; // The creation function will handle this
+        m_Pending.reset();
+
+        // CreateWindowW already sent WM_SIZE, the initial size isn't a resize
+        RECT client;
+        GetClientRect(m_WindowHandle, &client);
+        m_Data.Width = static_cast<std::uint32_t>(client.right - client.left);
+        m_Data.Height = static_cast<std::uint32_t>(client.bottom - client.top);
+        m_Data.ResizePending = false;
+        UpdateMonitor(m_WindowHandle, m_Data);
+
+        if (m_Data.BigIcon != nullptr || m_Data.SmallIcon != nullptr)
+        {
+            SendMessageW(m_WindowHandle, WM_SETICON, ICON_BIG, reinterpret_cast<LPARAM>(m_Data.BigIcon));
+            SendMessageW(m_WindowHandle, WM_SETICON, ICON_SMALL, reinterpret_cast<LPARAM>(m_Data.SmallIcon));
+        }
+
+        // The cursor was captured before the window existed, SetCursorMode already hid it
+        if (m_Data.CurrentCursorMode == CursorMode::Captured)
+        {
+            if (HasFlag(m_Data.EventMask, EventType::RawMouseMove))
+                RegisterRawMouse(m_WindowHandle, true);
+            ClipCursorToClientArea(m_WindowHandle);
+        }
     }
 
     void WindowsWindow::SetVisible(bool visible)
     {
+        if (!m_WindowHandle)
+        {
+            if (!visible)
+                return;
+            Realize();
+            if (!m_WindowHandle)
+                return;
+        }
         ShowWindow(m_WindowHandle, visible ? SW_SHOW : SW_HIDE);
     }
 
     void WindowsWindow::SetTitle(const std::string& title)
     {
-        SetWindowText(m_WindowHandle, title.c_str());
+        if (title == m_Title)
+            return;
+        m_Title = title;
+        if (m_WindowHandle)
+            SetWindowTextW(m_WindowHandle, ToWide(m_Title).c_str());
     }
 
     void WindowsWindow::SetCursorMode(CursorMode mode)
     {
-        if (mode == CursorMode::Normal)
-            ShowCursor(TRUE);
-        else
-            ShowCursor(FALSE);
+        if (mode == m_Data.CurrentCursorMode)
+            return;
+
+        // ShowCursor keeps a display counter, so only call it when the visibility actually changes
+        if ((mode == CursorMode::Normal) != (m_Data.CurrentCursorMode == CursorMode::Normal))
+            ShowCursor(mode == CursorMode::Normal ? TRUE : FALSE);
+
+        if (!m_WindowHandle)
+        {
+            m_Data.CurrentCursorMode = mode; // Applied by Realize
+            return;
+        }
+
+        if (mode == CursorMode::Captured)
+        {
+            // Raw input gives us the unaccelerated device deltas, we never need to warp the cursor back to the center
+            if (HasFlag(m_Data.EventMask, EventType::RawMouseMove))
+                RegisterRawMouse(m_WindowHandle, true);
+            ClipCursorToClientArea(m_WindowHandle);
+        }
+        else if (m_Data.CurrentCursorMode == CursorMode::Captured)
+        {
+            if (HasFlag(m_Data.EventMask, EventType::RawMouseMove))
+                RegisterRawMouse(m_WindowHandle, false);
+            ClipCursor(nullptr);
+            m_Data.RawMotion = { 0.0f, 0.0f };
+            m_Data.RawMotionSamples.clear();
+        }
+
+        m_Data.CurrentCursorMode = mode;
     }
 
-    std::optional<std::string> WindowsWindow::GetTitle() const
+    void WindowsWindow::SetCursorShape(CursorShape shape)
     {
-        int size = GetWindowTextLength(m_WindowHandle);
-        if (size == 0)
-            return std::nullopt;
-        std::unique_ptr<char[]> buffer(new char[size + 1]);
-        if (GetWindowText(m_WindowHandle, buffer.get(), size + 1))
+        const auto index = static_cast<std::size_t>(shape);
+        if (index >= CursorShapeCount)
+            return;
+        if (m_Data.ShapeCursors[index] == nullptr)
+            m_Data.ShapeCursors[index] = LoadCursor(nullptr, GetCursorResource(shape));
+        m_Data.Cursor = m_Data.ShapeCursors[index];
+        // WM_SETCURSOR only comes with the next mouse move, a cursor that is already over us changes right away
+        if (m_WindowHandle && m_Data.CurrentCursorMode == CursorMode::Normal && IsCursorOverClientArea(m_WindowHandle))
+            SetCursor(m_Data.Cursor);
+    }
+
+    void WindowsWindow::SetCursorImage(const ImageView& image, std::uint32_t hotspotX, std::uint32_t hotspotY)
+    {
+        // The hotspot is part of the cursor, so it is part of the key
+        const std::uint64_t hash = HashImage(image, (static_cast<std::uint64_t>(hotspotX) << 32) | hotspotY);
+        HICON cursor = m_Data.Cursors.GetOrCreate(hash, [&]() { return CreateIconFromImage(image, true, hotspotX, hotspotY); });
+        if (cursor == nullptr)
+            return;
+        m_Data.Cursor = cursor;
+        if (m_WindowHandle && m_Data.CurrentCursorMode == CursorMode::Normal && IsCursorOverClientArea(m_WindowHandle))
+            SetCursor(m_Data.Cursor);
+    }
+
+    void WindowsWindow::SetIcon(std::span<const ImageView> images)
+    {
+        const auto getIcon = [&](const ImageView* image) -> HICON
         {
-            PULSARION_ASSERT(buffer[size] == '\0', "The buffer should be null terminated");
-            return std::string(buffer.get());
+            if (image == nullptr)
+                return nullptr;
+            return m_Data.Icons.GetOrCreate(HashImage(*image), [&]() { return CreateIconFromImage(*image, false, 0, 0); });
+        };
+        m_Data.BigIcon = getIcon(PickIconImage(images, static_cast<std::uint32_t>(GetSystemMetrics(SM_CXICON))));
+        m_Data.SmallIcon = getIcon(PickIconImage(images, static_cast<std::uint32_t>(GetSystemMetrics(SM_CXSMICON))));
+        if (!m_WindowHandle)
+            return; // Applied by Realize
+        // nullptr goes back to the class icon
+        SendMessageW(m_WindowHandle, WM_SETICON, ICON_BIG, reinterpret_cast<LPARAM>(m_Data.BigIcon));
+        SendMessageW(m_WindowHandle, WM_SETICON, ICON_SMALL, reinterpret_cast<LPARAM>(m_Data.SmallIcon));
+    }
+
+    void WindowsWindow::SetEventMask(EventTypeFlags mask)
+    {
+        const bool wasRaw = HasFlag(m_Data.EventMask, EventType::RawMouseMove);
+        const bool isRaw = HasFlag(mask, EventType::RawMouseMove);
+        m_Data.EventMask = mask;
+
+        // Without raw mouse events there is no reason to have the device send us WM_INPUT at all
+        if (m_WindowHandle && m_Data.CurrentCursorMode == CursorMode::Captured && wasRaw != isRaw)
+            RegisterRawMouse(m_WindowHandle, isRaw);
+        if (!isRaw)
+        {
+            m_Data.RawMotion = { 0.0f, 0.0f };
+            m_Data.RawMotionSamples.clear();
         }
-        return std::nullopt;
+        if (!HasFlag(mask, EventType::TextInput))
+            m_Data.TextInput.Clear();
+    }
+
+    DisplayTiming WindowsWindow::GetDisplayTiming() const
+    {
+        DisplayTiming timing;
+        timing.RefreshRate = m_Data.RefreshRate;
+        if (timing.RefreshRate <= 0.0)
+            return timing;
+
+        // EnumDisplaySettings rounds (59 for 59.94 Hz), DWM has the exact rate and the vblank phase. DWM only reports the
+        // display it composes for though, so its numbers are only ours when the rates agree.
+        DWM_TIMING_INFO info = {};
+        info.cbSize = sizeof(info);
+        if (FAILED(DwmGetCompositionTimingInfo(nullptr, &info)) || info.rateRefresh.uiDenominator == 0)
+            return timing;
+        const double rate = static_cast<double>(info.rateRefresh.uiNumerator) / static_cast<double>(info.rateRefresh.uiDenominator);
+        if (std::abs(rate - timing.RefreshRate) >= 1.0)
+            return timing;
+        timing.RefreshRate = rate;
+
+        // qpcVBlank is a QueryPerformanceCounter value, read both clocks back to back to convert it without assuming steady_clock's epoch
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER counter;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&counter);
+        const auto now = std::chrono::steady_clock::now();
+        const auto ticksAgo = static_cast<double>(counter.QuadPart) - static_cast<double>(info.qpcVBlank);
+        const auto ago = std::chrono::duration<double>(ticksAgo / static_cast<double>(frequency.QuadPart));
+        timing.LastVblank = now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(ago);
+        return timing;
+    }
+
+    bool WindowsWindow::SetClipboard(std::vector<std::string> formats, ClipboardProvider&& provider)
+    {
+        if (!m_WindowHandle || !OpenClipboard(m_WindowHandle))
+            return false;
+        // Sends us WM_DESTROYCLIPBOARD if we already owned it, which drops the previous offer
+        EmptyClipboard();
+        m_Data.ClipboardNativeFormats.clear();
+        for (const auto& format : formats)
+        {
+            const UINT nativeFormat = GetNativeClipboardFormat(format);
+            m_Data.ClipboardNativeFormats.push_back(nativeFormat);
+            if (nativeFormat != 0)
+                SetClipboardData(nativeFormat, nullptr); // Delayed rendering, we get WM_RENDERFORMAT when someone pastes it
+        }
+        m_Data.ClipboardFormats = std::move(formats);
+        m_Data.ClipboardSource = std::move(provider);
+        CloseClipboard();
+        return true;
+    }
+
+    void WindowsWindow::RequestClipboard(std::string format, ClipboardReceiver&& receiver)
+    {
+        if (receiver)
+            m_Data.ClipboardRequests.emplace_back(std::move(format), std::move(receiver));
+    }
+
+    bool WindowsWindow::HasClipboardFormat(std::string_view format) const
+    {
+        const UINT nativeFormat = GetNativeClipboardFormat(format);
+        return nativeFormat != 0 && IsClipboardFormatAvailable(nativeFormat);
+    }
+
+    void WindowsWindow::RenderClipboardFormat(Data& data, UINT nativeFormat)
+    {
+        const auto it = std::find(data.ClipboardNativeFormats.begin(), data.ClipboardNativeFormats.end(), nativeFormat);
+        if (it == data.ClipboardNativeFormats.end())
+            return;
+        const auto& format = data.ClipboardFormats[static_cast<std::size_t>(it - data.ClipboardNativeFormats.begin())];
+        // The clipboard is already open, by whoever is pasting
+        if (HGLOBAL handle = RenderClipboardData(nativeFormat, format, data.ClipboardSource, data.UserData))
+        {
+            if (!SetClipboardData(nativeFormat, handle))
+                GlobalFree(handle);
+        }
+    }
+
+    void WindowsWindow::ServeClipboardRequests()
+    {
+        // Another application can have the clipboard open for a moment, the requests then wait for the next poll
+        if (!m_WindowHandle || !OpenClipboard(m_WindowHandle))
+            return;
+        // Moved out since a receiver may request again
+        auto requests = std::move(m_Data.ClipboardRequests);
+        m_Data.ClipboardRequests.clear();
+        for (const auto& [format, receiver] : requests)
+            ReadClipboardData(GetNativeClipboardFormat(format), receiver, m_Data.UserData);
+        CloseClipboard();
+    }
+
+    std::optional<std::string> WindowsWindow::GetTitle() const
+    {
+        if (m_Title.empty())
+            return std::nullopt;
+        return m_Title;
     }
 
     void WindowsWindow::PollEvents()
     {
+        if (m_Data.LoopWatchdog)
+            m_Data.LoopWatchdog->BeginFrame();
+        #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
         m_Data.LimitedEvents.clear();
+        #endif
         MSG msg = {};
-        while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+        while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
         {
             TranslateMessage(&msg);
-            DispatchMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+
+        if (m_Data.ResizePending)
+        {
+            m_Data.ResizePending = false;
+            if (m_Data.PendingWidth != m_Data.Width || m_Data.PendingHeight != m_Data.Height)
+            {
+                m_Data.Width = m_Data.PendingWidth;
+                m_Data.Height = m_Data.PendingHeight;
+                m_Data.SizeGeneration++;
+                if (m_Data.OnResize && HasFlag(m_Data.EventMask, EventType::Resize))
+                    m_Data.OnResize(m_Data.UserData, m_Data.Width, m_Data.Height);
+            }
         }
+
+        if (m_Data.ResizeEnded)
+        {
+            m_Data.ResizeEnded = false;
+            if (m_Data.AfterResize && HasFlag(m_Data.EventMask, EventType::AfterResize))
+                m_Data.AfterResize(m_Data.UserData, m_Data.Width, m_Data.Height);
+        }
+
+        if (!m_Data.TextInput.Empty())
+        {
+            if (m_Data.OnTextInput)
+                m_Data.OnTextInput(m_Data.UserData, m_Data.TextInput.View());
+            m_Data.TextInput.Clear();
+        }
+
+        if (!m_Data.RawMotionSamples.empty())
+        {
+            if (m_Data.OnRawMouseMove)
+                m_Data.OnRawMouseMove(m_Data.UserData, m_Data.RawMotion, m_Data.RawMotionSamples);
+            m_Data.RawMotion = { 0.0f, 0.0f };
+            m_Data.RawMotionSamples.clear();
+        }
+
+        if (m_Data.Touches.HasChanges())
+        {
+            if (m_Data.OnTouch && HasFlag(m_Data.EventMask, EventType::Touch))
+                m_Data.OnTouch(m_Data.UserData, m_Data.Touches.View());
+            m_Data.Touches.Flush();
+        }
+
+        if (!m_Data.ClipboardRequests.empty())
+            ServeClipboardRequests();
+
+        m_Data.Timers.Dispatch(m_Data.UserData);
+
+        // Back in the application's hands until the next PollEvents
+        if (m_Data.LoopWatchdog)
+            m_Data.LoopWatchdog->Beat(LoopPhase::Frame);
+    }
+
+    void WindowsWindow::WaitEvents(std::optional<std::chrono::nanoseconds> timeout)
+    {
+        timeout = m_Data.Timers.ClampTimeout(timeout);
+        DWORD milliseconds = INFINITE;
+        if (timeout.has_value())
+        {
+            // Round up, waking before the deadline would just mean another wait
+            const auto ms = std::chrono::ceil<std::chrono::milliseconds>(*timeout).count();
+            milliseconds = static_cast<DWORD>(std::min<std::int64_t>(ms, INFINITE - 1));
+        }
+
+        if (m_Data.LoopWatchdog)
+            m_Data.LoopWatchdog->Beat(LoopPhase::Waiting);
+        // MWMO_INPUTAVAILABLE also returns for input that is queued but was already seen by an earlier peek
+        MsgWaitForMultipleObjectsEx(0, nullptr, milliseconds, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        PollEvents();
     }
 
     bool WindowsWindow::ShouldClose() const
@@ -192,8 +616,9 @@ namespace Pulsarion::Windowing
     WindowsWindow::~WindowsWindow()
     {
         PostQuitMessage(0);
-        DestroyWindow(m_WindowHandle);
-        UnregisterClass(m_WindowClassName.c_str(), GetModuleHandle(nullptr));
+        if (m_WindowHandle)
+            DestroyWindow(m_WindowHandle);
+        ReleaseWindowClass();
     }
 
     static Point GetMousePosition(LPARAM lParam)
@@ -208,6 +633,8 @@ namespace Pulsarion::Windowing
         #else
         #define LIMIT_EVENT(event)
         #endif
+        // Masked events are dropped before any translation work is done
+        #define MASK_EVENT(type) if (!HasFlag(data->EventMask, type)) break
 
         switch (msg)
         {
@@ -221,6 +648,7 @@ namespace Pulsarion::Windowing
         case WM_SHOWWINDOW:
         {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::WindowVisibility);
             if (data->OnWindowVisibility)
                 data->OnWindowVisibility(data->UserData, wParam);
             break;
@@ -235,44 +663,92 @@ namespace Pulsarion::Windowing
         }
         case WM_SETFOCUS: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            if (data->CurrentCursorMode == CursorMode::Captured)
+                ClipCursorToClientArea(hWnd); // The clip rectangle is reset when another window takes focus
 
+            MASK_EVENT(EventType::Focus);
             if (data->OnFocus)
                 data->OnFocus(data->UserData, true);
             break;
         }
         case WM_KILLFOCUS: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
-
+            if (data->CurrentCursorMode == CursorMode::Captured)
+                ClipCursor(nullptr); // The window taking focus gets the whole screen, WM_SETFOCUS clips again
+            MASK_EVENT(EventType::Focus);
             if (data->OnFocus)
                 data->OnFocus(data->UserData, false);
             break;
         }
         case WM_SIZE: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            const auto type = static_cast<UINT>(wParam);
+            if (type != SIZE_MINIMIZED && type != SIZE_MAXIMIZED && type != SIZE_RESTORED)
+                break; // SIZE_MAXSHOW and SIZE_MAXHIDE are about other windows
 
-            switch (wParam)
+            const UINT lastType = data->LastSizeType;
+            data->LastSizeType = type;
+            if (type == SIZE_MINIMIZED)
             {
-            case SIZE_MINIMIZED:
-                if (data->OnMinimize)
+                // The client area is 0x0 while minimized, which isn't a size anyone wants to recreate a swapchain for
+                if (data->OnMinimize && HasFlag(data->EventMask, EventType::Minimize))
                     data->OnMinimize(data->UserData);
                 break;
-            case SIZE_MAXIMIZED:
-                if (data->OnMaximize)
+            }
+
+            // The clip rectangle is in screen coordinates, so it has to follow the client area
+            if (data->CurrentCursorMode == CursorMode::Captured && GetFocus() == hWnd)
+                ClipCursorToClientArea(hWnd);
+
+            if (type == SIZE_MAXIMIZED && lastType != SIZE_MAXIMIZED)
+            {
+                if (data->OnMaximize && HasFlag(data->EventMask, EventType::Maximize))
                     data->OnMaximize(data->UserData);
-                break;
-            case SIZE_RESTORED:
-                if (data->OnRestore)
+            }
+            // Every plain resize is SIZE_RESTORED too, it only is a restore when coming back from minimized or maximized
+            else if (type == SIZE_RESTORED && lastType != SIZE_RESTORED)
+            {
+                if (data->OnRestore && HasFlag(data->EventMask, EventType::Restore))
                     data->OnRestore(data->UserData);
+            }
+
+            data->PendingWidth = LOWORD(lParam);
+            data->PendingHeight = HIWORD(lParam);
+            data->ResizePending = true;
+            break;
+        }
+        case WM_DISPLAYCHANGE: {
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            data->Monitor = nullptr; // The mode might have changed, query it again
+            UpdateMonitor(hWnd, *data);
+            break;
+        }
+        case WM_SIZING: {
+            // Unlike WM_ENTERSIZEMOVE this is only sent when the user drags a border, not when the window is moved
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            if (data->LiveResizing)
                 break;
-            default:
-                LIMIT_EVENT(WM_SIZE);
-                if (data->OnResize)
-                    data->OnResize(data->UserData, LOWORD(lParam), HIWORD(lParam));
-                break;
+            data->LiveResizing = true;
+            MASK_EVENT(EventType::BeforeResize);
+            if (data->BeforeResize)
+                data->BeforeResize(data->UserData);
+            break;
+        }
+        case WM_EXITSIZEMOVE: {
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            if (data->LiveResizing)
+            {
+                data->LiveResizing = false;
+                data->ResizeEnded = true;
             }
+            break;
         }
         case WM_MOVE: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            UpdateMonitor(hWnd, *data); // Cheap unless the window moved to another monitor
+            if (data->CurrentCursorMode == CursorMode::Captured && GetFocus() == hWnd && !IsIconic(hWnd))
+                ClipCursorToClientArea(hWnd);
+            MASK_EVENT(EventType::Move);
             LIMIT_EVENT(WM_MOVE);
             if (data->OnMove)
                 data->OnMove(data->UserData, LOWORD(lParam), HIWORD(lParam));
@@ -280,6 +756,7 @@ namespace Pulsarion::Windowing
         }
         case WM_LBUTTONDOWN: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseDown);
             LIMIT_EVENT(WM_LBUTTONDOWN);
             if (data->OnMouseDown)
                 data->OnMouseDown(data->UserData, GetMousePosition(lParam), MouseCode::Button0);
@@ -287,6 +764,7 @@ namespace Pulsarion::Windowing
         }
         case WM_LBUTTONUP: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseUp);
             LIMIT_EVENT(WM_LBUTTONUP);
             if (data->OnMouseUp)
                 data->OnMouseUp(data->UserData, GetMousePosition(lParam), MouseCode::Button0);
@@ -294,6 +772,7 @@ namespace Pulsarion::Windowing
         }
         case WM_RBUTTONDOWN: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseDown);
             LIMIT_EVENT(WM_RBUTTONDOWN);
             if (data->OnMouseDown)
                 data->OnMouseDown(data->UserData, GetMousePosition(lParam), MouseCode::Button1);
@@ -301,6 +780,7 @@ namespace Pulsarion::Windowing
         }
         case WM_RBUTTONUP: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseUp);
             LIMIT_EVENT(WM_RBUTTONUP);
             if (data->OnMouseUp)
                 data->OnMouseUp(data->UserData, GetMousePosition(lParam), MouseCode::Button1);
@@ -308,6 +788,7 @@ namespace Pulsarion::Windowing
         }
         case WM_MBUTTONDOWN: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseDown);
             LIMIT_EVENT(WM_MBUTTONDOWN);
             if (data->OnMouseDown)
                 data->OnMouseDown(data->UserData, GetMousePosition(lParam), MouseCode::Button2);
@@ -315,6 +796,7 @@ namespace Pulsarion::Windowing
         }
         case WM_MBUTTONUP: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseUp);
             LIMIT_EVENT(WM_MBUTTONUP);
             if (data->OnMouseUp)
                 data->OnMouseUp(data->UserData, GetMousePosition(lParam), MouseCode::Button2);
@@ -322,6 +804,7 @@ namespace Pulsarion::Windowing
         }
         case WM_XBUTTONDOWN: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseDown);
             LIMIT_EVENT(WM_XBUTTONDOWN);
             if (data->OnMouseDown)
                 data->OnMouseDown(data->UserData, GetMousePosition(lParam), GET_XBUTTON_WPARAM(wParam) == XBUTTON1 ? MouseCode::Button3 : MouseCode::Button4);
@@ -329,6 +812,7 @@ namespace Pulsarion::Windowing
         }
         case WM_XBUTTONUP: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseUp);
             LIMIT_EVENT(WM_XBUTTONUP);
             if (data->OnMouseUp)
                 data->OnMouseUp(data->UserData, GetMousePosition(lParam), GET_XBUTTON_WPARAM(wParam) == XBUTTON1 ? MouseCode::Button3 : MouseCode::Button4);
@@ -336,6 +820,7 @@ namespace Pulsarion::Windowing
         }
         case WM_MOUSEWHEEL: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::MouseWheel);
             LIMIT_EVENT(WM_MOUSEWHEEL);
             if (data->OnMouseWheel)
                 data->OnMouseWheel(data->UserData, GetMousePosition(lParam), ScrollOffset(0.0f, GET_WHEEL_DELTA_WPARAM(wParam)));
@@ -343,25 +828,99 @@ namespace Pulsarion::Windowing
         }
         case WM_MOUSEMOVE: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
-            if (!data->TrackingMouse) {
+            // Without enter or leave listeners there is nothing to track, and no WM_MOUSELEAVE to ask for
+            if (!data->TrackingMouse && HasAnyFlag(data->EventMask, EventType::MouseEnter | EventType::MouseLeave)) {
                 TRACKMOUSEEVENT tme = { sizeof(TRACKMOUSEEVENT) };
                 tme.dwFlags = TME_LEAVE;
                 tme.hwndTrack = hWnd;
                 TrackMouseEvent(&tme);
                 data->TrackingMouse = true;
-                if (data->OnMouseEnter)
+                if (data->OnMouseEnter && HasFlag(data->EventMask, EventType::MouseEnter))
                     data->OnMouseEnter(data->UserData);
             }
 
+            MASK_EVENT(EventType::MouseMove);
             LIMIT_EVENT(WM_MOUSEMOVE);
             if (data->OnMouseMove)
                 data->OnMouseMove(data->UserData, GetMousePosition(lParam));
             break;
         }
+        case WM_INPUT: {
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            if (!HasFlag(data->EventMask, EventType::RawMouseMove))
+                return DefWindowProcW(hWnd, msg, wParam, lParam); // Still needed to free the input, but we don't read it
+            UINT size = 0;
+            GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, nullptr, &size, sizeof(RAWINPUTHEADER));
+            if (data->RawInputBuffer.size() < size)
+                data->RawInputBuffer.resize(size);
+            if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, data->RawInputBuffer.data(), &size, sizeof(RAWINPUTHEADER)) == size)
+            {
+                const auto* raw = reinterpret_cast<const RAWINPUT*>(data->RawInputBuffer.data());
+                if (raw->header.dwType == RIM_TYPEMOUSE && (raw->data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE) == 0 && data->CurrentCursorMode == CursorMode::Captured)
+                {
+                    const Point delta = { static_cast<float>(raw->data.mouse.lLastX), static_cast<float>(raw->data.mouse.lLastY) };
+                    data->RawMotion.x += delta.x;
+                    data->RawMotion.y += delta.y;
+                    data->RawMotionSamples.push_back(delta);
+                }
+            }
+            return DefWindowProcW(hWnd, msg, wParam, lParam); // Required so the system can clean up the raw input buffer
+        }
+        case WM_POINTERDOWN:
+        case WM_POINTERUPDATE:
+        case WM_POINTERUP: {
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            // Without a touch callback DefWindowProc turns touches and pens into the usual mouse messages
+            if (!data->OnTouch || !HasFlag(data->EventMask, EventType::Touch))
+                return DefWindowProcW(hWnd, msg, wParam, lParam);
+            if (!RecordPointer(hWnd, data->Touches, msg, wParam))
+                return DefWindowProcW(hWnd, msg, wParam, lParam);
+            break;
+        }
+        case WM_POINTERCAPTURECHANGED: {
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            data->Touches.Cancel(GET_POINTERID_WPARAM(wParam));
+            break;
+        }
+        case WM_RENDERFORMAT: {
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            RenderClipboardFormat(*data, static_cast<UINT>(wParam));
+            break;
+        }
+        case WM_RENDERALLFORMATS: {
+            // The window is going away, everything we only promised has to be on the clipboard now
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            if (!OpenClipboard(hWnd))
+                break;
+            if (GetClipboardOwner() == hWnd)
+            {
+                for (const UINT nativeFormat : data->ClipboardNativeFormats)
+                    RenderClipboardFormat(*data, nativeFormat);
+            }
+            CloseClipboard();
+            break;
+        }
+        case WM_DESTROYCLIPBOARD: {
+            // Someone else owns the clipboard now
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            data->ClipboardFormats.clear();
+            data->ClipboardNativeFormats.clear();
+            data->ClipboardSource = nullptr;
+            break;
+        }
+        case WM_SETCURSOR: {
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            // Outside the client area DefWindowProc picks the resize arrows
+            if (LOWORD(lParam) != HTCLIENT)
+                return DefWindowProcW(hWnd, msg, wParam, lParam);
+            if (data->CurrentCursorMode == CursorMode::Normal)
+                SetCursor(data->Cursor != nullptr ? data->Cursor : LoadCursor(nullptr, IDC_ARROW));
+            return TRUE;
+        }
         case WM_MOUSELEAVE: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
             data->TrackingMouse = false;
-            if (data->OnMouseLeave)
+            if (data->OnMouseLeave && HasFlag(data->EventMask, EventType::MouseLeave))
                 data->OnMouseLeave(data->UserData);
             break;
         }
@@ -371,10 +930,12 @@ namespace Pulsarion::Windowing
         case WM_SYSCOMMAND: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
             // TODO: In the future we have a BeforeMinimize event and BeforeMaximize event
-            return DefWindowProc(hWnd, msg, wParam, lParam);
+            return DefWindowProcW(hWnd, msg, wParam, lParam);
         }
         case WM_KEYDOWN: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            if (!HasAnyFlag(data->EventMask, EventType::KeyDown | EventType::KeyTyped))
+                break;
             LIMIT_EVENT(WM_KEYDOWN);
             Modifier modifier = 0;
             if (GetKeyState(VK_SHIFT) & 0x8000)
@@ -386,9 +947,9 @@ namespace Pulsarion::Windowing
             if (GetKeyState(VK_LWIN) & 0x8000 || GetKeyState(VK_RWIN) & 0x8000)
                 modifier |= 0x08;
             bool repeat = lParam & (1 << 30);
-            if (data->OnKeyDown)
-                data->OnKeyDown(data->UserData, ConvertFromVirtualKey(wParam), modifier, repeat);
-            if (data->OnKeyTyped)
+            if (data->OnKeyDown && HasFlag(data->EventMask, EventType::KeyDown))
+                data->OnKeyDown(data->UserData, KeyTable::FromVirtualKey(static_cast<std::uint32_t>(wParam)), modifier, repeat);
+            if (data->OnKeyTyped && HasFlag(data->EventMask, EventType::KeyTyped))
             {
                 auto c = MapVirtualKeyA(wParam, MAPVK_VK_TO_CHAR);
                 // Convert to char
@@ -397,8 +958,26 @@ namespace Pulsarion::Windowing
             }
             break;
         }
+        case WM_CHAR: {
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            // IME results also arrive here, DefWindowProcW turns WM_IME_CHAR into WM_CHAR for unicode windows
+            MASK_EVENT(EventType::TextInput);
+            if (data->OnTextInput)
+                data->TextInput.AppendUtf16(static_cast<char16_t>(wParam));
+            break;
+        }
+        case WM_UNICHAR: {
+            if (wParam == UNICODE_NOCHAR)
+                return TRUE; // Tell the sender we accept UTF-32
+            auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::TextInput);
+            if (data->OnTextInput)
+                data->TextInput.AppendCodepoint(static_cast<char32_t>(wParam));
+            break;
+        }
         case WM_KEYUP: {
             auto* data = (WindowsWindow::Data*)GetWindowLongPtr(hWnd, GWLP_USERDATA);
+            MASK_EVENT(EventType::KeyUp);
             LIMIT_EVENT(WM_KEYDOWN);
             Modifier modifier = 0;
             if (GetKeyState(VK_SHIFT) & 0x8000)
@@ -410,11 +989,11 @@ namespace Pulsarion::Windowing
             if (GetKeyState(VK_LWIN) & 0x8000 || GetKeyState(VK_RWIN) & 0x8000)
                 modifier |= 0x08;
             if (data->OnKeyUp)
-                data->OnKeyUp(data->UserData, ConvertFromVirtualKey(wParam), modifier);
+                data->OnKeyUp(data->UserData, KeyTable::FromVirtualKey(static_cast<std::uint32_t>(wParam)), modifier);
             break;
         }
         default:
-            return DefWindowProc(hWnd, msg, wParam, lParam);
+            return DefWindowProcW(hWnd, msg, wParam, lParam);
         }
 
         return 0;
@@ -422,7 +1001,7 @@ namespace Pulsarion::Windowing
 
     std::shared_ptr<Window> CreateSharedWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config, std::optional<WindowEvents> events) {
         auto res = std::make_shared<WindowsWindow>(std::move(title), bounds, styles, config);
-        if (!res->m_WindowHandle)
+        if (!res->m_WindowHandle && !config.LazyRealize)
             return nullptr;
         if (events.has_value())
             SetWindowEvents(*res, *events);
@@ -436,4 +1015,27 @@ namespace Pulsarion::Windowing
             SetWindowEvents(*res, *events);
         return res;
     }
+
+    std::vector<std::unique_ptr<Window>> CreateWindows(std::span<WindowDesc> descs)
+    {
+        std::vector<std::unique_ptr<Window>> windows;
+        windows.reserve(descs.size());
+
+        // Hold the class for the whole batch so it is registered exactly once, even if windows fail or get destroyed in between
+        WindowsWindow::AcquireWindowClass();
+        for (auto& desc : descs)
+        {
+            auto window = std::make_unique<WindowsWindow>(std::move(desc.Title), desc.Bounds, desc.Styles, desc.Config);
+            if (!window->m_WindowHandle && !desc.Config.LazyRealize)
+            {
+                windows.push_back(nullptr);
+                continue;
+            }
+            if (desc.Events.has_value())
+                SetWindowEvents(*window, *desc.Events);
+            windows.push_back(std::move(window));
+        }
+        WindowsWindow::ReleaseWindowClass();
+        return windows;
+    }
 }
@@ -1,70 +1,100 @@
 #pragma once
 
 #include "../Window.hpp"
+#include "../TextInput.hpp"
 
 #include <Windows.h>
+#include <array>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Pulsarion::Windowing
 {
-    class PULSARION_WINDOWING_API WindowsWindow : public Window
+    class PULSARION_WINDOWING_API WindowsWindow final : public Window
     {
     public:
         friend std::shared_ptr<Window> CreateSharedWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config, std::optional<WindowEvents> events);
         friend std::unique_ptr<Window> CreateUniqueWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config, std::optional<WindowEvents> events);
+        friend std::vector<std::unique_ptr<Window>> CreateWindows(std::span<WindowDesc> descs);
         explicit WindowsWindow(std::string title, const WindowBounds& bounds, const WindowStyles& styles, const WindowConfig& config);
         ~WindowsWindow() override;
 
-        inline void SetVisible(bool visible) override;
+        void SetVisible(bool visible) override;
         void SetTitle(const std::string& title) override;
         [[nodiscard]] std::optional<std::string> GetTitle() const override;
-        inline void PollEvents() override;
-        [[nodiscard]] inline bool ShouldClose() const override;
-        inline void SetCursorMode(CursorMode mode) override;
-        inline void SetShouldClose(bool shouldClose) override;
+        [[nodiscard]] std::string_view GetTitleView() const override { return m_Title; }
+        void PollEvents() override;
+        void WaitEvents(std::optional<std::chrono::nanoseconds> timeout) override;
+        TimerId AddTimer(std::chrono::nanoseconds period, TimerCallback&& callback, bool repeat) override { return m_Data.Timers.Add(period, std::move(callback), repeat); }
+        void RemoveTimer(TimerId id) override { m_Data.Timers.Remove(id); }
+        [[nodiscard]] bool ShouldClose() const override;
+        void SetCursorMode(CursorMode mode) override;
+        void SetCursorShape(CursorShape shape) override;
+        void SetCursorImage(const ImageView& image, std::uint32_t hotspotX, std::uint32_t hotspotY) override;
+        void SetIcon(std::span<const ImageView> images) override;
+        void SetEventMask(EventTypeFlags mask) override;
+        [[nodiscard]] EventTypeFlags GetEventMask() const override { return m_Data.EventMask; }
+        [[nodiscard]] std::uint64_t GetSizeGeneration() const override { return m_Data.SizeGeneration; }
+        [[nodiscard]] WindowSize GetContentSize() const override { return { m_Data.Width, m_Data.Height }; }
+        [[nodiscard]] DisplayTiming GetDisplayTiming() const override;
+        void SetWatchdog(Watchdog* watchdog) override { m_Data.LoopWatchdog = watchdog; }
+        bool SetClipboard(std::vector<std::string> formats, ClipboardProvider&& provider) override;
+        void RequestClipboard(std::string format, ClipboardReceiver&& receiver) override;
+        [[nodiscard]] bool HasClipboardFormat(std::string_view format) const override;
+        void SetShouldClose(bool shouldClose) override;
         [[nodiscard]] void* GetNativeWindow() const override { return m_WindowHandle; }
 
         // --- Event Callbacks ---
         void SetOnClose(CloseCallback&& onClose) override { m_Data.OnClose = std::move(onClose); }
-        [[nodiscard]] CloseCallback GetOnClose() const override { return m_Data.OnClose; }
+        [[nodiscard]] const CloseCallback& GetOnClose() const override { return m_Data.OnClose; }
         void SetOnWindowVisibility(VisibilityCallback&& onWindowVisibility) override { m_Data.OnWindowVisibility = std::move(onWindowVisibility); }
-        [[nodiscard]] VisibilityCallback GetOnWindowVisibility() const override { return m_Data.OnWindowVisibility; }
+        [[nodiscard]] const VisibilityCallback& GetOnWindowVisibility() const override { return m_Data.OnWindowVisibility; }
         void SetOnFocus(FocusCallback&& onFocus) override { m_Data.OnFocus = std::move(onFocus); }
-        [[nodiscard]] FocusCallback GetOnFocus() const override { return m_Data.OnFocus; }
+        [[nodiscard]] const FocusCallback& GetOnFocus() const override { return m_Data.OnFocus; }
         void SetOnResize(ResizeCallback&& onResize) override { m_Data.OnResize = std::move(onResize); }
-        [[nodiscard]] ResizeCallback GetOnResize() const override { return m_Data.OnResize; }
+        [[nodiscard]] const ResizeCallback& GetOnResize() const override { return m_Data.OnResize; }
         void SetOnMove(MoveCallback&& onMove) override { m_Data.OnMove = std::move(onMove); }
-        [[nodiscard]] MoveCallback GetOnMove() const override { return m_Data.OnMove; }
+        [[nodiscard]] const MoveCallback& GetOnMove() const override { return m_Data.OnMove; }
         void SetBeforeResize(BeforeResizeCallback&& beforeResize) override { m_Data.BeforeResize = std::move(beforeResize); }
-        [[nodiscard]] BeforeResizeCallback GetBeforeResize() const override { return m_Data.BeforeResize; }
+        [[nodiscard]] const BeforeResizeCallback& GetBeforeResize() const override { return m_Data.BeforeResize; }
+        void SetAfterResize(AfterResizeCallback&& afterResize) override { m_Data.AfterResize = std::move(afterResize); }
+        [[nodiscard]] const AfterResizeCallback& GetAfterResize() const override { return m_Data.AfterResize; }
         void SetOnMinimize(MinimizeCallback&& onMinimize) override { m_Data.OnMinimize = std::move(onMinimize); }
-        [[nodiscard]] MinimizeCallback GetOnMinimize() const override { return m_Data.OnMinimize; }
+        [[nodiscard]] const MinimizeCallback& GetOnMinimize() const override { return m_Data.OnMinimize; }
         void SetOnMaximize(MaximizeCallback&& onMaximize) override { m_Data.OnMaximize = std::move(onMaximize); }
-        [[nodiscard]] MaximizeCallback GetOnMaximize() const override { return m_Data.OnMaximize; }
+        [[nodiscard]] const MaximizeCallback& GetOnMaximize() const override { return m_Data.OnMaximize; }
         // We need to handle this ourselves when we click 'F11' or Call Fullscreen function (in the future)
         void SetOnFullscreen(FullscreenCallback&& onFullscreen) override { m_Data.OnFullscreen = std::move(onFullscreen); }
-        [[nodiscard]] FullscreenCallback GetOnFullscreen() const override { return m_Data.OnFullscreen; }
+        [[nodiscard]] const FullscreenCallback& GetOnFullscreen() const override { return m_Data.OnFullscreen; }
         void SetOnRestore(RestoreCallback&& onRestore) override { m_Data.OnRestore = std::move(onRestore); }
-        [[nodiscard]] RestoreCallback GetOnRestore() const override { return m_Data.OnRestore; }
+        [[nodiscard]] const RestoreCallback& GetOnRestore() const override { return m_Data.OnRestore; }
+        void SetOnOcclusion(OcclusionCallback&& onOcclusion) override { m_Data.OnOcclusion = std::move(onOcclusion); }
+        [[nodiscard]] const OcclusionCallback& GetOnOcclusion() const override { return m_Data.OnOcclusion; }
         void SetOnMouseEnter(MouseEnterCallback&& onMouseEnter) override { m_Data.OnMouseEnter = std::move(onMouseEnter); }
-        [[nodiscard]] MouseEnterCallback GetOnMouseEnter() const override { return m_Data.OnMouseEnter; }
+        [[nodiscard]] const MouseEnterCallback& GetOnMouseEnter() const override { return m_Data.OnMouseEnter; }
         void SetOnMouseLeave(MouseLeaveCallback&& onMouseLeave) override { m_Data.OnMouseLeave = std::move(onMouseLeave); }
-        [[nodiscard]] MouseLeaveCallback GetOnMouseLeave() const override { return m_Data.OnMouseLeave; }
+        [[nodiscard]] const MouseLeaveCallback& GetOnMouseLeave() const override { return m_Data.OnMouseLeave; }
         void SetOnMouseDown(MouseDownCallback&& onMouseDown) override { m_Data.OnMouseDown = std::move(onMouseDown); }
-        [[nodiscard]] MouseDownCallback GetOnMouseDown() const override { return m_Data.OnMouseDown; }
+        [[nodiscard]] const MouseDownCallback& GetOnMouseDown() const override { return m_Data.OnMouseDown; }
         void SetOnMouseUp(MouseUpCallback&& onMouseUp) override { m_Data.OnMouseUp = std::move(onMouseUp); }
-        [[nodiscard]] MouseUpCallback GetOnMouseUp() const override { return m_Data.OnMouseUp; }
+        [[nodiscard]] const MouseUpCallback& GetOnMouseUp() const override { return m_Data.OnMouseUp; }
         void SetOnMouseMove(MouseMoveCallback&& onMouseMove) override { m_Data.OnMouseMove = std::move(onMouseMove); }
-        [[nodiscard]] MouseMoveCallback GetOnMouseMove() const override { return m_Data.OnMouseMove; }
+        [[nodiscard]] const MouseMoveCallback& GetOnMouseMove() const override { return m_Data.OnMouseMove; }
         void SetOnMouseWheel(MouseWheelCallback&& onMouseWheel) override { m_Data.OnMouseWheel = std::move(onMouseWheel); }
-        [[nodiscard]] MouseWheelCallback GetOnMouseWheel() const override { return m_Data.OnMouseWheel; }
+        [[nodiscard]] const MouseWheelCallback& GetOnMouseWheel() const override { return m_Data.OnMouseWheel; }
+        void SetOnRawMouseMove(RawMouseMoveCallback&& onRawMouseMove) override { m_Data.OnRawMouseMove = std::move(onRawMouseMove); }
+        [[nodiscard]] const RawMouseMoveCallback& GetOnRawMouseMove() const override { return m_Data.OnRawMouseMove; }
+        void SetOnTouch(TouchCallback&& onTouch) override { m_Data.OnTouch = std::move(onTouch); }
+        [[nodiscard]] const TouchCallback& GetOnTouch() const override { return m_Data.OnTouch; }
         void SetOnKeyDown(KeyDownCallback&& onKeyDown) override { m_Data.OnKeyDown = std::move(onKeyDown); }
-        [[nodiscard]] KeyDownCallback GetOnKeyDown() const override { return m_Data.OnKeyDown; }
+        [[nodiscard]] const KeyDownCallback& GetOnKeyDown() const override { return m_Data.OnKeyDown; }
         void SetOnKeyUp(KeyUpCallback&& onKeyUp) override { m_Data.OnKeyUp = std::move(onKeyUp); }
-        [[nodiscard]] KeyUpCallback GetOnKeyUp() const override { return m_Data.OnKeyUp; }
+        [[nodiscard]] const KeyUpCallback& GetOnKeyUp() const override { return m_Data.OnKeyUp; }
         void SetOnKeyTyped(KeyTypedCallback&& onKeyTyped) override { m_Data.OnKeyTyped = std::move(onKeyTyped); }
-        [[nodiscard]] KeyTypedCallback GetOnKeyTyped() const override { return m_Data.OnKeyTyped; }
+        [[nodiscard]] const KeyTypedCallback& GetOnKeyTyped() const override { return m_Data.OnKeyTyped; }
+        void SetOnTextInput(TextInputCallback&& onTextInput) override { m_Data.OnTextInput = std::move(onTextInput); }
+        [[nodiscard]] const TextInputCallback& GetOnTextInput() const override { return m_Data.OnTextInput; }
 
         void SetUserData(void* userData) override { m_Data.UserData = userData; }
         [[nodiscard]] void* GetUserData() const override { return m_Data.UserData; }
@@ -75,6 +105,22 @@ namespace Pulsarion::Windowing
         #endif
     private:
         static LRESULT CALLBACK WindowProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
+        static void AcquireWindowClass();
+        static void ReleaseWindowClass();
+        void Realize();
+
+        // Everything needed to create the native window, kept until it is realized
+        struct PendingWindow
+        {
+            WindowBounds Bounds;
+            WindowStyles Styles;
+            WindowConfig Config;
+        };
+
+        struct IconDeleter
+        {
+            void operator()(HICON icon) const { DestroyIcon(icon); }
+        };
 
         struct Data : WindowEvents
         {
@@ -82,6 +128,38 @@ namespace Pulsarion::Windowing
             bool ShouldClose = false;
             bool TrackingMouse = false;
             void* UserData = nullptr;
+            TextInputBuffer TextInput; // Flushed to OnTextInput at the end of PollEvents
+            CursorMode CurrentCursorMode = CursorMode::Normal;
+            HCURSOR Cursor = nullptr; // Set by WM_SETCURSOR over the client area, nullptr is the arrow
+            std::array<HCURSOR, CursorShapeCount> ShapeCursors = {}; // Loaded on first use, shared system cursors that are never destroyed
+            NativeImageCache<HICON, IconDeleter> Cursors; // Made from images, keyed by content and hotspot. Cursors are icons with a hotspot.
+            NativeImageCache<HICON, IconDeleter> Icons;
+            HICON BigIcon = nullptr; // Applied by Realize when set before the window exists
+            HICON SmallIcon = nullptr;
+            EventTypeFlags EventMask = EventTypeFlags::All; // Checked by WindowProc before translating anything
+            // WM_SIZE only records the size, PollEvents reports the last one so a live resize doesn't flood OnResize
+            std::uint32_t Width = 0;
+            std::uint32_t Height = 0;
+            std::uint32_t PendingWidth = 0;
+            std::uint32_t PendingHeight = 0;
+            bool ResizePending = false;
+            bool LiveResizing = false; // Between the first WM_SIZING and WM_EXITSIZEMOVE
+            bool ResizeEnded = false; // Set by WM_EXITSIZEMOVE, AfterResize is called once the final size was reported
+            std::uint64_t SizeGeneration = 0;
+            UINT LastSizeType = SIZE_RESTORED;
+            HMONITOR Monitor = nullptr; // The monitor RefreshRate was queried for, checked on every WM_MOVE
+            double RefreshRate = 0.0;
+            Point RawMotion = { 0.0f, 0.0f };
+            std::vector<Point> RawMotionSamples = {}; // Flushed to OnRawMouseMove at the end of PollEvents
+            std::vector<BYTE> RawInputBuffer = {};
+            // Offered with delayed rendering, WM_RENDERFORMAT asks the provider for the data
+            std::vector<std::string> ClipboardFormats = {};
+            std::vector<UINT> ClipboardNativeFormats = {}; // Parallel to ClipboardFormats
+            ClipboardProvider ClipboardSource = nullptr;
+            std::vector<std::pair<std::string, ClipboardReceiver>> ClipboardRequests = {}; // Served at the end of PollEvents
+            TouchContactBuffer Touches; // WM_POINTER touch and pen contacts, flushed to OnTouch at the end of PollEvents
+            TimerQueue Timers; // Dispatched at the end of PollEvents
+            Watchdog* LoopWatchdog = nullptr;
             #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
             bool LimitEvents = false;
             std::vector<UINT> LimitedEvents = {}; // We use this as a set
@@ -90,8 +168,16 @@ namespace Pulsarion::Windowing
             Data() = default;
         };
 
-        std::string m_WindowClassName;
+        static void UpdateMonitor(HWND hWnd, Data& data);
+        static void RenderClipboardFormat(Data& data, UINT nativeFormat);
+        void ServeClipboardRequests();
+
         HWND m_WindowHandle;
+        std::string m_Title; // Only we set the title, so GetTitle never has to ask the window
+        std::optional<PendingWindow> m_Pending;
         Data m_Data;
+
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+        static std::uint32_t s_WindowCount; // The shared window class is unregistered when the last window is destroyed
     };
 }
@@ -0,0 +1,230 @@
+// Checks that events reach the user's listeners without allocating once the containers along the way have grown: an EventStorm
+// drives a headless backend, whose callbacks go through Layered's forwarding and layers into an EventBus attached on top.
+// Built with PULSARION_WINDOWING_BUILD_TESTS. With a shared library on Windows the DLL has its own operator new, there only the
+// allocations of the header code (the bus, the layers and std::function) are counted.
+
+#include "PulsarionWindowing/EventBus.hpp"
+#include "PulsarionWindowing/EventStorm.hpp"
+#include "PulsarionWindowing/Layered.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static std::size_t s_Allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    s_Allocations++;
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace Pulsarion::Windowing
+{
+    // A window without a platform behind it, Inject calls its callbacks like a backend polling native events would
+    class NullWindow final : public Window
+    {
+    public:
+        NullWindow(std::string title, const WindowBounds& bounds, const WindowStyles&, const WindowConfig&)
+            : m_Title(std::move(title)), m_Size { static_cast<std::uint32_t>(bounds.Width), static_cast<std::uint32_t>(bounds.Height) }
+        {
+        }
+
+        template<EventType Type, typename... Args>
+        void Inject(Args... args)
+        {
+            if (const auto& callback = GetWindowCallback<Type>(*this))
+                callback(m_UserData, args...);
+        }
+
+        void SetVisible(bool) override { }
+        void PollEvents() override { }
+        void WaitEvents(std::optional<std::chrono::nanoseconds>) override { }
+        TimerId AddTimer(std::chrono::nanoseconds, TimerCallback&&, bool = true) override { return 0; }
+        void RemoveTimer(TimerId) override { }
+        [[nodiscard]] bool ShouldClose() const override { return m_ShouldClose; }
+        void SetShouldClose(bool shouldClose) override { m_ShouldClose = shouldClose; }
+        void SetTitle(const std::string& title) override { m_Title = title; }
+        void SetCursorMode(CursorMode) override { }
+        void SetCursorShape(CursorShape) override { }
+        void SetCursorImage(const ImageView&, std::uint32_t, std::uint32_t) override { }
+        void SetIcon(std::span<const ImageView>) override { }
+        void SetEventMask(EventTypeFlags mask) override { m_EventMask = mask; }
+        [[nodiscard]] EventTypeFlags GetEventMask() const override { return m_EventMask; }
+        [[nodiscard]] std::uint64_t GetSizeGeneration() const override { return 0; }
+        [[nodiscard]] WindowSize GetContentSize() const override { return m_Size; }
+        [[nodiscard]] DisplayTiming GetDisplayTiming() const override { return {}; }
+        void SetWatchdog(Watchdog*) override { }
+        bool SetClipboard(std::vector<std::string>, ClipboardProvider&&) override { return false; }
+        void RequestClipboard(std::string, ClipboardReceiver&&) override { }
+        [[nodiscard]] bool HasClipboardFormat(std::string_view) const override { return false; }
+        [[nodiscard]] std::optional<std::string> GetTitle() const override { return m_Title; }
+        [[nodiscard]] std::string_view GetTitleView() const override { return m_Title; }
+        [[nodiscard]] void* GetNativeWindow() const override { return nullptr; }
+        void SetUserData(void* userData) override { m_UserData = userData; }
+        [[nodiscard]] void* GetUserData() const override { return m_UserData; }
+
+        void SetOnClose(CloseCallback&& onClose) override { m_Events.OnClose = std::move(onClose); }
+        [[nodiscard]] const CloseCallback& GetOnClose() const override { return m_Events.OnClose; }
+        void SetOnWindowVisibility(VisibilityCallback&& onWindowVisibility) override { m_Events.OnWindowVisibility = std::move(onWindowVisibility); }
+        [[nodiscard]] const VisibilityCallback& GetOnWindowVisibility() const override { return m_Events.OnWindowVisibility; }
+        void SetOnFocus(FocusCallback&& onFocus) override { m_Events.OnFocus = std::move(onFocus); }
+        [[nodiscard]] const FocusCallback& GetOnFocus() const override { return m_Events.OnFocus; }
+        void SetOnResize(ResizeCallback&& onResize) override { m_Events.OnResize = std::move(onResize); }
+        [[nodiscard]] const ResizeCallback& GetOnResize() const override { return m_Events.OnResize; }
+        void SetOnMove(MoveCallback&& onMove) override { m_Events.OnMove = std::move(onMove); }
+        [[nodiscard]] const MoveCallback& GetOnMove() const override { return m_Events.OnMove; }
+        void SetBeforeResize(BeforeResizeCallback&& beforeResize) override { m_Events.BeforeResize = std::move(beforeResize); }
+        [[nodiscard]] const BeforeResizeCallback& GetBeforeResize() const override { return m_Events.BeforeResize; }
+        void SetAfterResize(AfterResizeCallback&& afterResize) override { m_Events.AfterResize = std::move(afterResize); }
+        [[nodiscard]] const AfterResizeCallback& GetAfterResize() const override { return m_Events.AfterResize; }
+        void SetOnMinimize(MinimizeCallback&& onMinimize) override { m_Events.OnMinimize = std::move(onMinimize); }
+        [[nodiscard]] const MinimizeCallback& GetOnMinimize() const override { return m_Events.OnMinimize; }
+        void SetOnMaximize(MaximizeCallback&& onMaximize) override { m_Events.OnMaximize = std::move(onMaximize); }
+        [[nodiscard]] const MaximizeCallback& GetOnMaximize() const override { return m_Events.OnMaximize; }
+        void SetOnFullscreen(FullscreenCallback&& onFullscreen) override { m_Events.OnFullscreen = std::move(onFullscreen); }
+        [[nodiscard]] const FullscreenCallback& GetOnFullscreen() const override { return m_Events.OnFullscreen; }
+        void SetOnRestore(RestoreCallback&& onRestore) override { m_Events.OnRestore = std::move(onRestore); }
+        [[nodiscard]] const RestoreCallback& GetOnRestore() const override { return m_Events.OnRestore; }
+        void SetOnOcclusion(OcclusionCallback&& onOcclusion) override { m_Events.OnOcclusion = std::move(onOcclusion); }
+        [[nodiscard]] const OcclusionCallback& GetOnOcclusion() const override { return m_Events.OnOcclusion; }
+        void SetOnMouseEnter(MouseEnterCallback&& onMouseEnter) override { m_Events.OnMouseEnter = std::move(onMouseEnter); }
+        [[nodiscard]] const MouseEnterCallback& GetOnMouseEnter() const override { return m_Events.OnMouseEnter; }
+        void SetOnMouseLeave(MouseLeaveCallback&& onMouseLeave) override { m_Events.OnMouseLeave = std::move(onMouseLeave); }
+        [[nodiscard]] const MouseLeaveCallback& GetOnMouseLeave() const override { return m_Events.OnMouseLeave; }
+        void SetOnMouseDown(MouseDownCallback&& onMouseDown) override { m_Events.OnMouseDown = std::move(onMouseDown); }
+        [[nodiscard]] const MouseDownCallback& GetOnMouseDown() const override { return m_Events.OnMouseDown; }
+        void SetOnMouseUp(MouseUpCallback&& onMouseUp) override { m_Events.OnMouseUp = std::move(onMouseUp); }
+        [[nodiscard]] const MouseUpCallback& GetOnMouseUp() const override { return m_Events.OnMouseUp; }
+        void SetOnMouseMove(MouseMoveCallback&& onMouseMove) override { m_Events.OnMouseMove = std::move(onMouseMove); }
+        [[nodiscard]] const MouseMoveCallback& GetOnMouseMove() const override { return m_Events.OnMouseMove; }
+        void SetOnMouseWheel(MouseWheelCallback&& onMouseWheel) override { m_Events.OnMouseWheel = std::move(onMouseWheel); }
+        [[nodiscard]] const MouseWheelCallback& GetOnMouseWheel() const override { return m_Events.OnMouseWheel; }
+        void SetOnRawMouseMove(RawMouseMoveCallback&& onRawMouseMove) override { m_Events.OnRawMouseMove = std::move(onRawMouseMove); }
+        [[nodiscard]] const RawMouseMoveCallback& GetOnRawMouseMove() const override { return m_Events.OnRawMouseMove; }
+        void SetOnTouch(TouchCallback&& onTouch) override { m_Events.OnTouch = std::move(onTouch); }
+        [[nodiscard]] const TouchCallback& GetOnTouch() const override { return m_Events.OnTouch; }
+        void SetOnKeyDown(KeyDownCallback&& onKeyDown) override { m_Events.OnKeyDown = std::move(onKeyDown); }
+        [[nodiscard]] const KeyDownCallback& GetOnKeyDown() const override { return m_Events.OnKeyDown; }
+        void SetOnKeyUp(KeyUpCallback&& onKeyUp) override { m_Events.OnKeyUp = std::move(onKeyUp); }
+        [[nodiscard]] const KeyUpCallback& GetOnKeyUp() const override { return m_Events.OnKeyUp; }
+        void SetOnKeyTyped(KeyTypedCallback&& onKeyTyped) override { m_Events.OnKeyTyped = std::move(onKeyTyped); }
+        [[nodiscard]] const KeyTypedCallback& GetOnKeyTyped() const override { return m_Events.OnKeyTyped; }
+        void SetOnTextInput(TextInputCallback&& onTextInput) override { m_Events.OnTextInput = std::move(onTextInput); }
+        [[nodiscard]] const TextInputCallback& GetOnTextInput() const override { return m_Events.OnTextInput; }
+
+        #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
+        void LimitEvents(bool limitEvents) override { m_LimitEvents = limitEvents; }
+        [[nodiscard]] bool IsLimitingEvents() const override { return m_LimitEvents; }
+        #endif
+
+    private:
+        std::string m_Title;
+        WindowSize m_Size;
+        WindowEvents m_Events;
+        EventTypeFlags m_EventMask = EventTypeFlags::All;
+        void* m_UserData = nullptr;
+        bool m_ShouldClose = false;
+        #ifdef PULSARION_WINDOWING_LIMIT_EVENTS
+        bool m_LimitEvents = false;
+        #endif
+    };
+}
+
+using namespace Pulsarion::Windowing;
+
+using TestWindow = Layered<NullWindow, CoalesceLayer, ProfileLayer<ManualClock>>;
+
+// Hands what the storm dispatches on the driver bus to the backend, as if the platform had delivered it
+template<EventType Type>
+static Subscription Forward(EventBus& driver, TestWindow& window)
+{
+    return driver.Subscribe<Type>([&window](void*, auto... args)
+    {
+        window.GetBackend().template Inject<Type>(args...);
+        return false;
+    });
+}
+
+template<EventType Type>
+static Subscription Count(EventBus& bus, std::uint64_t& received)
+{
+    return bus.Subscribe<Type>([&received](void*, auto...)
+    {
+        received++;
+        return false;
+    });
+}
+
+int main()
+{
+    constexpr int warmupFrames = 1000;
+    constexpr int frames = 10000;
+
+    TestWindow window("Allocation test", WindowBounds(), WindowStyles::None, WindowConfig());
+    EventBus app;
+    app.Attach(window);
+    EventBus driver;
+    ManualClock clock;
+    BasicEventStorm<ManualClock> storm(driver, EventStormConfig(), clock);
+
+    std::uint64_t received = 0;
+    const Subscription subscriptions[] = {
+        Count<EventType::MouseMove>(app, received),
+        Count<EventType::RawMouseMove>(app, received),
+        Count<EventType::MouseWheel>(app, received),
+        Count<EventType::MouseDown>(app, received),
+        Count<EventType::MouseUp>(app, received),
+        Count<EventType::KeyDown>(app, received),
+        Count<EventType::KeyUp>(app, received),
+        Count<EventType::TextInput>(app, received),
+        Count<EventType::Resize>(app, received),
+        Forward<EventType::MouseMove>(driver, window),
+        Forward<EventType::RawMouseMove>(driver, window),
+        Forward<EventType::MouseWheel>(driver, window),
+        Forward<EventType::MouseDown>(driver, window),
+        Forward<EventType::MouseUp>(driver, window),
+        Forward<EventType::KeyDown>(driver, window),
+        Forward<EventType::KeyUp>(driver, window),
+        Forward<EventType::TextInput>(driver, window),
+        Forward<EventType::Resize>(driver, window),
+    };
+
+    const auto frame = [&]
+    {
+        clock.Advance(std::chrono::milliseconds(1));
+        storm.Pump();
+        window.PollEvents();
+    };
+
+    // Lets the storm's queue and everything else on the way reach the size they keep
+    for (int i = 0; i < warmupFrames; i++)
+        frame();
+    storm.ReservePumps(frames);
+
+    const std::size_t allocations = s_Allocations;
+    const std::uint64_t dispatched = storm.GetReport().Dispatched;
+    for (int i = 0; i < frames; i++)
+        frame();
+    const std::size_t steadyAllocations = s_Allocations - allocations;
+    const std::uint64_t steadyDispatched = storm.GetReport().Dispatched - dispatched;
+
+    std::printf("%llu events dispatched over %d frames, %zu allocations\n", static_cast<unsigned long long>(steadyDispatched), frames, steadyAllocations);
+    if (steadyDispatched == 0 || received == 0)
+    {
+        std::fprintf(stderr, "No events reached the listeners\n");
+        return EXIT_FAILURE;
+    }
+    if (steadyAllocations != 0)
+    {
+        std::fprintf(stderr, "The dispatch path allocated %zu times in its steady state\n", steadyAllocations);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}